@@ -37,7 +37,10 @@
 #include <utils/pathchooser.h>
 #include <utils/qtcassert.h>
 
+#include <QCheckBox>
 #include <QFormLayout>
+#include <QSpinBox>
+#include <QStandardItemModel>
 
 using namespace ProjectExplorer;
 
@@ -47,6 +50,13 @@ namespace Internal {
 const char ROS_BC_ID[] = "ROSProjectManager.ROSBuildConfiguration";
 const char ROS_BC_BUILD_SYSTEM[] = "ROSProjectManager.ROSBuildConfiguration.BuildSystem";
 const char ROS_BC_CMAKE_BUILD_TYPE[] = "ROSProjectManager.ROSBuildConfiguration.CMakeBuildType";
+const char ROS_BC_BUILD_GENERATOR[] = "ROSProjectManager.ROSBuildConfiguration.BuildGenerator";
+const char ROS_BC_COMPILER_LAUNCHER[] = "ROSProjectManager.ROSBuildConfiguration.CompilerLauncher";
+const char ROS_BC_COMPILER_CACHE_DIRECTORY[] = "ROSProjectManager.ROSBuildConfiguration.CompilerCacheDirectory";
+const char ROS_BC_COMPILER_CACHE_SIZE[] = "ROSProjectManager.ROSBuildConfiguration.CompilerCacheSize";
+const char ROS_BC_UNITY_BUILD[] = "ROSProjectManager.ROSBuildConfiguration.UnityBuild";
+const char ROS_BC_UNITY_BUILD_BATCH_SIZE[] = "ROSProjectManager.ROSBuildConfiguration.UnityBuildBatchSize";
+const char ROS_BC_PRECOMPILED_HEADERS[] = "ROSProjectManager.ROSBuildConfiguration.PrecompiledHeaders";
 
 ROSBuildConfiguration::ROSBuildConfiguration(Target *parent)
     : BuildConfiguration(parent, Core::Id(ROS_BC_ID))
@@ -61,7 +71,14 @@ ROSBuildConfiguration::ROSBuildConfiguration(Target *parent, Core::Id id)
 ROSBuildConfiguration::ROSBuildConfiguration(Target *parent, ROSBuildConfiguration *source) :
     BuildConfiguration(parent, source),
     m_buildSystem(source->m_buildSystem),
-    m_cmakeBuildType(source->m_cmakeBuildType)
+    m_cmakeBuildType(source->m_cmakeBuildType),
+    m_buildGenerator(source->m_buildGenerator),
+    m_compilerLauncher(source->m_compilerLauncher),
+    m_compilerCacheDirectory(source->m_compilerCacheDirectory),
+    m_compilerCacheSize(source->m_compilerCacheSize),
+    m_unityBuild(source->m_unityBuild),
+    m_unityBuildBatchSize(source->m_unityBuildBatchSize),
+    m_precompiledHeaders(source->m_precompiledHeaders)
 {
     cloneSteps(source);
 }
@@ -72,6 +89,13 @@ QVariantMap ROSBuildConfiguration::toMap() const
 
   map.insert(QLatin1String(ROS_BC_BUILD_SYSTEM), (int)m_buildSystem);
   map.insert(QLatin1String(ROS_BC_CMAKE_BUILD_TYPE), (int)m_cmakeBuildType);
+  map.insert(QLatin1String(ROS_BC_BUILD_GENERATOR), (int)m_buildGenerator);
+  map.insert(QLatin1String(ROS_BC_COMPILER_LAUNCHER), (int)m_compilerLauncher);
+  map.insert(QLatin1String(ROS_BC_COMPILER_CACHE_DIRECTORY), m_compilerCacheDirectory);
+  map.insert(QLatin1String(ROS_BC_COMPILER_CACHE_SIZE), m_compilerCacheSize);
+  map.insert(QLatin1String(ROS_BC_UNITY_BUILD), m_unityBuild);
+  map.insert(QLatin1String(ROS_BC_UNITY_BUILD_BATCH_SIZE), m_unityBuildBatchSize);
+  map.insert(QLatin1String(ROS_BC_PRECOMPILED_HEADERS), m_precompiledHeaders);
   return map;
 }
 
@@ -79,6 +103,18 @@ bool ROSBuildConfiguration::fromMap(const QVariantMap &map)
 {
   m_buildSystem = (ROSUtils::BuildSystem)map.value(QLatin1String(ROS_BC_BUILD_SYSTEM)).toInt();
   m_cmakeBuildType = (ROSUtils::BuildType)map.value(QLatin1String(ROS_BC_CMAKE_BUILD_TYPE)).toInt();
+  m_buildGenerator = (ROSUtils::BuildGenerator)map.value(QLatin1String(ROS_BC_BUILD_GENERATOR), (int)ROSUtils::CodeBlocksMakefiles).toInt();
+
+  // catkin_make --use-ninja always uses the plain Ninja generator
+  if (m_buildGenerator == ROSUtils::CodeBlocksNinja)
+      m_buildGenerator = ROSUtils::Ninja;
+
+  m_compilerLauncher = (ROSUtils::CompilerLauncher)map.value(QLatin1String(ROS_BC_COMPILER_LAUNCHER), (int)ROSUtils::NoCompilerLauncher).toInt();
+  m_compilerCacheDirectory = map.value(QLatin1String(ROS_BC_COMPILER_CACHE_DIRECTORY)).toString();
+  m_compilerCacheSize = map.value(QLatin1String(ROS_BC_COMPILER_CACHE_SIZE)).toString();
+  m_unityBuild = map.value(QLatin1String(ROS_BC_UNITY_BUILD), false).toBool();
+  m_unityBuildBatchSize = map.value(QLatin1String(ROS_BC_UNITY_BUILD_BATCH_SIZE), 8).toInt();
+  m_precompiledHeaders = map.value(QLatin1String(ROS_BC_PRECOMPILED_HEADERS), false).toBool();
   return BuildConfiguration::fromMap(map);
 }
 
@@ -90,6 +126,11 @@ ROSUtils::BuildSystem ROSBuildConfiguration::buildSystem() const
 void ROSBuildConfiguration::setBuildSystem(const ROSUtils::BuildSystem &buildSystem)
 {
     m_buildSystem = buildSystem;
+
+    // Catkin tools always drives the package builds with make
+    if (m_buildSystem == ROSUtils::CatkinTools && ROSUtils::isNinjaGenerator(m_buildGenerator))
+        setBuildGenerator(ROSUtils::CodeBlocksMakefiles);
+
     emit buildSystemChanged(buildSystem);
 }
 
@@ -104,6 +145,105 @@ void ROSBuildConfiguration::setCMakeBuildType(const ROSUtils::BuildType &buildTy
     emit cmakeBuildTypeChanged(buildType);
 }
 
+ROSUtils::BuildGenerator ROSBuildConfiguration::buildGenerator() const
+{
+    return m_buildGenerator;
+}
+
+void ROSBuildConfiguration::setBuildGenerator(const ROSUtils::BuildGenerator &buildGenerator)
+{
+    // catkin_make --use-ninja always uses the plain Ninja generator
+    m_buildGenerator = (buildGenerator == ROSUtils::CodeBlocksNinja) ? ROSUtils::Ninja : buildGenerator;
+    emit buildGeneratorChanged(m_buildGenerator);
+}
+
+ROSUtils::CompilerLauncher ROSBuildConfiguration::compilerLauncher() const
+{
+    return m_compilerLauncher;
+}
+
+void ROSBuildConfiguration::setCompilerLauncher(const ROSUtils::CompilerLauncher &compilerLauncher)
+{
+    m_compilerLauncher = compilerLauncher;
+    emit compilerLauncherChanged(compilerLauncher);
+}
+
+QString ROSBuildConfiguration::compilerCacheDirectory() const
+{
+    return m_compilerCacheDirectory;
+}
+
+void ROSBuildConfiguration::setCompilerCacheDirectory(const QString &directory)
+{
+    m_compilerCacheDirectory = directory;
+}
+
+QString ROSBuildConfiguration::compilerCacheSize() const
+{
+    return m_compilerCacheSize;
+}
+
+void ROSBuildConfiguration::setCompilerCacheSize(const QString &size)
+{
+    m_compilerCacheSize = size;
+}
+
+void ROSBuildConfiguration::addCompilerCacheEnvironment(Utils::Environment &env) const
+{
+    switch (m_compilerLauncher) {
+    case ROSUtils::CCache:
+        if (!m_compilerCacheDirectory.isEmpty())
+            env.set(QLatin1String("CCACHE_DIR"), m_compilerCacheDirectory);
+        if (!m_compilerCacheSize.isEmpty())
+            env.set(QLatin1String("CCACHE_MAXSIZE"), m_compilerCacheSize);
+        break;
+    case ROSUtils::SCCache:
+        if (!m_compilerCacheDirectory.isEmpty())
+            env.set(QLatin1String("SCCACHE_DIR"), m_compilerCacheDirectory);
+        if (!m_compilerCacheSize.isEmpty())
+            env.set(QLatin1String("SCCACHE_CACHE_SIZE"), m_compilerCacheSize);
+        break;
+    default:
+        break;
+    }
+}
+
+bool ROSBuildConfiguration::unityBuild() const
+{
+    return m_unityBuild;
+}
+
+void ROSBuildConfiguration::setUnityBuild(bool unityBuild)
+{
+    m_unityBuild = unityBuild;
+    emit unityBuildChanged();
+}
+
+int ROSBuildConfiguration::unityBuildBatchSize() const
+{
+    return m_unityBuildBatchSize;
+}
+
+void ROSBuildConfiguration::setUnityBuildBatchSize(int batchSize)
+{
+    m_unityBuildBatchSize = batchSize;
+    emit unityBuildChanged();
+}
+
+bool ROSBuildConfiguration::precompiledHeaders() const
+{
+    return m_precompiledHeaders;
+}
+
+void ROSBuildConfiguration::setPrecompiledHeaders(bool precompiledHeaders)
+{
+    m_precompiledHeaders = precompiledHeaders;
+    if (m_precompiledHeaders)
+        project()->updatePrecompiledHeaderCandidates();
+
+    emit precompiledHeadersChanged();
+}
+
 ROSProject *ROSBuildConfiguration::project()
 {
     return qobject_cast<ROSProject *>(target()->project());
@@ -201,6 +341,7 @@ BuildConfiguration *ROSBuildConfigurationFactory::create(Target *parent, const B
     bc->setBuildDirectory(ros_info.buildDirectory);
     bc->setBuildSystem(ros_info.buildSystem);
     bc->setCMakeBuildType(ros_info.cmakeBuildType);
+    bc->setBuildGenerator(ros_info.buildGenerator);
 
     BuildStepList *buildSteps = bc->stepList(ProjectExplorer::Constants::BUILDSTEPS_BUILD);
     BuildStepList *cleanSteps = bc->stepList(ProjectExplorer::Constants::BUILDSTEPS_CLEAN);
@@ -332,6 +473,24 @@ ROSBuildSettingsWidget::ROSBuildSettingsWidget(ROSBuildConfiguration *bc)
     m_ui->setupUi(this);
     m_ui->buildSystemComboBox->setCurrentIndex(bc->buildSystem());
     m_ui->buildTypeComboBox->setCurrentIndex(bc->cmakeBuildType());
+    // catkin_make --use-ninja cannot produce a CodeBlocks project file
+    if (QStandardItemModel *model = qobject_cast<QStandardItemModel *>(m_ui->buildGeneratorComboBox->model()))
+        if (QStandardItem *item = model->item(ROSUtils::CodeBlocksNinja))
+            item->setEnabled(false);
+
+    m_ui->buildGeneratorComboBox->setCurrentIndex(bc->buildGenerator());
+    updateBuildGeneratorEnabled();
+
+    m_ui->compilerLauncherComboBox->setCurrentIndex(bc->compilerLauncher());
+    m_ui->compilerCacheDirectoryPathChooser->setExpectedKind(Utils::PathChooser::Directory);
+    m_ui->compilerCacheDirectoryPathChooser->setPath(bc->compilerCacheDirectory());
+    m_ui->compilerCacheSizeLineEdit->setText(bc->compilerCacheSize());
+    updateCompilerCacheEnabled();
+
+    m_ui->unityBuildCheckBox->setChecked(bc->unityBuild());
+    m_ui->unityBuildBatchSizeSpinBox->setValue(bc->unityBuildBatchSize());
+    m_ui->unityBuildBatchSizeSpinBox->setEnabled(bc->unityBuild());
+    m_ui->precompiledHeadersCheckBox->setChecked(bc->precompiledHeaders());
 
     connect(m_ui->buildSystemComboBox, SIGNAL(currentIndexChanged(int)),
             this, SLOT(buildSystemChanged(int)));
@@ -339,6 +498,27 @@ ROSBuildSettingsWidget::ROSBuildSettingsWidget(ROSBuildConfiguration *bc)
     connect(m_ui->buildTypeComboBox, SIGNAL(currentIndexChanged(int)),
             this, SLOT(buildTypeChanged(int)));
 
+    connect(m_ui->buildGeneratorComboBox, SIGNAL(currentIndexChanged(int)),
+            this, SLOT(buildGeneratorChanged(int)));
+
+    connect(m_ui->compilerLauncherComboBox, SIGNAL(currentIndexChanged(int)),
+            this, SLOT(compilerLauncherChanged(int)));
+
+    connect(m_ui->compilerCacheDirectoryPathChooser, &Utils::PathChooser::pathChanged,
+            this, &ROSBuildSettingsWidget::compilerCacheDirectoryChanged);
+
+    connect(m_ui->compilerCacheSizeLineEdit, &QLineEdit::editingFinished,
+            this, &ROSBuildSettingsWidget::compilerCacheSizeChanged);
+
+    connect(m_ui->unityBuildCheckBox, &QCheckBox::toggled,
+            this, &ROSBuildSettingsWidget::unityBuildChanged);
+
+    connect(m_ui->unityBuildBatchSizeSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+            this, &ROSBuildSettingsWidget::unityBuildBatchSizeChanged);
+
+    connect(m_ui->precompiledHeadersCheckBox, &QCheckBox::toggled,
+            this, &ROSBuildSettingsWidget::precompiledHeadersChanged);
+
     setDisplayName(tr("ROS Manager"));
 }
 
@@ -350,6 +530,8 @@ ROSBuildSettingsWidget::~ROSBuildSettingsWidget()
 void ROSBuildSettingsWidget::buildSystemChanged(int index)
 {
     m_buildConfiguration->setBuildSystem(((ROSUtils::BuildSystem)index));
+    m_ui->buildGeneratorComboBox->setCurrentIndex(m_buildConfiguration->buildGenerator());
+    updateBuildGeneratorEnabled();
 }
 
 void ROSBuildSettingsWidget::buildTypeChanged(int index)
@@ -357,6 +539,56 @@ void ROSBuildSettingsWidget::buildTypeChanged(int index)
     m_buildConfiguration->setCMakeBuildType(((ROSUtils::BuildType)index));
 }
 
+void ROSBuildSettingsWidget::buildGeneratorChanged(int index)
+{
+    m_buildConfiguration->setBuildGenerator(((ROSUtils::BuildGenerator)index));
+}
+
+void ROSBuildSettingsWidget::compilerLauncherChanged(int index)
+{
+    m_buildConfiguration->setCompilerLauncher(((ROSUtils::CompilerLauncher)index));
+    updateCompilerCacheEnabled();
+}
+
+void ROSBuildSettingsWidget::compilerCacheDirectoryChanged()
+{
+    m_buildConfiguration->setCompilerCacheDirectory(m_ui->compilerCacheDirectoryPathChooser->path());
+}
+
+void ROSBuildSettingsWidget::compilerCacheSizeChanged()
+{
+    m_buildConfiguration->setCompilerCacheSize(m_ui->compilerCacheSizeLineEdit->text().trimmed());
+}
+
+void ROSBuildSettingsWidget::unityBuildChanged(bool checked)
+{
+    m_buildConfiguration->setUnityBuild(checked);
+    m_ui->unityBuildBatchSizeSpinBox->setEnabled(checked);
+}
+
+void ROSBuildSettingsWidget::unityBuildBatchSizeChanged(int batchSize)
+{
+    m_buildConfiguration->setUnityBuildBatchSize(batchSize);
+}
+
+void ROSBuildSettingsWidget::precompiledHeadersChanged(bool checked)
+{
+    m_buildConfiguration->setPrecompiledHeaders(checked);
+}
+
+void ROSBuildSettingsWidget::updateCompilerCacheEnabled()
+{
+    bool enabled = (m_buildConfiguration->compilerLauncher() != ROSUtils::NoCompilerLauncher);
+    m_ui->compilerCacheDirectoryPathChooser->setEnabled(enabled);
+    m_ui->compilerCacheSizeLineEdit->setEnabled(enabled);
+}
+
+void ROSBuildSettingsWidget::updateBuildGeneratorEnabled()
+{
+    // Catkin tools runs make for each package, so only the Makefile generator is supported
+    m_ui->buildGeneratorComboBox->setEnabled(m_buildConfiguration->buildSystem() == ROSUtils::CatkinMake);
+}
+
 ////////////////////////////////////////////////////////////////////////////////////
 // ROSBuildEnvironmentWidget
 ////////////////////////////////////////////////////////////////////////////////////
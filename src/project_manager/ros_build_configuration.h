@@ -71,6 +71,38 @@ public:
     ROSUtils::BuildType cmakeBuildType() const;
     void setCMakeBuildType(const ROSUtils::BuildType &buildType);
 
+    ROSUtils::BuildGenerator buildGenerator() const;
+    void setBuildGenerator(const ROSUtils::BuildGenerator &buildGenerator);
+
+    ROSUtils::CompilerLauncher compilerLauncher() const;
+    void setCompilerLauncher(const ROSUtils::CompilerLauncher &compilerLauncher);
+
+    /** @brief Compiler cache directory, empty to use the cache's default */
+    QString compilerCacheDirectory() const;
+    void setCompilerCacheDirectory(const QString &directory);
+
+    /** @brief Compiler cache maximum size (ex. 5G), empty to use the cache's default */
+    QString compilerCacheSize() const;
+    void setCompilerCacheSize(const QString &size);
+
+    /**
+     * @brief Add the compiler cache settings to the build environment
+     * @param env Build environment
+     */
+    void addCompilerCacheEnvironment(Utils::Environment &env) const;
+
+    /** @brief Combine the sources of each target into unity sources (CMAKE_UNITY_BUILD) */
+    bool unityBuild() const;
+    void setUnityBuild(bool unityBuild);
+
+    /** @brief Number of sources combined into one unity source, 0 combines all sources of a target */
+    int unityBuildBatchSize() const;
+    void setUnityBuildBatchSize(int batchSize);
+
+    /** @brief Precompile the most frequently included headers of each target */
+    bool precompiledHeaders() const;
+    void setPrecompiledHeaders(bool precompiledHeaders);
+
     void updateQtEnvironment(const Utils::Environment &env);
 
     ROSProject *project();
@@ -78,6 +110,10 @@ public:
 signals:
     void buildSystemChanged(const ROSUtils::BuildSystem &buildSystem);
     void cmakeBuildTypeChanged(const ROSUtils::BuildType &buildType);
+    void buildGeneratorChanged(const ROSUtils::BuildGenerator &buildGenerator);
+    void compilerLauncherChanged(const ROSUtils::CompilerLauncher &compilerLauncher);
+    void unityBuildChanged();
+    void precompiledHeadersChanged();
 
 protected:
     ROSBuildConfiguration(ProjectExplorer::Target *parent, ROSBuildConfiguration *source);
@@ -90,6 +126,13 @@ protected:
 private:
     ROSUtils::BuildSystem m_buildSystem;
     ROSUtils::BuildType m_cmakeBuildType;
+    ROSUtils::BuildGenerator m_buildGenerator = ROSUtils::CodeBlocksMakefiles;
+    ROSUtils::CompilerLauncher m_compilerLauncher = ROSUtils::NoCompilerLauncher;
+    QString m_compilerCacheDirectory;
+    QString m_compilerCacheSize;
+    bool m_unityBuild = false;
+    int m_unityBuildBatchSize = 8;
+    bool m_precompiledHeaders = false;
     ProjectExplorer::NamedWidget *m_buildEnvironmentWidget;
 
 };
@@ -131,8 +174,18 @@ public:
 private slots:
     void buildSystemChanged(int index);
     void buildTypeChanged(int index);
+    void buildGeneratorChanged(int index);
+    void compilerLauncherChanged(int index);
+    void compilerCacheDirectoryChanged();
+    void compilerCacheSizeChanged();
+    void unityBuildChanged(bool checked);
+    void unityBuildBatchSizeChanged(int batchSize);
+    void precompiledHeadersChanged(bool checked);
 
 private:
+    void updateBuildGeneratorEnabled();
+    void updateCompilerCacheEnabled();
+
     Ui::ROSBuildConfiguration *m_ui;
     ROSBuildConfiguration *m_buildConfiguration;
 };
@@ -170,11 +223,13 @@ public:
         environment = bc->environment();
         buildSystem = bc->buildSystem();
         cmakeBuildType = bc->cmakeBuildType();
+        buildGenerator = bc->buildGenerator();
     }
 
     Utils::Environment environment;
     ROSUtils::BuildSystem buildSystem;
     ROSUtils::BuildType cmakeBuildType;
+    ROSUtils::BuildGenerator buildGenerator = ROSUtils::CodeBlocksMakefiles;
 };
 
 } // namespace Internal
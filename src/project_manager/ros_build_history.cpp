@@ -0,0 +1,269 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_build_history.h"
+
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+const char ROS_BUILD_HISTORY_FILE[] = "ros_qtc_build_durations.log";
+
+const int ROSBuildHistory::SampleCount;
+constexpr double ROSBuildHistory::RegressionThreshold;
+const qint64 ROSBuildHistory::RegressionMinimum;
+
+bool ROSBuildHistory::load(const Utils::FileName &buildPath)
+{
+    m_buildPath = buildPath;
+    m_durations.clear();
+    m_lineCount = 0;
+
+    QFile file(historyFile(buildPath).toString());
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    while (!file.atEnd())
+    {
+        const QList<QByteArray> fields = file.readLine().trimmed().split(' ');
+        if (fields.size() < 2)
+            continue;
+
+        bool ok = false;
+        qint64 duration = fields.at(1).toLongLong(&ok);
+        if (!ok || duration < 0)
+            continue;
+
+        QList<qint64> &durations = m_durations[QString::fromUtf8(fields.at(0))];
+        durations.append(duration);
+        if (durations.size() > SampleCount)
+            durations.removeFirst();
+
+        ++m_lineCount;
+    }
+    file.close();
+
+    // Drop the samples which are no longer used
+    if (m_lineCount > 2 * SampleCount * qMax(1, m_durations.size()))
+        compact();
+
+    return true;
+}
+
+bool ROSBuildHistory::append(const ROSBuildProfiler::Profile &profile)
+{
+    if (m_buildPath.isEmpty() || profile.packages.isEmpty())
+        return false;
+
+    if (!QDir().mkpath(m_buildPath.toString()))
+        return false;
+
+    QFile file(historyFile(m_buildPath).toString());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text))
+    {
+        qDebug() << "Failed to append to build history: " << file.fileName();
+        return false;
+    }
+
+    const qint64 timestamp = profile.started.toMSecsSinceEpoch() / 1000;
+    QTextStream stream(&file);
+    foreach (const ROSBuildProfiler::Entry &e, profile.packages)
+    {
+        if (!e.success || e.start < 0 || e.finish < 0)
+            continue;
+
+        stream << e.name << ' ' << e.duration() << ' ' << timestamp << '\n';
+
+        QList<qint64> &durations = m_durations[e.name];
+        durations.append(e.duration());
+        if (durations.size() > SampleCount)
+            durations.removeFirst();
+
+        ++m_lineCount;
+    }
+
+    return true;
+}
+
+int ROSBuildHistory::sampleCount(const QString &package) const
+{
+    return m_durations.value(package).size();
+}
+
+qint64 ROSBuildHistory::medianDuration(const QString &package) const
+{
+    QList<qint64> durations = m_durations.value(package);
+    if (durations.isEmpty())
+        return -1;
+
+    std::sort(durations.begin(), durations.end());
+    int middle = durations.size() / 2;
+    if (durations.size() % 2 == 0)
+        return (durations.at(middle - 1) + durations.at(middle)) / 2;
+
+    return durations.at(middle);
+}
+
+QHash<QString, double> ROSBuildHistory::weights() const
+{
+    QHash<QString, double> weights;
+    for (auto it = m_durations.constBegin(); it != m_durations.constEnd(); ++it)
+        weights.insert(it.key(), double(qMax(Q_INT64_C(1), medianDuration(it.key()))));
+
+    return weights;
+}
+
+bool ROSBuildHistory::isRegression(const QString &package, qint64 duration, qint64 *median) const
+{
+    // A few samples are needed before the median is meaningful
+    if (sampleCount(package) < 3)
+        return false;
+
+    qint64 packageMedian = medianDuration(package);
+    if (median)
+        *median = packageMedian;
+
+    return (duration - packageMedian) >= RegressionMinimum && duration > packageMedian * (1.0 + RegressionThreshold);
+}
+
+QString ROSBuildHistory::regressionMessage(const ROSBuildProfiler::Entry &entry) const
+{
+    qint64 median = -1;
+    if (!entry.success || entry.finish < 0 || !isRegression(entry.name, entry.duration(), &median))
+        return QString();
+
+    return QCoreApplication::translate("ROSProjectManager::Internal::ROSBuildHistory",
+                                       "Package %1 took %2 to build, its median over the last builds is %3.")
+            .arg(entry.name, formatDuration(entry.duration()), formatDuration(median));
+}
+
+int ROSBuildHistory::estimateProgress(const QStringList &packages, const ROSBuildProfiler::Profile &profile,
+                                      qint64 elapsed, qint64 *remaining) const
+{
+    if (remaining)
+        *remaining = -1;
+
+    if (packages.isEmpty())
+        return 0;
+
+    // Packages without a history are assumed to cost the median of the known packages
+    QList<qint64> medians;
+    foreach (const QString &package, packages)
+    {
+        qint64 median = medianDuration(package);
+        if (median >= 0)
+            medians.append(median);
+    }
+    std::sort(medians.begin(), medians.end());
+    const qint64 defaultCost = medians.isEmpty() ? 1000 : qMax(Q_INT64_C(1), medians.at(medians.size() / 2));
+
+    QHash<QString, const ROSBuildProfiler::Entry *> entries;
+    foreach (const ROSBuildProfiler::Entry &e, profile.packages)
+        entries.insert(e.name, &e);
+
+    double total = 0.0;
+    double done = 0.0;
+    foreach (const QString &package, packages)
+    {
+        qint64 median = medianDuration(package);
+        double cost = (median >= 0) ? qMax(Q_INT64_C(1), median) : defaultCost;
+        total += cost;
+
+        const ROSBuildProfiler::Entry *e = entries.value(package);
+        if (!e || e->start < 0)
+            continue;
+
+        // Running packages count up to almost their expected cost
+        if (e->finish >= 0)
+            done += cost;
+        else
+            done += qMin(double(elapsed - e->start), cost * 0.95);
+    }
+
+    if (total <= 0.0)
+        return 0;
+
+    // The rate at which historical cost is completed accounts for the parallelism of the build
+    if (remaining && done > 0.0)
+        *remaining = qint64((total - done) * (elapsed / done));
+
+    return qBound(0, int((100.0 * done) / total), 100);
+}
+
+double ROSBuildHistory::runningProgress(const ROSBuildProfiler::Profile &profile, qint64 elapsed) const
+{
+    double progress = 0.0;
+    foreach (const ROSBuildProfiler::Entry &e, profile.packages)
+    {
+        if (e.start < 0 || e.finish >= 0)
+            continue;
+
+        // Packages without a history are not interpolated, running packages count up to almost done
+        qint64 median = medianDuration(e.name);
+        if (median > 0)
+            progress += qBound(0.0, double(elapsed - e.start) / median, 0.95);
+    }
+
+    return progress;
+}
+
+QString ROSBuildHistory::formatDuration(qint64 msecs)
+{
+    qint64 seconds = qMax(Q_INT64_C(0), msecs) / 1000;
+    if (seconds >= 3600)
+        return QString::fromLatin1("%1:%2:%3").arg(seconds / 3600).arg((seconds % 3600) / 60, 2, 10, QLatin1Char('0')).arg(seconds % 60, 2, 10, QLatin1Char('0'));
+
+    return QString::fromLatin1("%1:%2").arg(seconds / 60).arg(seconds % 60, 2, 10, QLatin1Char('0'));
+}
+
+bool ROSBuildHistory::compact() const
+{
+    QFile file(historyFile(m_buildPath).toString());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qDebug() << "Failed to compact build history: " << file.fileName();
+        return false;
+    }
+
+    // The original timestamps are not kept, the samples are ordered which is all that is used
+    const qint64 timestamp = QDateTime::currentMSecsSinceEpoch() / 1000;
+    QTextStream stream(&file);
+    for (auto it = m_durations.constBegin(); it != m_durations.constEnd(); ++it)
+        foreach (qint64 duration, it.value())
+            stream << it.key() << ' ' << duration << ' ' << timestamp << '\n';
+
+    return true;
+}
+
+Utils::FileName ROSBuildHistory::historyFile(const Utils::FileName &buildPath)
+{
+    return Utils::FileName(buildPath).appendPath(QLatin1String(ROS_BUILD_HISTORY_FILE));
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
@@ -0,0 +1,130 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_BUILD_HISTORY_H
+#define ROS_BUILD_HISTORY_H
+
+#include "ros_build_profiler.h"
+
+#include <utils/fileutils.h>
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Historical package build durations of a workspace
+ *
+ * Each successful package build appends a "<package> <duration ms> <epoch seconds>" line to a
+ * file in the workspace build directory. Only the most recent samples of each package are used
+ * and the file is compacted once it holds far more lines than that.
+ */
+class ROSBuildHistory
+{
+public:
+    ROSBuildHistory() {}
+
+    /**
+     * @brief Load the build durations of a workspace
+     * @param buildPath Workspace build directory
+     * @return True if a history was loaded, otherwise false.
+     */
+    bool load(const Utils::FileName &buildPath);
+
+    /**
+     * @brief Append the successfully built packages of a profile to the history
+     * @param profile Build profile, only per-package profiles are recorded
+     * @return True if successful, otherwise false.
+     */
+    bool append(const ROSBuildProfiler::Profile &profile);
+
+    /** @brief Number of recorded samples of a package */
+    int sampleCount(const QString &package) const;
+
+    /** @brief Median of the recent build durations of a package in milliseconds, -1 if unknown */
+    qint64 medianDuration(const QString &package) const;
+
+    /** @brief Median package durations usable as build scheduler weights */
+    QHash<QString, double> weights() const;
+
+    /**
+     * @brief Check if a package build took considerably longer than its rolling median
+     * @param package Package name
+     * @param duration Build duration in milliseconds
+     * @param median Set to the rolling median of the package
+     * @return True if the build time regressed, otherwise false.
+     */
+    bool isRegression(const QString &package, qint64 duration, qint64 *median = nullptr) const;
+
+    /**
+     * @brief Get a warning message if a package build time regressed
+     * @param entry Package entry of the running build
+     * @return Warning message, empty if the build time did not regress
+     */
+    QString regressionMessage(const ROSBuildProfiler::Entry &entry) const;
+
+    /**
+     * @brief Estimate the progress of a build using the historical cost of each package
+     * @param packages Packages being built
+     * @param profile Profile of the running build
+     * @param elapsed Milliseconds since the build started
+     * @param remaining Set to the estimated remaining milliseconds, -1 if unknown
+     * @return Progress in percent
+     */
+    int estimateProgress(const QStringList &packages, const ROSBuildProfiler::Profile &profile,
+                         qint64 elapsed, qint64 *remaining) const;
+
+    /**
+     * @brief Estimate how much of the running packages is done using their historical cost
+     * @param profile Profile of the running build
+     * @param elapsed Milliseconds since the build started
+     * @return Sum of the completed fraction of each started package which did not finish yet
+     */
+    double runningProgress(const ROSBuildProfiler::Profile &profile, qint64 elapsed) const;
+
+    /** @brief Format a duration as m:ss or h:mm:ss */
+    static QString formatDuration(qint64 msecs);
+
+    /** @brief Samples kept per package */
+    static const int SampleCount = 10;
+
+    /** @brief Relative increase over the median which is reported as a regression */
+    static constexpr double RegressionThreshold = 0.5;
+
+    /** @brief Minimum increase in milliseconds which is reported, avoids warnings for tiny packages */
+    static const qint64 RegressionMinimum = 10000;
+
+private:
+    bool compact() const;
+    static Utils::FileName historyFile(const Utils::FileName &buildPath);
+
+    Utils::FileName m_buildPath;
+    QHash<QString, QList<qint64>> m_durations; /**< @brief Package name to recent durations, oldest first */
+    int m_lineCount = 0;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_BUILD_HISTORY_H
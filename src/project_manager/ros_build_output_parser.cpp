@@ -0,0 +1,206 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_build_output_parser.h"
+
+#include <QDir>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+ROSBuildOutputParser::ROSBuildOutputParser(QObject *parent) :
+    QObject(parent)
+{
+    qRegisterMetaType<ProjectExplorer::Task>("ProjectExplorer::Task");
+    qRegisterMetaType<ProjectExplorer::IOutputParser *>("ProjectExplorer::IOutputParser*");
+
+    m_worker = new ROSBuildOutputParserWorker;
+    m_worker->moveToThread(&m_thread);
+    connect(&m_thread, &QThread::finished, m_worker, &QObject::deleteLater);
+
+    // Queued after the tasks found while flushing, so they are delivered first
+    connect(m_worker, &ROSBuildOutputParserWorker::drained, this, &ROSBuildOutputParser::flushed, Qt::QueuedConnection);
+    m_thread.setObjectName(QLatin1String("ROSBuildOutputParser"));
+}
+
+ROSBuildOutputParser::~ROSBuildOutputParser()
+{
+    if (!m_thread.isRunning())
+    {
+        delete m_worker;
+        return;
+    }
+
+    m_thread.quit();
+    m_thread.wait();
+}
+
+void ROSBuildOutputParser::setParser(ProjectExplorer::IOutputParser *parser, const QString &workingDirectory)
+{
+    // The thread is started with the first build so idle build steps do not own a thread
+    if (!m_thread.isRunning())
+        m_thread.start();
+
+    m_workingDirectory = workingDirectory;
+
+    // The whole chain has to live on the worker thread so its internal connections are direct
+    for (ProjectExplorer::IOutputParser *p = parser; p; p = p->childParser())
+        p->moveToThread(&m_thread);
+
+    if (parser)
+    {
+        connect(parser, &ProjectExplorer::IOutputParser::addTask,
+                this, &ROSBuildOutputParser::taskAdded);
+    }
+
+    // The worker may still be parsing, so the chain is replaced on its thread once the output
+    // queued before was parsed with the previous chain
+    QMetaObject::invokeMethod(m_worker, "setParser", Qt::QueuedConnection,
+                              Q_ARG(ProjectExplorer::IOutputParser*, parser));
+}
+
+void ROSBuildOutputParser::stdOutput(const QString &line)
+{
+    if (m_thread.isRunning() && mayMatch(line))
+        enqueue(line, false);
+}
+
+void ROSBuildOutputParser::stdError(const QString &line)
+{
+    if (m_thread.isRunning() && mayMatch(line))
+        enqueue(line, true);
+}
+
+void ROSBuildOutputParser::flush()
+{
+    if (!m_thread.isRunning())
+    {
+        emit flushed();
+        return;
+    }
+
+    QMetaObject::invokeMethod(m_worker, "flush", Qt::QueuedConnection);
+}
+
+bool ROSBuildOutputParser::mayMatch(const QString &line)
+{
+    // Compiler, linker, make and CMake messages all contain "file:line" or "tool:" prefixes,
+    // continuation lines are indented and CMake messages are terminated by an empty line.
+    const int size = line.size();
+    if (size == 0)
+        return true;
+
+    const QChar *data = line.constData();
+    if (data[0].isSpace())
+        return true;
+
+    for (int i = 0; i < size; ++i)
+        if (data[i] == QLatin1Char(':'))
+            return true;
+
+    return false;
+}
+
+void ROSBuildOutputParser::enqueue(const QString &line, bool isError)
+{
+    // Only the first line of a batch schedules the worker, the rest are picked up with it
+    if (m_worker->enqueue(line, isError))
+        QMetaObject::invokeMethod(m_worker, "processPending", Qt::QueuedConnection);
+}
+
+void ROSBuildOutputParser::taskAdded(const ProjectExplorer::Task &task)
+{
+    // The output has moved on by the time the task arrives, so it is not linked to output lines
+    ProjectExplorer::Task resolved = task;
+    if (!resolved.file.isEmpty() && !resolved.file.toFileInfo().isAbsolute() && !m_workingDirectory.isEmpty())
+    {
+        QFileInfo candidate(QDir(m_workingDirectory).absoluteFilePath(resolved.file.toString()));
+        if (candidate.exists())
+            resolved.file = Utils::FileName::fromString(candidate.absoluteFilePath());
+    }
+
+    emit addTask(resolved);
+}
+
+ROSBuildOutputParserWorker::ROSBuildOutputParserWorker()
+{
+}
+
+ROSBuildOutputParserWorker::~ROSBuildOutputParserWorker()
+{
+    delete m_parser;
+}
+
+bool ROSBuildOutputParserWorker::enqueue(const QString &line, bool isError)
+{
+    QMutexLocker locker(&m_mutex);
+    m_pending.append(qMakePair(line, isError));
+    if (m_scheduled)
+        return false;
+
+    m_scheduled = true;
+    return true;
+}
+
+void ROSBuildOutputParserWorker::setParser(ProjectExplorer::IOutputParser *parser)
+{
+    flushParser();
+    delete m_parser;
+    m_parser = parser;
+}
+
+void ROSBuildOutputParserWorker::processPending()
+{
+    QVector<QPair<QString, bool> > lines;
+    {
+        QMutexLocker locker(&m_mutex);
+        lines.swap(m_pending);
+        m_scheduled = false;
+    }
+
+    if (!m_parser)
+        return;
+
+    for (const QPair<QString, bool> &line : lines)
+    {
+        if (line.second)
+            m_parser->stdError(line.first);
+        else
+            m_parser->stdOutput(line.first);
+    }
+}
+
+void ROSBuildOutputParserWorker::flush()
+{
+    flushParser();
+    emit drained();
+}
+
+void ROSBuildOutputParserWorker::flushParser()
+{
+    processPending();
+    if (m_parser)
+        m_parser->flush();
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
@@ -0,0 +1,118 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_BUILD_OUTPUT_PARSER_H
+#define ROS_BUILD_OUTPUT_PARSER_H
+
+#include <projectexplorer/ioutputparser.h>
+#include <projectexplorer/task.h>
+
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QThread>
+#include <QVector>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+class ROSBuildOutputParserWorker;
+
+/**
+ * @brief Runs a build step's output parser chain on a worker thread
+ *
+ * Lines are queued by the GUI thread and parsed in batches by the worker, tasks are delivered
+ * back to the GUI thread. Lines which can not start or continue a compiler, make or CMake message
+ * are dropped before they are queued.
+ */
+class ROSBuildOutputParser : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ROSBuildOutputParser(QObject *parent = nullptr);
+    ~ROSBuildOutputParser();
+
+    /**
+     * @brief Set the parser chain, pending output of the previous chain is parsed first
+     * @param parser Parser chain, ownership is taken
+     * @param workingDirectory Directory relative task file paths are resolved against
+     */
+    void setParser(ProjectExplorer::IOutputParser *parser, const QString &workingDirectory);
+
+    void stdOutput(const QString &line);
+    void stdError(const QString &line);
+
+    /** @brief Parse all pending output and flush the parser chain, flushed() is emitted once done */
+    void flush();
+
+    /** @brief Fast check if a line could be part of a parsed message */
+    static bool mayMatch(const QString &line);
+
+signals:
+    void addTask(const ProjectExplorer::Task &task);
+
+    /** @brief The output queued before flush() was parsed and its tasks were delivered */
+    void flushed();
+
+private:
+    void enqueue(const QString &line, bool isError);
+    void taskAdded(const ProjectExplorer::Task &task);
+
+    QThread m_thread;
+    ROSBuildOutputParserWorker *m_worker = nullptr;
+    QString m_workingDirectory;
+};
+
+/** @brief Owns the parser chain and lives on the worker thread */
+class ROSBuildOutputParserWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    ROSBuildOutputParserWorker();
+    ~ROSBuildOutputParserWorker();
+
+    /** @brief Queue a line, returns true if a batch needs to be scheduled (thread safe) */
+    bool enqueue(const QString &line, bool isError);
+
+public slots:
+    /** @brief Replace the parser chain, must be invoked on the worker thread */
+    void setParser(ProjectExplorer::IOutputParser *parser);
+    void processPending();
+    void flush();
+
+signals:
+    /** @brief All output queued before flush() was parsed */
+    void drained();
+
+private:
+    void flushParser();
+
+    QMutex m_mutex;
+    QVector<QPair<QString, bool> > m_pending; /**< @brief Line and whether it was written to stderr */
+    bool m_scheduled = false;
+    ProjectExplorer::IOutputParser *m_parser = nullptr;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_BUILD_OUTPUT_PARSER_H
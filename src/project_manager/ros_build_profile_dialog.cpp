@@ -0,0 +1,314 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_build_profile_dialog.h"
+#include "ros_package_build_scheduler.h"
+#include "ui_ros_build_profile_dialog.h"
+
+#include <QHelpEvent>
+#include <QPainter>
+#include <QTableWidgetItem>
+#include <QToolTip>
+
+#include <algorithm>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+const int ROS_TIMELINE_ROW_HEIGHT = 18;
+const int ROS_TIMELINE_AXIS_HEIGHT = 20;
+const int ROS_SLOWEST_PACKAGE_COUNT = 20;
+
+//
+// ROSBuildTimelineWidget
+//
+
+ROSBuildTimelineWidget::ROSBuildTimelineWidget(QWidget *parent) :
+    QWidget(parent)
+{
+    setBackgroundRole(QPalette::Base);
+    setAutoFillBackground(true);
+}
+
+void ROSBuildTimelineWidget::setTimeline(const ROSBuildProfiler::EntryList &entries, qint64 duration, const QSet<QString> &criticalPath)
+{
+    m_entries = entries;
+    m_duration = duration;
+    m_criticalPath = criticalPath;
+
+    setMinimumHeight(ROS_TIMELINE_AXIS_HEIGHT + m_entries.size() * ROS_TIMELINE_ROW_HEIGHT + 1);
+    update();
+}
+
+int ROSBuildTimelineWidget::labelWidth() const
+{
+    int width = 0;
+    foreach (const ROSBuildProfiler::Entry &e, m_entries)
+        width = qMax(width, fontMetrics().width(e.name));
+
+    return qMin(width + 10, this->width() / 3);
+}
+
+int ROSBuildTimelineWidget::rowAt(int y) const
+{
+    if (y < ROS_TIMELINE_AXIS_HEIGHT)
+        return -1;
+
+    int row = (y - ROS_TIMELINE_AXIS_HEIGHT) / ROS_TIMELINE_ROW_HEIGHT;
+    return (row < m_entries.size()) ? row : -1;
+}
+
+void ROSBuildTimelineWidget::paintEvent(QPaintEvent *event)
+{
+    Q_UNUSED(event);
+    QPainter painter(this);
+
+    const int left = labelWidth();
+    const int chartWidth = qMax(1, width() - left - 10);
+    const double scale = (m_duration > 0) ? double(chartWidth) / m_duration : 0.0;
+
+    // Time axis, one tick per tenth of the build
+    painter.setPen(palette().color(QPalette::Mid));
+    for (int i = 0; i <= 10; ++i)
+    {
+        int x = left + (chartWidth * i) / 10;
+        painter.drawLine(x, ROS_TIMELINE_AXIS_HEIGHT - 4, x, height());
+        painter.setPen(palette().color(QPalette::Text));
+        painter.drawText(x + 2, ROS_TIMELINE_AXIS_HEIGHT - 6, QString::number((m_duration * i) / 10000.0, 'f', 1) + QLatin1Char('s'));
+        painter.setPen(palette().color(QPalette::Mid));
+    }
+
+    for (int row = 0; row < m_entries.size(); ++row)
+    {
+        const ROSBuildProfiler::Entry &e = m_entries.at(row);
+        const int y = ROS_TIMELINE_AXIS_HEIGHT + row * ROS_TIMELINE_ROW_HEIGHT;
+
+        painter.setPen(palette().color(QPalette::Text));
+        painter.drawText(QRect(0, y, left - 5, ROS_TIMELINE_ROW_HEIGHT), Qt::AlignRight | Qt::AlignVCenter,
+                         fontMetrics().elidedText(e.name, Qt::ElideRight, left - 5));
+
+        QColor color;
+        if (!e.success)
+            color = QColor(220, 80, 80);
+        else if (m_criticalPath.contains(e.name))
+            color = QColor(230, 150, 40);
+        else
+            color = QColor(90, 160, 90);
+
+        QRect bar(left + int(e.start * scale), y + 3, qMax(2, int(e.duration() * scale)), ROS_TIMELINE_ROW_HEIGHT - 6);
+        painter.fillRect(bar, color);
+    }
+}
+
+bool ROSBuildTimelineWidget::event(QEvent *event)
+{
+    if (event->type() == QEvent::ToolTip)
+    {
+        QHelpEvent *helpEvent = static_cast<QHelpEvent *>(event);
+        int row = rowAt(helpEvent->pos().y());
+        if (row == -1)
+        {
+            QToolTip::hideText();
+            event->ignore();
+            return true;
+        }
+
+        const ROSBuildProfiler::Entry &e = m_entries.at(row);
+        QToolTip::showText(helpEvent->globalPos(),
+                           tr("%1\nStarted: %2 s\nDuration: %3 s%4")
+                           .arg(e.name)
+                           .arg(e.start / 1000.0, 0, 'f', 1)
+                           .arg(e.duration() / 1000.0, 0, 'f', 1)
+                           .arg(m_criticalPath.contains(e.name) ? tr("\nOn the critical path") : QString()));
+        return true;
+    }
+
+    return QWidget::event(event);
+}
+
+//
+// ROSBuildProfileDialog
+//
+
+ROSBuildProfileDialog::ROSBuildProfileDialog(const ROSBuildProfiler::ProfileList &profiles,
+                                             const ROSPackageGraph &graph,
+                                             QWidget *parent) :
+    QDialog(parent),
+    m_ui(new Ui::ROSBuildProfileDialog),
+    m_profiles(profiles),
+    m_graph(graph)
+{
+    m_ui->setupUi(this);
+
+    m_timeline = new ROSBuildTimelineWidget(this);
+    m_ui->timelineScrollArea->setWidget(m_timeline);
+
+    m_ui->slowestTableWidget->setColumnCount(6);
+    m_ui->slowestTableWidget->setHorizontalHeaderLabels({tr("Package"), tr("Duration (s)"), tr("Started (s)"), tr("Share (%)"), tr("Critical Path"), tr("PCH Saving (%)")});
+
+    foreach (const ROSBuildProfiler::Profile &profile, m_profiles)
+    {
+        m_ui->buildComboBox->addItem(tr("%1 - %2 (%3 s, %4)")
+                                     .arg(profile.started.toString(Qt::SystemLocaleShortDate))
+                                     .arg(profile.buildSystem)
+                                     .arg(profile.duration / 1000.0, 0, 'f', 1)
+                                     .arg(profile.success ? tr("succeeded") : tr("failed")));
+    }
+
+    connect(m_ui->buttonBox, &QDialogButtonBox::rejected, this, &QDialog::reject);
+
+    connect(m_ui->buildComboBox, static_cast<void (QComboBox::*)(int)>(&QComboBox::currentIndexChanged),
+            this, &ROSBuildProfileDialog::showProfile);
+
+    showProfile(m_ui->buildComboBox->currentIndex());
+}
+
+ROSBuildProfileDialog::~ROSBuildProfileDialog()
+{
+    delete m_ui;
+}
+
+QSet<QString> ROSBuildProfileDialog::criticalPath(const ROSBuildProfiler::EntryList &entries, const ROSPackageGraph &graph)
+{
+    QStringList packages;
+    QHash<QString, double> weights;
+    foreach (const ROSBuildProfiler::Entry &e, entries)
+    {
+        packages.append(e.name);
+        weights.insert(e.name, double(e.duration()));
+    }
+
+    QHash<QString, double> priorities = ROSPackageBuildScheduler::criticalPathPriorities(graph, packages, weights);
+
+    // The package with the longest remaining path starts the critical path,
+    // which then continues through the dependent with the longest remaining path.
+    QString current;
+    double longest = -1.0;
+    for (auto it = priorities.constBegin(); it != priorities.constEnd(); ++it)
+    {
+        if (it.value() > longest)
+        {
+            longest = it.value();
+            current = it.key();
+        }
+    }
+
+    QSet<QString> path;
+    while (!current.isEmpty() && !path.contains(current))
+    {
+        path.insert(current);
+
+        QString next;
+        longest = -1.0;
+        foreach (const QString &dependent, graph.dependents(current))
+        {
+            if (priorities.contains(dependent) && priorities.value(dependent) > longest)
+            {
+                longest = priorities.value(dependent);
+                next = dependent;
+            }
+        }
+        current = next;
+    }
+
+    return path;
+}
+
+void ROSBuildProfileDialog::showProfile(int index)
+{
+    m_ui->slowestTableWidget->setRowCount(0);
+    if (index < 0 || index >= m_profiles.size())
+    {
+        m_timeline->setTimeline(ROSBuildProfiler::EntryList(), 0, QSet<QString>());
+        return;
+    }
+
+    const ROSBuildProfiler::Profile &profile = m_profiles.at(index);
+    ROSBuildProfiler::EntryList timeline = ROSBuildProfiler::packageTimeline(profile);
+    QSet<QString> critical = criticalPath(timeline, m_graph);
+    m_timeline->setTimeline(timeline, profile.duration, critical);
+
+    qint64 criticalDuration = 0;
+    foreach (const ROSBuildProfiler::Entry &e, timeline)
+    {
+        if (critical.contains(e.name))
+            criticalDuration += e.duration();
+    }
+
+    QString summary = tr("%1 packages, critical path %2 s of %3 s")
+            .arg(timeline.size())
+            .arg(criticalDuration / 1000.0, 0, 'f', 1)
+            .arg(profile.duration / 1000.0, 0, 'f', 1);
+
+    if (profile.unityBuild)
+        summary.append(tr(", unity build"));
+
+    if (profile.precompiledHeaders)
+        summary.append(tr(", precompiled headers"));
+
+    QString comparison = ROSBuildProfiler::unityBuildComparison(m_profiles);
+    if (!comparison.isEmpty())
+        summary.append(QLatin1Char('\n') + comparison);
+
+    m_ui->summaryLabel->setText(summary);
+
+    ROSBuildProfiler::EntryList slowest = timeline;
+    std::sort(slowest.begin(), slowest.end(), [](const ROSBuildProfiler::Entry &a, const ROSBuildProfiler::Entry &b) {
+        return a.duration() > b.duration();
+    });
+
+    if (slowest.size() > ROS_SLOWEST_PACKAGE_COUNT)
+        slowest.erase(slowest.begin() + ROS_SLOWEST_PACKAGE_COUNT, slowest.end());
+
+    // Measured over the most recent full builds with and without precompiled headers
+    QMap<QString, QPair<qint64, qint64> > pchComparison = ROSBuildProfiler::precompiledHeaderComparison(m_profiles);
+
+    m_ui->slowestTableWidget->setSortingEnabled(false);
+    m_ui->slowestTableWidget->setRowCount(slowest.size());
+    for (int row = 0; row < slowest.size(); ++row)
+    {
+        const ROSBuildProfiler::Entry &e = slowest.at(row);
+        double share = (profile.duration > 0) ? (100.0 * e.duration()) / profile.duration : 0.0;
+
+        auto durationItem = new QTableWidgetItem;
+        durationItem->setData(Qt::DisplayRole, qRound(e.duration() / 100.0) / 10.0);
+        auto startItem = new QTableWidgetItem;
+        startItem->setData(Qt::DisplayRole, qRound(e.start / 100.0) / 10.0);
+        auto shareItem = new QTableWidgetItem;
+        shareItem->setData(Qt::DisplayRole, qRound(share * 10.0) / 10.0);
+
+        m_ui->slowestTableWidget->setItem(row, 0, new QTableWidgetItem(e.name));
+        m_ui->slowestTableWidget->setItem(row, 1, durationItem);
+        m_ui->slowestTableWidget->setItem(row, 2, startItem);
+        m_ui->slowestTableWidget->setItem(row, 3, shareItem);
+        m_ui->slowestTableWidget->setItem(row, 4, new QTableWidgetItem(critical.contains(e.name) ? tr("Yes") : QString()));
+
+        auto pchItem = new QTableWidgetItem;
+        auto pch = pchComparison.constFind(e.name);
+        if (pch != pchComparison.constEnd() && pch.value().second > 0)
+            pchItem->setData(Qt::DisplayRole, qRound((1000.0 * (pch.value().second - pch.value().first)) / pch.value().second) / 10.0);
+        m_ui->slowestTableWidget->setItem(row, 5, pchItem);
+    }
+    m_ui->slowestTableWidget->setSortingEnabled(true);
+    m_ui->slowestTableWidget->resizeColumnsToContents();
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
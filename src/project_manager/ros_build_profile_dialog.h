@@ -0,0 +1,101 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_BUILD_PROFILE_DIALOG_H
+#define ROS_BUILD_PROFILE_DIALOG_H
+
+#include "ros_build_profiler.h"
+#include "ros_package_graph.h"
+
+#include <QDialog>
+#include <QSet>
+#include <QWidget>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+namespace Ui { class ROSBuildProfileDialog; }
+
+/**
+ * @brief Gantt style view of the package timeline of a build
+ */
+class ROSBuildTimelineWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ROSBuildTimelineWidget(QWidget *parent = 0);
+
+    /**
+     * @brief Set the timeline to display
+     * @param entries Package entries sorted by start time
+     * @param duration Build duration in milliseconds
+     * @param criticalPath Packages on the critical path, these are highlighted
+     */
+    void setTimeline(const ROSBuildProfiler::EntryList &entries, qint64 duration, const QSet<QString> &criticalPath);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    bool event(QEvent *event) override;
+
+private:
+    int labelWidth() const;
+    int rowAt(int y) const;
+
+    ROSBuildProfiler::EntryList m_entries;
+    QSet<QString> m_criticalPath;
+    qint64 m_duration = 0;
+};
+
+/**
+ * @brief Shows the recorded build profiles as a timeline and a table of the slowest packages
+ */
+class ROSBuildProfileDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit ROSBuildProfileDialog(const ROSBuildProfiler::ProfileList &profiles,
+                                   const ROSPackageGraph &graph,
+                                   QWidget *parent = 0);
+    ~ROSBuildProfileDialog();
+
+    /**
+     * @brief Get the packages on the longest dependency chain, weighted by their build duration
+     * @param entries Package timeline
+     * @param graph Workspace package dependency graph
+     * @return Packages on the critical path
+     */
+    static QSet<QString> criticalPath(const ROSBuildProfiler::EntryList &entries, const ROSPackageGraph &graph);
+
+private slots:
+    void showProfile(int index);
+
+private:
+    Ui::ROSBuildProfileDialog *m_ui;
+    ROSBuildTimelineWidget *m_timeline;
+    ROSBuildProfiler::ProfileList m_profiles;
+    ROSPackageGraph m_graph;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_BUILD_PROFILE_DIALOG_H
@@ -0,0 +1,489 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_build_profiler.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMap>
+
+#include <algorithm>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+const char ROS_BUILD_PROFILE_FILE[] = "ros_qtc_build_profiles.json";
+const int ROS_BUILD_PROFILE_HISTORY = 10;
+
+qint64 ROSBuildProfiler::Entry::duration() const
+{
+    if (start < 0 || finish < start)
+        return 0;
+
+    return finish - start;
+}
+
+ROSBuildProfiler::ROSBuildProfiler()
+{
+    m_catkinToolsPackage = QRegExp(QLatin1String("^(Starting|Finished|Failed|Abandoned)\\s+(>>>|<<<)\\s+(\\S+)")); // Example: Finished  <<< roscpp  [ 12.3 seconds ]
+    m_makeTargetStarted = QRegExp(QLatin1String("Scanning dependencies of target (\\S+)")); // Example: Scanning dependencies of target talker
+    m_makeTargetFinished = QRegExp(QLatin1String("Built target (\\S+)")); // Example: [ 50%] Built target talker
+}
+
+void ROSBuildProfiler::start(const QString &buildSystem, const QHash<QString, QString> &targetPackages)
+{
+    m_profile = Profile();
+    m_profile.started = QDateTime::currentDateTime();
+    m_profile.buildSystem = buildSystem;
+    m_targetPackages = targetPackages;
+    m_packageIndex.clear();
+    m_targetIndex.clear();
+    m_timer.start();
+    m_active = true;
+}
+
+bool ROSBuildProfiler::isActive() const
+{
+    return m_active;
+}
+
+void ROSBuildProfiler::setBuildOptions(bool unityBuild, bool precompiledHeaders, bool fullBuild)
+{
+    m_profile.unityBuild = unityBuild;
+    m_profile.precompiledHeaders = precompiledHeaders;
+    m_profile.fullBuild = fullBuild;
+}
+
+void ROSBuildProfiler::packageStarted(const QString &package)
+{
+    if (!m_active)
+        return;
+
+    Entry &e = entry(m_profile.packages, m_packageIndex, package);
+    e.package = package;
+    e.start = m_timer.elapsed();
+}
+
+void ROSBuildProfiler::packageFinished(const QString &package, bool success)
+{
+    if (!m_active)
+        return;
+
+    Entry &e = entry(m_profile.packages, m_packageIndex, package);
+    e.package = package;
+    e.finish = m_timer.elapsed();
+    e.success = success;
+}
+
+void ROSBuildProfiler::targetStarted(const QString &target)
+{
+    if (!m_active)
+        return;
+
+    Entry &e = entry(m_profile.targets, m_targetIndex, target);
+    e.package = m_targetPackages.value(target);
+    e.start = m_timer.elapsed();
+}
+
+void ROSBuildProfiler::targetFinished(const QString &target, bool success)
+{
+    if (!m_active)
+        return;
+
+    Entry &e = entry(m_profile.targets, m_targetIndex, target);
+    e.package = m_targetPackages.value(target);
+    e.finish = m_timer.elapsed();
+    e.success = success;
+
+    // Targets without sources (ex. message generation) only report when they are built
+    if (e.start < 0)
+        e.start = e.finish;
+}
+
+bool ROSBuildProfiler::parseCatkinToolsLine(const QString &line, QString *finishedPackage)
+{
+    if (!m_active)
+        return false;
+
+    // Avoid stripping and matching lines which can not be a package start or finish line
+    if (!line.contains(QLatin1String(">>>")) && !line.contains(QLatin1String("<<<")))
+        return false;
+
+    if (m_catkinToolsPackage.indexIn(stripEscapeSequences(line), 0) == -1)
+        return false;
+
+    const QString status = m_catkinToolsPackage.cap(1);
+    const QString package = m_catkinToolsPackage.cap(3);
+    if (status == QLatin1String("Starting"))
+    {
+        packageStarted(package);
+        return true;
+    }
+
+    packageFinished(package, status == QLatin1String("Finished"));
+    if (finishedPackage)
+        *finishedPackage = package;
+
+    return true;
+}
+
+bool ROSBuildProfiler::parseMakeLine(const QString &line)
+{
+    if (!m_active || !line.contains(QLatin1String(" target ")))
+        return false;
+
+    if (m_makeTargetFinished.indexIn(line, 0) != -1)
+    {
+        targetFinished(m_makeTargetFinished.cap(1));
+        return true;
+    }
+
+    if (m_makeTargetStarted.indexIn(line, 0) != -1)
+    {
+        targetStarted(m_makeTargetStarted.cap(1));
+        return true;
+    }
+
+    return false;
+}
+
+const ROSBuildProfiler::Profile &ROSBuildProfiler::currentProfile() const
+{
+    return m_profile;
+}
+
+ROSBuildProfiler::Entry ROSBuildProfiler::packageEntry(const QString &package) const
+{
+    auto it = m_packageIndex.constFind(package);
+    if (it == m_packageIndex.constEnd())
+        return Entry();
+
+    return m_profile.packages.at(it.value());
+}
+
+qint64 ROSBuildProfiler::elapsed() const
+{
+    return m_active ? m_timer.elapsed() : m_profile.duration;
+}
+
+ROSBuildProfiler::Profile ROSBuildProfiler::finish(bool success)
+{
+    if (!m_active)
+        return Profile();
+
+    m_active = false;
+    m_profile.duration = m_timer.elapsed();
+    m_profile.success = success;
+
+    for (EntryList *list : {&m_profile.packages, &m_profile.targets})
+    {
+        for (Entry &e : *list)
+        {
+            if (e.start < 0)
+                e.start = 0;
+
+            if (e.finish < 0)
+            {
+                e.finish = m_profile.duration;
+                e.success = false;
+            }
+        }
+    }
+
+    return m_profile;
+}
+
+ROSBuildProfiler::EntryList ROSBuildProfiler::packageTimeline(const Profile &profile)
+{
+    EntryList packages = profile.packages;
+    if (packages.isEmpty())
+    {
+        // Span each package from its first target start to its last target finish
+        QMap<QString, Entry> spans;
+        foreach (const Entry &target, profile.targets)
+        {
+            QString package = target.package.isEmpty() ? QLatin1String("(other)") : target.package;
+            auto it = spans.find(package);
+            if (it == spans.end())
+            {
+                Entry e = target;
+                e.name = package;
+                e.package = package;
+                spans.insert(package, e);
+                continue;
+            }
+
+            it->start = qMin(it->start, target.start);
+            it->finish = qMax(it->finish, target.finish);
+            it->success = it->success && target.success;
+        }
+        packages = spans.values();
+    }
+
+    std::stable_sort(packages.begin(), packages.end(), [](const Entry &a, const Entry &b) {
+        return a.start < b.start;
+    });
+
+    return packages;
+}
+
+static QJsonArray entriesToJson(const ROSBuildProfiler::EntryList &entries)
+{
+    QJsonArray array;
+    foreach (const ROSBuildProfiler::Entry &e, entries)
+    {
+        QJsonObject object;
+        object.insert(QLatin1String("name"), e.name);
+        object.insert(QLatin1String("package"), e.package);
+        object.insert(QLatin1String("start"), double(e.start));
+        object.insert(QLatin1String("finish"), double(e.finish));
+        object.insert(QLatin1String("success"), e.success);
+        array.append(object);
+    }
+    return array;
+}
+
+static ROSBuildProfiler::EntryList entriesFromJson(const QJsonArray &array)
+{
+    ROSBuildProfiler::EntryList entries;
+    foreach (const QJsonValue &value, array)
+    {
+        QJsonObject object = value.toObject();
+        ROSBuildProfiler::Entry e;
+        e.name = object.value(QLatin1String("name")).toString();
+        e.package = object.value(QLatin1String("package")).toString();
+        e.start = qint64(object.value(QLatin1String("start")).toDouble());
+        e.finish = qint64(object.value(QLatin1String("finish")).toDouble());
+        e.success = object.value(QLatin1String("success")).toBool();
+        entries.append(e);
+    }
+    return entries;
+}
+
+bool ROSBuildProfiler::saveProfile(const Utils::FileName &buildPath, const Profile &profile)
+{
+    if (!QDir().mkpath(buildPath.toString()))
+    {
+        qDebug() << "Failed to create build directory: " << buildPath.toString();
+        return false;
+    }
+
+    QJsonObject object;
+    object.insert(QLatin1String("started"), profile.started.toString(Qt::ISODate));
+    object.insert(QLatin1String("duration"), double(profile.duration));
+    object.insert(QLatin1String("buildSystem"), profile.buildSystem);
+    object.insert(QLatin1String("success"), profile.success);
+    object.insert(QLatin1String("unityBuild"), profile.unityBuild);
+    object.insert(QLatin1String("precompiledHeaders"), profile.precompiledHeaders);
+    object.insert(QLatin1String("fullBuild"), profile.fullBuild);
+    object.insert(QLatin1String("packages"), entriesToJson(profile.packages));
+    object.insert(QLatin1String("targets"), entriesToJson(profile.targets));
+
+    // Keep a bounded history, most recent build first
+    QJsonArray history;
+    QFile file(profileFile(buildPath).toString());
+    if (file.open(QIODevice::ReadOnly))
+    {
+        history = QJsonDocument::fromJson(file.readAll()).object().value(QLatin1String("profiles")).toArray();
+        file.close();
+    }
+
+    history.prepend(object);
+    while (history.size() > ROS_BUILD_PROFILE_HISTORY)
+        history.removeLast();
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qDebug() << "Failed to write build profile: " << file.fileName();
+        return false;
+    }
+
+    QJsonObject root;
+    root.insert(QLatin1String("profiles"), history);
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return true;
+}
+
+ROSBuildProfiler::ProfileList ROSBuildProfiler::loadProfiles(const Utils::FileName &buildPath)
+{
+    ProfileList profiles;
+    QFile file(profileFile(buildPath).toString());
+    if (!file.open(QIODevice::ReadOnly))
+        return profiles;
+
+    QJsonArray history = QJsonDocument::fromJson(file.readAll()).object().value(QLatin1String("profiles")).toArray();
+    foreach (const QJsonValue &value, history)
+    {
+        QJsonObject object = value.toObject();
+        Profile profile;
+        profile.started = QDateTime::fromString(object.value(QLatin1String("started")).toString(), Qt::ISODate);
+        profile.duration = qint64(object.value(QLatin1String("duration")).toDouble());
+        profile.buildSystem = object.value(QLatin1String("buildSystem")).toString();
+        profile.success = object.value(QLatin1String("success")).toBool();
+        profile.unityBuild = object.value(QLatin1String("unityBuild")).toBool();
+        profile.precompiledHeaders = object.value(QLatin1String("precompiledHeaders")).toBool();
+        profile.fullBuild = object.value(QLatin1String("fullBuild")).toBool();
+        profile.packages = entriesFromJson(object.value(QLatin1String("packages")).toArray());
+        profile.targets = entriesFromJson(object.value(QLatin1String("targets")).toArray());
+        profiles.append(profile);
+    }
+
+    return profiles;
+}
+
+Utils::FileName ROSBuildProfiler::profileFile(const Utils::FileName &buildPath)
+{
+    return Utils::FileName(buildPath).appendPath(QLatin1String(ROS_BUILD_PROFILE_FILE));
+}
+
+QString ROSBuildProfiler::unityBuildComparison(const ProfileList &profiles)
+{
+    const Profile *unity = nullptr;
+    const Profile *regular = nullptr;
+    foreach (const Profile &profile, profiles)
+    {
+        if (!profile.success || !profile.fullBuild || profile.duration <= 0)
+            continue;
+
+        if (profile.unityBuild && !unity)
+            unity = &profile;
+        else if (!profile.unityBuild && !regular)
+            regular = &profile;
+    }
+
+    if (!unity || !regular)
+        return QString();
+
+    double change = (100.0 * (regular->duration - unity->duration)) / regular->duration;
+    return QCoreApplication::translate("ROSProjectManager::Internal::ROSBuildProfiler",
+                                       "Full build with unity build %1 s, without %2 s (%3% %4).")
+            .arg(unity->duration / 1000.0, 0, 'f', 1)
+            .arg(regular->duration / 1000.0, 0, 'f', 1)
+            .arg(qAbs(change), 0, 'f', 1)
+            .arg(change >= 0 ? QCoreApplication::translate("ROSProjectManager::Internal::ROSBuildProfiler", "faster")
+                             : QCoreApplication::translate("ROSProjectManager::Internal::ROSBuildProfiler", "slower"));
+}
+
+QMap<QString, QPair<qint64, qint64> > ROSBuildProfiler::precompiledHeaderComparison(const ProfileList &profiles)
+{
+    const Profile *with = nullptr;
+    const Profile *without = nullptr;
+    foreach (const Profile &profile, profiles)
+    {
+        if (!profile.success || !profile.fullBuild)
+            continue;
+
+        if (profile.precompiledHeaders && !with)
+            with = &profile;
+        else if (!profile.precompiledHeaders && !without)
+            without = &profile;
+    }
+
+    QMap<QString, QPair<qint64, qint64> > comparison;
+    if (!with || !without)
+        return comparison;
+
+    QHash<QString, qint64> withoutDurations;
+    foreach (const Entry &e, packageTimeline(*without))
+        if (e.success && e.finish >= 0)
+            withoutDurations.insert(e.name, e.duration());
+
+    foreach (const Entry &e, packageTimeline(*with))
+    {
+        auto it = withoutDurations.constFind(e.name);
+        if (e.success && e.finish >= 0 && it != withoutDurations.constEnd())
+            comparison.insert(e.name, qMakePair(e.duration(), it.value()));
+    }
+
+    return comparison;
+}
+
+QStringList ROSBuildProfiler::precompiledHeaderSavings(const ProfileList &profiles)
+{
+    QMap<QString, QPair<qint64, qint64> > comparison = precompiledHeaderComparison(profiles);
+
+    QList<QPair<qint64, QString> > saved;
+    for (auto it = comparison.constBegin(); it != comparison.constEnd(); ++it)
+        saved.append(qMakePair(it.value().second - it.value().first, it.key()));
+
+    std::sort(saved.begin(), saved.end(), [](const QPair<qint64, QString> &a, const QPair<qint64, QString> &b) {
+        return a.first > b.first;
+    });
+
+    QStringList messages;
+    foreach (const auto &package, saved)
+    {
+        const QPair<qint64, qint64> &durations = comparison.value(package.second);
+        double change = (durations.second > 0) ? (100.0 * package.first) / durations.second : 0.0;
+        messages.append(QCoreApplication::translate("ROSProjectManager::Internal::ROSBuildProfiler",
+                                                    "Package %1 with precompiled headers %2 s, without %3 s (%4% %5).")
+                        .arg(package.second)
+                        .arg(durations.first / 1000.0, 0, 'f', 1)
+                        .arg(durations.second / 1000.0, 0, 'f', 1)
+                        .arg(qAbs(change), 0, 'f', 1)
+                        .arg(change >= 0 ? QCoreApplication::translate("ROSProjectManager::Internal::ROSBuildProfiler", "faster")
+                                         : QCoreApplication::translate("ROSProjectManager::Internal::ROSBuildProfiler", "slower")));
+    }
+
+    return messages;
+}
+
+ROSBuildProfiler::Entry &ROSBuildProfiler::entry(EntryList &list, QHash<QString, int> &index, const QString &name)
+{
+    auto it = index.constFind(name);
+    if (it != index.constEnd())
+        return list[it.value()];
+
+    Entry e;
+    e.name = name;
+    index.insert(name, list.size());
+    list.append(e);
+    return list.last();
+}
+
+QString ROSBuildProfiler::stripEscapeSequences(const QString &line)
+{
+    // catkin tools colors its status lines (ex. "\x1b[32mFinished\x1b[0m")
+    if (!line.contains(QLatin1Char('\x1b')))
+        return line.trimmed();
+
+    QString result;
+    result.reserve(line.size());
+    for (int i = 0; i < line.size(); ++i)
+    {
+        if (line.at(i) == QLatin1Char('\x1b') && i + 1 < line.size() && line.at(i + 1) == QLatin1Char('['))
+        {
+            i += 2;
+            while (i < line.size() && !line.at(i).isLetter())
+                ++i;
+            continue;
+        }
+        result.append(line.at(i));
+    }
+    return result.trimmed();
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
@@ -0,0 +1,194 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_BUILD_PROFILER_H
+#define ROS_BUILD_PROFILER_H
+
+#include <utils/fileutils.h>
+
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QPair>
+#include <QRegExp>
+#include <QString>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Records when each package (and make target) of a build started and finished
+ *
+ * Package times come from the catkin tools start/finish lines or the package build scheduler,
+ * target times from the make "Scanning dependencies of target" and "Built target" lines.
+ * The profiles are stored in the workspace build directory so previous builds can be compared.
+ */
+class ROSBuildProfiler
+{
+public:
+    /** @brief A single package or target, times are milliseconds since the build started */
+    struct Entry {
+        QString name;         /**< @brief Package or target name */
+        QString package;      /**< @brief Package the entry belongs to */
+        qint64 start = -1;    /**< @brief Start time, -1 if the start was not seen */
+        qint64 finish = -1;   /**< @brief Finish time, -1 if it never finished */
+        bool success = true;  /**< @brief False if it failed or was abandoned */
+
+        qint64 duration() const;
+    };
+    typedef QList<Entry> EntryList;
+
+    /** @brief The timeline of a single build */
+    struct Profile {
+        QDateTime started;    /**< @brief Time the build started */
+        qint64 duration = 0;  /**< @brief Build duration in milliseconds */
+        QString buildSystem;  /**< @brief Build system used (ex. CatkinMake, CatkinTools) */
+        bool success = false; /**< @brief Build result */
+        bool unityBuild = false; /**< @brief True if the packages were unity built */
+        bool precompiledHeaders = false; /**< @brief True if precompiled headers were used */
+        bool fullBuild = false;  /**< @brief True if the workspace was built from scratch */
+        EntryList packages;   /**< @brief Package timeline, empty if only targets were seen */
+        EntryList targets;    /**< @brief Make target timeline */
+    };
+    typedef QList<Profile> ProfileList;
+
+    ROSBuildProfiler();
+
+    /**
+     * @brief Start recording a build
+     * @param buildSystem Build system name stored with the profile
+     * @param targetPackages Target name to package name, used to assign make targets to packages
+     */
+    void start(const QString &buildSystem, const QHash<QString, QString> &targetPackages = QHash<QString, QString>());
+    bool isActive() const;
+
+    /**
+     * @brief Set the build options stored with the profile
+     * @param unityBuild True if the packages are unity built
+     * @param precompiledHeaders True if precompiled headers are used
+     * @param fullBuild True if the workspace is built from scratch
+     */
+    void setBuildOptions(bool unityBuild, bool precompiledHeaders, bool fullBuild);
+
+    void packageStarted(const QString &package);
+    void packageFinished(const QString &package, bool success);
+    void targetStarted(const QString &target);
+    void targetFinished(const QString &target, bool success = true);
+
+    /**
+     * @brief Parse a catkin tools output line (ex. "Starting  >>> pkg", "Finished  <<< pkg")
+     * @param finishedPackage Set to the package name if the line finished a package
+     * @return True if the line started or finished a package
+     */
+    bool parseCatkinToolsLine(const QString &line, QString *finishedPackage = nullptr);
+
+    /**
+     * @brief Parse a make output line (ex. "Scanning dependencies of target tgt", "[ 50%] Built target tgt")
+     * @return True if the line started or finished a target
+     */
+    bool parseMakeLine(const QString &line);
+
+    /** @brief The profile recorded so far */
+    const Profile &currentProfile() const;
+
+    /** @brief Get a recorded package entry, a default entry if the package was not seen */
+    Entry packageEntry(const QString &package) const;
+
+    /** @brief Milliseconds since the build started */
+    qint64 elapsed() const;
+
+    /**
+     * @brief Stop recording, entries which did not finish are marked as failed
+     * @param success Build result
+     * @return The recorded profile
+     */
+    Profile finish(bool success);
+
+    /**
+     * @brief Get the per package timeline, if no package times were recorded they are derived from the targets
+     * @param profile Build profile
+     * @return Package entries sorted by start time
+     */
+    static EntryList packageTimeline(const Profile &profile);
+
+    /**
+     * @brief Append a profile to the workspace build profile history
+     * @param buildPath Workspace build directory
+     * @param profile Build profile
+     * @return True if successful, otherwise false.
+     */
+    static bool saveProfile(const Utils::FileName &buildPath, const Profile &profile);
+
+    /**
+     * @brief Load the workspace build profile history, most recent build first
+     * @param buildPath Workspace build directory
+     * @return Build profiles
+     */
+    static ProfileList loadProfiles(const Utils::FileName &buildPath);
+
+    /**
+     * @brief Get the build profile history file
+     * @param buildPath Workspace build directory
+     * @return Path to the build profile history file
+     */
+    static Utils::FileName profileFile(const Utils::FileName &buildPath);
+
+    /**
+     * @brief Compare the most recent successful full builds with and without unity builds
+     * @param profiles Build profiles, most recent build first
+     * @return Comparison message, empty if there is no full build of both kinds
+     */
+    static QString unityBuildComparison(const ProfileList &profiles);
+
+    /**
+     * @brief Compare the package build durations of the most recent successful full builds with and without precompiled headers
+     * @param profiles Build profiles, most recent build first
+     * @return Package name to the build duration with (first) and without (second) precompiled headers
+     */
+    static QMap<QString, QPair<qint64, qint64> > precompiledHeaderComparison(const ProfileList &profiles);
+
+    /**
+     * @brief Get a message for each package describing the time saved by precompiled headers
+     * @param profiles Build profiles, most recent build first
+     * @return Messages ordered by the time saved, largest first
+     */
+    static QStringList precompiledHeaderSavings(const ProfileList &profiles);
+
+private:
+    Entry &entry(EntryList &list, QHash<QString, int> &index, const QString &name);
+    static QString stripEscapeSequences(const QString &line);
+
+    bool m_active = false;
+    Profile m_profile;
+    QElapsedTimer m_timer;
+    QHash<QString, QString> m_targetPackages;
+    QHash<QString, int> m_packageIndex;
+    QHash<QString, int> m_targetIndex;
+    QRegExp m_catkinToolsPackage;
+    QRegExp m_makeTargetStarted;
+    QRegExp m_makeTargetFinished;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_BUILD_PROFILER_H
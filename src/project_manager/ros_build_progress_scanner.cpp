@@ -0,0 +1,141 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_build_progress_scanner.h"
+
+namespace ROSProjectManager {
+namespace Internal {
+
+static inline bool isDigit(ushort c)
+{
+    return c >= '0' && c <= '9';
+}
+
+/** @brief Parse the digits starting at pos, returns the position after them or -1 if there are none */
+static int scanNumber(const ushort *data, int size, int pos, int &value)
+{
+    int start = pos;
+    value = 0;
+    while (pos < size && isDigit(data[pos]))
+    {
+        // Saturate instead of overflowing on absurd inputs
+        if (value < 100000000)
+            value = value * 10 + (data[pos] - '0');
+        ++pos;
+    }
+
+    return (pos == start) ? -1 : pos;
+}
+
+int ROSBuildProgressScanner::makePercent(const QString &line)
+{
+    // Matches "[" up to two spaces, one to three digits then "%]"
+    const ushort *data = line.utf16();
+    const int size = line.size();
+    int percent = -1;
+
+    for (int i = 0; i + 3 < size; ++i)
+    {
+        if (data[i] != '[')
+            continue;
+
+        int pos = i + 1;
+        int spaces = 0;
+        while (pos < size && data[pos] == ' ' && spaces < 2)
+        {
+            ++pos;
+            ++spaces;
+        }
+
+        int value;
+        int end = scanNumber(data, size, pos, value);
+        if (end == -1 || end - pos > 3 || end + 1 >= size || data[end] != '%' || data[end + 1] != ']')
+            continue;
+
+        percent = value;
+        i = end + 1;
+    }
+
+    return percent;
+}
+
+bool ROSBuildProgressScanner::ninjaProgress(const QString &line, int &finished, int &total)
+{
+    const ushort *data = line.utf16();
+    const int size = line.size();
+    if (size < 5 || data[0] != '[')
+        return false;
+
+    int pos = scanNumber(data, size, 1, finished);
+    if (pos == -1 || pos >= size || data[pos] != '/')
+        return false;
+
+    pos = scanNumber(data, size, pos + 1, total);
+    return (pos != -1 && pos < size && data[pos] == ']');
+}
+
+bool ROSBuildProgressScanner::catkinToolsProgress(const QString &line, int &finished, int &total)
+{
+    // Search backwards for the last " complete]", then parse "[n/m" in front of it
+    static const char suffix[] = " complete]";
+    const int suffixSize = sizeof(suffix) - 1;
+    const ushort *data = line.utf16();
+    const int size = line.size();
+
+    for (int end = size - suffixSize; end > 0; --end)
+    {
+        if (data[end] != ' ' || data[end + suffixSize - 1] != ']')
+            continue;
+
+        int k = 1;
+        while (k < suffixSize && data[end + k] == ushort(suffix[k]))
+            ++k;
+
+        if (k != suffixSize)
+            continue;
+
+        // Walk back over the total, the slash and the finished count
+        int pos = end;
+        while (pos > 0 && isDigit(data[pos - 1]))
+            --pos;
+
+        int totalStart = pos;
+        if (totalStart == end || pos == 0 || data[pos - 1] != '/')
+            continue;
+
+        --pos;
+        int slash = pos;
+        while (pos > 0 && isDigit(data[pos - 1]))
+            --pos;
+
+        // The bracket can not be the first character of the line
+        if (pos == slash || pos < 2 || data[pos - 1] != '[')
+            continue;
+
+        scanNumber(data, size, pos, finished);
+        scanNumber(data, size, totalStart, total);
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
@@ -0,0 +1,67 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_BUILD_PROGRESS_SCANNER_H
+#define ROS_BUILD_PROGRESS_SCANNER_H
+
+#include <QString>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Scanners for the progress markers in build output
+ *
+ * They walk the line's characters directly and never allocate, since they run on every line
+ * written by the build.
+ */
+class ROSBuildProgressScanner
+{
+public:
+    /**
+     * @brief Scan for a make percentage (ex. "[ 82%] Building CXX object ...")
+     * @param line Output line
+     * @return The last percentage in the line, -1 if there is none
+     */
+    static int makePercent(const QString &line);
+
+    /**
+     * @brief Scan for ninja progress at the start of the line (ex. "[23/76] Building CXX object ...")
+     * @param line Output line
+     * @param finished Number of finished edges
+     * @param total Total number of edges
+     * @return True if the line contains ninja progress
+     */
+    static bool ninjaProgress(const QString &line, int &finished, int &total);
+
+    /**
+     * @brief Scan for catkin tools progress (ex. "[build 12.3 s] [4/24 complete] ...")
+     * @param line Output line
+     * @param finished Number of finished packages
+     * @param total Total number of packages
+     * @return True if the line contains catkin tools progress
+     */
+    static bool catkinToolsProgress(const QString &line, int &finished, int &total);
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_BUILD_PROGRESS_SCANNER_H
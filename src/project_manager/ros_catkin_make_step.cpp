@@ -21,6 +21,9 @@
 #include "ros_catkin_make_step.h"
 #include "ros_project_constants.h"
 #include "ros_project.h"
+#include "ros_build_progress_scanner.h"
+#include "ros_deferred_step_future.h"
+#include "ros_package_build_scheduler.h"
 #include "ui_ros_catkin_make_step.h"
 
 #include <extensionsystem/pluginmanager.h>
@@ -38,8 +41,11 @@
 #include <cmakeprojectmanager/cmakeparser.h>
 
 #include <QDir>
+#include <QCheckBox>
 #include <QComboBox>
 #include <QLabel>
+#include <QSpinBox>
+#include <QTimer>
 
 using namespace Core;
 using namespace ProjectExplorer;
@@ -55,6 +61,9 @@ const char ROS_CMS_TARGET_KEY[] = "ROSProjectManager.ROSCatkinMakeStep.Target";
 const char ROS_CMS_CATKIN_MAKE_ARGUMENTS_KEY[] = "ROSProjectManager.ROSCatkinMakeStep.CatkinMakeArguments";
 const char ROS_CMS_CMAKE_ARGUMENTS_KEY[] = "ROSProjectManager.ROSCatkinMakeStep.CMakeArguments";
 const char ROS_CMS_MAKE_ARGUMENTS_KEY[] = "ROSProjectManager.ROSCatkinMakeStep.MakeArguments";
+const char ROS_CMS_PARALLEL_SCHEDULER_KEY[] = "ROSProjectManager.ROSCatkinMakeStep.ParallelScheduler";
+const char ROS_CMS_SCHEDULER_JOBS_KEY[] = "ROSProjectManager.ROSCatkinMakeStep.SchedulerJobs";
+const char ROS_CMS_UNITY_BUILD_EXCLUDE_KEY[] = "ROSProjectManager.ROSCatkinMakeStep.UnityBuildExclude";
 
 ROSCatkinMakeStep::ROSCatkinMakeStep(BuildStepList *parent) :
     AbstractProcessStep(parent, Id(ROS_CMS_ID))
@@ -73,7 +82,10 @@ ROSCatkinMakeStep::ROSCatkinMakeStep(BuildStepList *parent, ROSCatkinMakeStep *b
     m_target(bs->m_target),
     m_catkinMakeArguments(bs->m_catkinMakeArguments),
     m_cmakeArguments(bs->m_cmakeArguments),
-    m_makeArguments(bs->m_makeArguments)
+    m_makeArguments(bs->m_makeArguments),
+    m_parallelScheduler(bs->m_parallelScheduler),
+    m_schedulerJobs(bs->m_schedulerJobs),
+    m_unityBuildExclude(bs->m_unityBuildExclude)
 {
     ctor();
 }
@@ -83,7 +95,18 @@ void ROSCatkinMakeStep::ctor()
     setDefaultDisplayName(QCoreApplication::translate("ROSProjectManager::Internal::ROSCatkinMakeStep",
                                                       ROS_CMS_DISPLAY_NAME));
 
-    m_percentProgress = QRegExp(QLatin1String("\\[\\s{0,2}(\\d{1,3})%\\]")); // Example: [ 82%] [ 82%] [ 87%]
+    m_outputParser = new ROSBuildOutputParser(this);
+    connect(m_outputParser, &ROSBuildOutputParser::addTask,
+            this, [this](const Task &task) { emit addTask(task); });
+    connect(m_outputParser, &ROSBuildOutputParser::flushed, this, &ROSCatkinMakeStep::reportCompilerCacheStatistics);
+
+    // The process step reports to a proxy future, so the step finishes once its summary was added
+    m_deferredFuture = new ROSDeferredStepFuture(this);
+    connect(m_deferredFuture, &ROSDeferredStepFuture::processFinished, this, &ROSCatkinMakeStep::finishRun);
+
+    m_compilerCacheStatistics = new ROSCompilerCacheStatistics(this);
+    connect(m_compilerCacheStatistics, &ROSCompilerCacheStatistics::started, this, &ROSCatkinMakeStep::startBuild);
+    connect(m_compilerCacheStatistics, &ROSCompilerCacheStatistics::finished, this, &ROSCatkinMakeStep::reportRunFinished);
 
     ROSBuildConfiguration *bc = rosBuildConfiguration();
     if (bc->buildSystem() != ROSUtils::CatkinMake)
@@ -126,6 +149,18 @@ bool ROSCatkinMakeStep::init(QList<const BuildStep *> &earlierSteps)
     // TODO: Need to get build data (build directory, environment, etc.) based on build System
     ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(bc->project()->projectDirectory(), bc->buildSystem(), bc->project()->distribution());
 
+    // Request the CMake file-api codemodel so the build information can be extracted after configuring
+    ROSUtils::writeCMakeFileApiQuery(workspaceInfo.buildPath);
+    m_profilePath = workspaceInfo.buildPath;
+
+    // Without a cache catkin_make configures and builds every package from scratch
+    m_fullBuild = !Utils::FileName(workspaceInfo.buildPath).appendPath(QLatin1String("CMakeCache.txt")).exists();
+    if (bc->unityBuild())
+        ROSUtils::writeUnityBuildExcludeFile(workspaceInfo.buildPath);
+
+    if (bc->precompiledHeaders())
+        ROSUtils::writePrecompiledHeaderFile(workspaceInfo.buildPath, bc->project()->getPrecompiledHeaderCandidates());
+
     ProcessParameters *pp = processParameters();
     pp->setMacroExpander(bc->macroExpander());
     pp->setWorkingDirectory(bc->project()->projectDirectory().toString());
@@ -134,9 +169,20 @@ bool ROSCatkinMakeStep::init(QList<const BuildStep *> &earlierSteps)
     // Force output to english for the parsers. Do this here and not in the toolchain's
     // addToEnvironment() to not screw up the users run environment.
     env.set(QLatin1String("LC_ALL"), QLatin1String("C"));
+    bc->addCompilerCacheEnvironment(env);
     pp->setEnvironment(env);
+    m_compilerLauncher = bc->compilerLauncher();
+
+    // catkin_make builds every package unless it is limited to some of them. Only the paths
+    // built now are cleared, files changed while building are built next time.
+    const QStringList catkinMakeArguments = Utils::QtcProcess::splitArgs(m_catkinMakeArguments);
+    bool partialBuild = catkinMakeArguments.contains(QLatin1String("--pkg")) ||
+                        catkinMakeArguments.contains(QLatin1String("--only-pkg-with-deps"));
+    ROSProject *pro = static_cast<ROSProject *>(bc->project());
+    m_builtChangedPaths = (m_target == BUILD && !partialBuild) ? pro->getChangedPaths() : QStringList();
+
     pp->setCommand(makeCommand());
-    pp->setArguments(allArguments(bc->cmakeBuildType()));
+    pp->setArguments(allArguments(bc->cmakeBuildType(), bc->buildGenerator(), bc->compilerLauncher()));
     pp->resolveAll();
 
     // If we are cleaning, then make can fail with an error code, but that doesn't mean
@@ -144,14 +190,16 @@ bool ROSCatkinMakeStep::init(QList<const BuildStep *> &earlierSteps)
     // That is mostly so that rebuild works on an already clean project
     setIgnoreReturnValue(m_target == CLEAN);
 
-    setOutputParser(new GnuMakeParser());
-    setOutputParser(new CMakeProjectManager::CMakeParser());
+    // The parsers run on a worker thread so large compiler logs do not block the GUI
+    IOutputParser *parser = new GnuMakeParser();
+    parser->appendOutputParser(new CMakeProjectManager::CMakeParser());
 
-    IOutputParser *parser = target()->kit()->createOutputParser();
-    if (parser)
-        appendOutputParser(parser);
+    IOutputParser *kitParser = target()->kit()->createOutputParser();
+    if (kitParser)
+        parser->appendOutputParser(kitParser);
 
-    outputParser()->setWorkingDirectory(pp->effectiveWorkingDirectory());
+    parser->setWorkingDirectory(pp->effectiveWorkingDirectory());
+    m_outputParser->setParser(parser, pp->effectiveWorkingDirectory());
 
     return AbstractProcessStep::init(earlierSteps);
 }
@@ -164,6 +212,9 @@ QVariantMap ROSCatkinMakeStep::toMap() const
     map.insert(QLatin1String(ROS_CMS_CATKIN_MAKE_ARGUMENTS_KEY), m_catkinMakeArguments);
     map.insert(QLatin1String(ROS_CMS_CMAKE_ARGUMENTS_KEY), m_cmakeArguments);
     map.insert(QLatin1String(ROS_CMS_MAKE_ARGUMENTS_KEY), m_makeArguments);
+    map.insert(QLatin1String(ROS_CMS_PARALLEL_SCHEDULER_KEY), m_parallelScheduler);
+    map.insert(QLatin1String(ROS_CMS_SCHEDULER_JOBS_KEY), m_schedulerJobs);
+    map.insert(QLatin1String(ROS_CMS_UNITY_BUILD_EXCLUDE_KEY), m_unityBuildExclude);
     return map;
 }
 
@@ -173,22 +224,31 @@ bool ROSCatkinMakeStep::fromMap(const QVariantMap &map)
     m_catkinMakeArguments = map.value(QLatin1String(ROS_CMS_CATKIN_MAKE_ARGUMENTS_KEY)).toString();
     m_cmakeArguments = map.value(QLatin1String(ROS_CMS_CMAKE_ARGUMENTS_KEY)).toString();
     m_makeArguments = map.value(QLatin1String(ROS_CMS_MAKE_ARGUMENTS_KEY)).toString();
+    m_parallelScheduler = map.value(QLatin1String(ROS_CMS_PARALLEL_SCHEDULER_KEY), false).toBool();
+    m_schedulerJobs = map.value(QLatin1String(ROS_CMS_SCHEDULER_JOBS_KEY), 0).toInt();
+    m_unityBuildExclude = map.value(QLatin1String(ROS_CMS_UNITY_BUILD_EXCLUDE_KEY)).toStringList();
 
     return BuildStep::fromMap(map);
 }
 
-QString ROSCatkinMakeStep::allArguments(ROSUtils::BuildType buildType, bool includeDefault) const
+QString ROSCatkinMakeStep::allArguments(ROSUtils::BuildType buildType, ROSUtils::BuildGenerator buildGenerator,
+                                     ROSUtils::CompilerLauncher compilerLauncher, bool includeDefault) const
 {
     QString args;
 
     switch(m_target) {
     case BUILD:
         Utils::QtcProcess::addArgs(&args, m_catkinMakeArguments);
+        // catkin_make --use-ninja passes the Ninja generator itself, the Makefile generator must be
+        // CodeBlocks so the package build info can fall back to the .cbp project files
+        if (ROSUtils::isNinjaGenerator(buildGenerator))
+            Utils::QtcProcess::addArgs(&args, QLatin1String("--use-ninja"));
+
         if (includeDefault)
             if (buildType == ROSUtils::BuildTypeUserDefined)
-                Utils::QtcProcess::addArgs(&args, QString("--cmake-args -G \"CodeBlocks - Unix Makefiles\" %1").arg(m_cmakeArguments));
+                Utils::QtcProcess::addArgs(&args, QString("--cmake-args %1 %2 %3 %4 %5").arg(ROSUtils::getCMakeGeneratorArguments(buildGenerator, !ROSUtils::isNinjaGenerator(buildGenerator)), ROSUtils::getCMakeCompilerLauncherArguments(compilerLauncher), unityBuildArguments(), precompiledHeaderArguments(), m_cmakeArguments));
             else
-                Utils::QtcProcess::addArgs(&args, QString("--cmake-args -G \"CodeBlocks - Unix Makefiles\" %1 %2").arg(ROSUtils::getCMakeBuildTypeArgument(buildType), m_cmakeArguments));
+                Utils::QtcProcess::addArgs(&args, QString("--cmake-args %1 %2 %3 %4 %5 %6").arg(ROSUtils::getCMakeGeneratorArguments(buildGenerator, !ROSUtils::isNinjaGenerator(buildGenerator)), ROSUtils::getCMakeBuildTypeArgument(buildType), ROSUtils::getCMakeCompilerLauncherArguments(compilerLauncher), unityBuildArguments(), precompiledHeaderArguments(), m_cmakeArguments));
         else
             if (!m_cmakeArguments.isEmpty())
                 Utils::QtcProcess::addArgs(&args, QString("--cmake-args %1").arg(m_cmakeArguments));
@@ -197,6 +257,9 @@ QString ROSCatkinMakeStep::allArguments(ROSUtils::BuildType buildType, bool incl
     case CLEAN:
         Utils::QtcProcess::addArgs(&args, QLatin1String("clean"));
         Utils::QtcProcess::addArgs(&args, m_catkinMakeArguments);
+        if (ROSUtils::isNinjaGenerator(buildGenerator))
+            Utils::QtcProcess::addArgs(&args, QLatin1String("--use-ninja"));
+
         if (!m_cmakeArguments.isEmpty())
             Utils::QtcProcess::addArgs(&args, QString("--cmake-args %1").arg(m_cmakeArguments));
 
@@ -209,6 +272,53 @@ QString ROSCatkinMakeStep::allArguments(ROSUtils::BuildType buildType, bool incl
     return args;
 }
 
+QString ROSCatkinMakeStep::unityBuildArguments() const
+{
+    ROSBuildConfiguration *bc = rosBuildConfiguration();
+    if (!bc || !bc->unityBuild())
+        return QString("-DCMAKE_UNITY_BUILD=OFF");
+
+    ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(bc->project()->projectDirectory(), bc->buildSystem(), bc->project()->distribution());
+    return ROSUtils::getCMakeUnityBuildArguments(workspaceInfo.buildPath, bc->unityBuildBatchSize(), m_unityBuildExclude);
+}
+
+QString ROSCatkinMakeStep::precompiledHeaderArguments() const
+{
+    ROSBuildConfiguration *bc = rosBuildConfiguration();
+    ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(bc->project()->projectDirectory(), bc->buildSystem(), bc->project()->distribution());
+    return ROSUtils::getCMakePrecompiledHeaderArguments(workspaceInfo.buildPath, bc->precompiledHeaders());
+}
+
+void ROSCatkinMakeStep::startProfile()
+{
+    // Toggling the unity build or precompiled headers rebuilds every target, so it is compared like a build from scratch
+    ROSBuildConfiguration *bc = rosBuildConfiguration();
+    ROSBuildProfiler::ProfileList profiles = ROSBuildProfiler::loadProfiles(m_profilePath);
+    bool modeChanged = !profiles.isEmpty() && (profiles.first().unityBuild != bc->unityBuild() ||
+                                               profiles.first().precompiledHeaders != bc->precompiledHeaders());
+
+    m_profiler.start(QLatin1String("CatkinMake"), targetPackages());
+    m_profiler.setBuildOptions(bc->unityBuild(), bc->precompiledHeaders(), m_fullBuild || modeChanged);
+}
+
+void ROSCatkinMakeStep::finishProfile(bool success)
+{
+    ROSBuildProfiler::Profile profile = m_profiler.finish(success);
+    ROSBuildProfiler::saveProfile(m_profilePath, profile);
+    m_history.append(profile);
+
+    if (profile.fullBuild && success)
+    {
+        ROSBuildProfiler::ProfileList profiles = ROSBuildProfiler::loadProfiles(m_profilePath);
+        QString comparison = ROSBuildProfiler::unityBuildComparison(profiles);
+        if (!comparison.isEmpty())
+            emit addOutput(comparison, BuildStep::OutputFormat::NormalMessage);
+
+        foreach (const QString &saving, ROSBuildProfiler::precompiledHeaderSavings(profiles))
+            emit addOutput(saving, BuildStep::OutputFormat::NormalMessage);
+    }
+}
+
 QString ROSCatkinMakeStep::makeCommand() const
 {
     return QLatin1String("catkin_make");
@@ -216,12 +326,221 @@ QString ROSCatkinMakeStep::makeCommand() const
 
 void ROSCatkinMakeStep::run(QFutureInterface<bool> &fi)
 {
-    AbstractProcessStep::run(fi);
+    // The statistics before the build are read first, so the build starts once they are known
+    m_runFutureInterface = &fi;
+    startCompilerCacheStatistics();
+}
+
+void ROSCatkinMakeStep::startBuild()
+{
+    if (!m_runFutureInterface)
+        return;
+
+    if (m_runFutureInterface->isCanceled())
+    {
+        finishRun(false);
+        return;
+    }
+
+    // Ninja already schedules the whole workspace as a single graph
+    ROSBuildConfiguration *bc = rosBuildConfiguration();
+    if (m_target == BUILD && m_parallelScheduler && !ROSUtils::isNinjaGenerator(bc->buildGenerator()))
+        if (runScheduler(*m_runFutureInterface))
+            return;
+
+    AbstractProcessStep::run(m_deferredFuture->start(*m_runFutureInterface));
+}
+
+void ROSCatkinMakeStep::finishRun(bool success)
+{
+    // The tasks of the remaining output are added before the statistics are read
+    m_runSucceeded = success;
+    m_outputParser->flush();
+}
+
+void ROSCatkinMakeStep::reportRunFinished(const QString &summary)
+{
+    if (!summary.isEmpty())
+        emit addOutput(summary, BuildStep::OutputFormat::NormalMessage);
+
+    m_deferredFuture->take();
+    QFutureInterface<bool> *fi = m_runFutureInterface;
+    m_runFutureInterface = nullptr;
+    if (fi)
+        reportRunResult(*fi, m_runSucceeded);
+}
+
+bool ROSCatkinMakeStep::runScheduler(QFutureInterface<bool> &fi)
+{
+    ROSBuildConfiguration *bc = rosBuildConfiguration();
+    ROSProject *project = static_cast<ROSProject *>(bc->project());
+    const ROSUtils::PackageInfoMap packageInfo = project->getPackageInfo();
+    if (packageInfo.isEmpty() || project->getPackageGraph().size() == 0)
+    {
+        emit addOutput(tr("No package information available, building the workspace with catkin_make."), BuildStep::OutputFormat::NormalMessage);
+        return false;
+    }
+
+    ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(project->projectDirectory(), bc->buildSystem(), project->distribution());
+    QMap<QString, QString> buildDirectories;
+    foreach (const ROSUtils::PackageInfo &package, packageInfo)
+    {
+        Utils::FileName packageBuildPath;
+        ROSUtils::findPackageBuildDirectory(workspaceInfo, package, packageBuildPath);
+        buildDirectories.insert(package.name, packageBuildPath.toString());
+    }
+
+    // The workspace is configured by catkin_make without building any package
+    ProcessParameters *pp = processParameters();
+    QStringList configureArguments = Utils::QtcProcess::splitArgs(pp->effectiveArguments());
+    configureArguments.append(QLatin1String("cmake_check_build_system"));
+
+    m_scheduler = new ROSPackageBuildScheduler(this);
+    m_scheduler->setEnvironment(pp->environment().toProcessEnvironment());
+    m_scheduler->setJobBudget(m_schedulerJobs);
+    m_scheduler->setConfigureCommand(pp->effectiveWorkingDirectory(), pp->effectiveCommand(), configureArguments);
+    m_scheduler->setSharedBuildDirectory(workspaceInfo.buildPath.toString());
+    m_scheduler->setMakeArguments(Utils::QtcProcess::splitArgs(m_makeArguments));
+
+    // Packages which historically take the longest are prioritized
+    m_history.load(m_profilePath);
+    m_scheduler->setPackageWeights(m_history.weights());
+
+    connect(m_scheduler, &ROSPackageBuildScheduler::stdOutput, this, &ROSCatkinMakeStep::stdOutput);
+    connect(m_scheduler, &ROSPackageBuildScheduler::stdError, this, &ROSCatkinMakeStep::stdError);
+    connect(m_scheduler, &ROSPackageBuildScheduler::progressChanged, this, &ROSCatkinMakeStep::schedulerProgressChanged);
+    connect(m_scheduler, &ROSPackageBuildScheduler::finished, this, &ROSCatkinMakeStep::schedulerFinished);
+    connect(m_scheduler, &ROSPackageBuildScheduler::packageStarted, this, [this](const QString &package) {
+        m_profiler.packageStarted(package);
+    });
+    connect(m_scheduler, &ROSPackageBuildScheduler::packageFinished,
+            this, &ROSCatkinMakeStep::packageBuilt);
+
+    m_schedulerFutureInterface = &fi;
+    fi.setProgressRange(0, 100);
+    startProfile();
+    m_profiledPackages = buildDirectories.keys();
+    m_lastEstimate = 0;
+
+    if (!m_scheduler->start(project->getPackageGraph(), buildDirectories))
+    {
+        delete m_scheduler;
+        m_scheduler = nullptr;
+        m_schedulerFutureInterface = nullptr;
+        m_profiler.finish(false);
+        return false;
+    }
+
+    // AbstractProcessStep is not driving a process, so poll for a canceled build
+    QTimer *cancelTimer = new QTimer(m_scheduler);
+    connect(cancelTimer, &QTimer::timeout, this, [this]() {
+        if (m_schedulerFutureInterface && m_schedulerFutureInterface->isCanceled())
+            m_scheduler->cancel();
+    });
+    cancelTimer->start(250);
+
+    return true;
+}
+
+void ROSCatkinMakeStep::schedulerProgressChanged(int finished, int total)
+{
+    Q_UNUSED(finished);
+    Q_UNUSED(total);
+
+    // Progress is weighted by the historical package build durations
+    m_lastEstimate = 0;
+    updateEstimate();
+}
+
+void ROSCatkinMakeStep::packageBuilt(const QString &package, bool success)
+{
+    m_profiler.packageFinished(package, success);
+
+    QString message = m_history.regressionMessage(m_profiler.packageEntry(package));
+    if (!message.isEmpty())
+        emit addTask(Task(Task::Warning, message, Utils::FileName(), -1, ProjectExplorer::Constants::TASK_CATEGORY_BUILDSYSTEM));
+}
+
+void ROSCatkinMakeStep::updateEstimate(int percent)
+{
+    QFutureInterface<bool> *fi = m_schedulerFutureInterface ? m_schedulerFutureInterface : futureInterface();
+    if (!fi)
+        return;
+
+    if (!m_profiler.isActive())
+    {
+        if (percent >= 0)
+            fi->setProgressValue(percent);
+        return;
+    }
+
+    // Estimating is cheap, but there is no need to do it for every output line
+    qint64 elapsed = m_profiler.elapsed();
+    if (m_lastEstimate > 0 && elapsed - m_lastEstimate < 500)
+        return;
+
+    m_lastEstimate = elapsed;
+    qint64 remaining = -1;
+    if (m_scheduler)
+    {
+        percent = m_history.estimateProgress(m_profiledPackages, m_profiler.currentProfile(), elapsed, &remaining);
+    }
+    else if (percent > 0)
+    {
+        // The packages are built by a single make invocation, extrapolate its progress
+        remaining = (elapsed * (100 - percent)) / percent;
+    }
+
+    if (percent < 0)
+        return;
+
+    if (remaining >= 0)
+        fi->setProgressValueAndText(percent, tr("%1 remaining").arg(ROSBuildHistory::formatDuration(remaining)));
+    else
+        fi->setProgressValue(percent);
+}
+
+void ROSCatkinMakeStep::schedulerFinished(bool success)
+{
+    QFutureInterface<bool> *fi = m_schedulerFutureInterface;
+    m_schedulerFutureInterface = nullptr;
+    m_scheduler->deleteLater();
+    m_scheduler = nullptr;
+
+    if (success)
+        emit addOutput(tr("All packages were built successfully."), BuildStep::OutputFormat::NormalMessage);
+    else
+        emit addOutput(tr("Building the packages failed or was canceled."), BuildStep::OutputFormat::ErrorMessage);
+
+    fi->setProgressValue(100);
+    finishProfile(success);
+    clearBuiltChangedPaths(success);
+
+    finishRun(success);
+}
+
+QHash<QString, QString> ROSCatkinMakeStep::targetPackages() const
+{
+    QHash<QString, QString> targets;
+    ROSProject *project = static_cast<ROSProject *>(rosBuildConfiguration()->project());
+    const ROSUtils::PackageBuildInfoMap buildInfo = project->getPackageBuildInfo();
+    foreach (const ROSUtils::PackageBuildInfo &package, buildInfo)
+        foreach (const ROSUtils::PackageTargetInfo &target, package.targets)
+            targets.insert(target.name, package.parent.name);
+
+    return targets;
 }
 
 void ROSCatkinMakeStep::processStarted()
 {
     futureInterface()->setProgressRange(0, 100);
+    if (m_target == BUILD)
+    {
+        startProfile();
+        m_profiledPackages.clear();
+        m_lastEstimate = 0;
+    }
+
     AbstractProcessStep::processStarted();
 }
 
@@ -229,20 +548,62 @@ void ROSCatkinMakeStep::processFinished(int exitCode, QProcess::ExitStatus statu
 {
     AbstractProcessStep::processFinished(exitCode, status);
     futureInterface()->setProgressValue(100);
+
+    if (m_profiler.isActive())
+        finishProfile(processSucceeded(exitCode, status));
+
+    clearBuiltChangedPaths(processSucceeded(exitCode, status));
+}
+
+void ROSCatkinMakeStep::clearBuiltChangedPaths(bool success)
+{
+    if (!m_builtChangedPaths.isEmpty() && success)
+        static_cast<ROSProject *>(target()->project())->removeChangedPaths(m_builtChangedPaths);
+
+    m_builtChangedPaths.clear();
+}
+
+void ROSCatkinMakeStep::startCompilerCacheStatistics()
+{
+    // Read in the background, the compiler launcher may take a while with a large cache
+    ROSUtils::CompilerLauncher compilerLauncher = (m_target == BUILD) ? m_compilerLauncher : ROSUtils::NoCompilerLauncher;
+    m_compilerCacheStatistics->start(compilerLauncher, processParameters()->environment().toProcessEnvironment());
+}
+
+void ROSCatkinMakeStep::reportCompilerCacheStatistics()
+{
+    m_compilerCacheStatistics->finish();
+}
+
+void ROSCatkinMakeStep::stdError(const QString &line)
+{
+    AbstractProcessStep::stdError(line);
+    m_outputParser->stdError(line);
 }
 
 void ROSCatkinMakeStep::stdOutput(const QString &line)
 {
     AbstractProcessStep::stdOutput(line);
-    int pos = 0;
-    while ((pos = m_percentProgress.indexIn(line, pos)) != -1) {
-        bool ok = false;
-        int percent = m_percentProgress.cap(1).toInt(&ok);
-        if (ok)
-            futureInterface()->setProgressValue(percent);
-
-        pos += m_percentProgress.matchedLength();
+    m_outputParser->stdOutput(line);
+    m_profiler.parseMakeLine(line);
+
+    // Progress is reported per package while scheduling
+    if (m_scheduler)
+    {
+        updateEstimate();
+        return;
     }
+
+    // Example: [ 82%] Building CXX object ..., only the last percentage of a line matters
+    int percent = ROSBuildProgressScanner::makePercent(line);
+    if (percent >= 0)
+        updateEstimate(percent);
+
+    // Example: [23/76] Building CXX object ...
+    int finished = 0;
+    int total = 0;
+    if (ROSBuildProgressScanner::ninjaProgress(line, finished, total) && total > 0 && finished <= total)
+        updateEstimate((finished * 100) / total);
 }
 
 BuildStepConfigWidget *ROSCatkinMakeStep::createConfigWidget()
@@ -278,6 +639,11 @@ ROSCatkinMakeStepWidget::ROSCatkinMakeStepWidget(ROSCatkinMakeStep *makeStep)
     m_ui->catkinMakeArgumentsLineEdit->setText(m_makeStep->m_catkinMakeArguments);
     m_ui->cmakeArgumentsLineEdit->setText(m_makeStep->m_cmakeArguments);
     m_ui->makeArgumentsLineEdit->setText(m_makeStep->m_makeArguments);
+    m_ui->parallelSchedulerCheckBox->setChecked(m_makeStep->m_parallelScheduler);
+    m_ui->schedulerJobsSpinBox->setValue(m_makeStep->m_schedulerJobs);
+    m_ui->schedulerJobsSpinBox->setEnabled(m_makeStep->m_parallelScheduler);
+    m_ui->unityBuildExcludeLineEdit->setText(m_makeStep->m_unityBuildExclude.join(QLatin1Char(' ')));
+    m_ui->unityBuildExcludeLineEdit->setEnabled(m_makeStep->rosBuildConfiguration()->unityBuild());
 
     updateDetails();
 
@@ -290,6 +656,15 @@ ROSCatkinMakeStepWidget::ROSCatkinMakeStepWidget(ROSCatkinMakeStep *makeStep)
     connect(m_ui->makeArgumentsLineEdit, &QLineEdit::textEdited,
             this, &ROSCatkinMakeStepWidget::updateDetails);
 
+    connect(m_ui->parallelSchedulerCheckBox, &QCheckBox::toggled,
+            this, &ROSCatkinMakeStepWidget::updateDetails);
+
+    connect(m_ui->unityBuildExcludeLineEdit, &QLineEdit::textEdited,
+            this, &ROSCatkinMakeStepWidget::updateDetails);
+
+    connect(m_ui->schedulerJobsSpinBox, static_cast<void (QSpinBox::*)(int)>(&QSpinBox::valueChanged),
+            this, &ROSCatkinMakeStepWidget::updateDetails);
+
     connect(m_makeStep, SIGNAL(enabledChanged()),
             this, SLOT(enabledChanged()));
 
@@ -300,6 +675,15 @@ ROSCatkinMakeStepWidget::ROSCatkinMakeStepWidget(ROSCatkinMakeStep *makeStep)
     connect(bc, &ROSBuildConfiguration::cmakeBuildTypeChanged,
             this, &ROSCatkinMakeStepWidget::updateDetails);
 
+    connect(bc, &ROSBuildConfiguration::buildGeneratorChanged,
+            this, &ROSCatkinMakeStepWidget::updateDetails);
+
+    connect(bc, &ROSBuildConfiguration::compilerLauncherChanged,
+            this, &ROSCatkinMakeStepWidget::updateDetails);
+
+    connect(bc, &ROSBuildConfiguration::unityBuildChanged,
+            this, &ROSCatkinMakeStepWidget::updateDetails);
+
     ROSProject *pro = static_cast<ROSProject *>(m_makeStep->target()->project());
     connect(pro, &ROSProject::environmentChanged,
             this, &ROSCatkinMakeStepWidget::updateDetails);
@@ -323,8 +707,13 @@ void ROSCatkinMakeStepWidget::updateDetails()
     m_makeStep->m_catkinMakeArguments = m_ui->catkinMakeArgumentsLineEdit->text();
     m_makeStep->m_cmakeArguments = m_ui->cmakeArgumentsLineEdit->text();
     m_makeStep->m_makeArguments = m_ui->makeArgumentsLineEdit->text();
+    m_makeStep->m_parallelScheduler = m_ui->parallelSchedulerCheckBox->isChecked();
+    m_makeStep->m_schedulerJobs = m_ui->schedulerJobsSpinBox->value();
+    m_ui->schedulerJobsSpinBox->setEnabled(m_makeStep->m_parallelScheduler);
+    m_makeStep->m_unityBuildExclude = m_ui->unityBuildExcludeLineEdit->text().split(QLatin1Char(' '), QString::SkipEmptyParts);
 
     ROSBuildConfiguration *bc = m_makeStep->rosBuildConfiguration();
+    m_ui->unityBuildExcludeLineEdit->setEnabled(bc->unityBuild());
     ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(bc->project()->projectDirectory(), bc->buildSystem(), bc->project()->distribution());
     Utils::Environment env(ROSUtils::getWorkspaceEnvironment(workspaceInfo).toStringList());
 
@@ -333,7 +722,7 @@ void ROSCatkinMakeStepWidget::updateDetails()
     param.setWorkingDirectory(workspaceInfo.buildPath.toString());
     param.setEnvironment(env);
     param.setCommand(m_makeStep->makeCommand());
-    param.setArguments(m_makeStep->allArguments(bc->cmakeBuildType(), false));
+    param.setArguments(m_makeStep->allArguments(bc->cmakeBuildType(), bc->buildGenerator(), bc->compilerLauncher(), false));
     m_summaryText = param.summary(displayName());
     emit updateSummary();
 }
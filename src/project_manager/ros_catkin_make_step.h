@@ -23,6 +23,10 @@
 
 #include <projectexplorer/abstractprocessstep.h>
 #include "ros_build_configuration.h"
+#include "ros_build_history.h"
+#include "ros_build_output_parser.h"
+#include "ros_build_profiler.h"
+#include "ros_compiler_cache_statistics.h"
 
 QT_BEGIN_NAMESPACE
 class QListWidgetItem;
@@ -33,6 +37,8 @@ namespace Internal {
 
 class ROSCatkinMakeStepWidget;
 class ROSCatkinMakeStepFactory;
+class ROSDeferredStepFuture;
+class ROSPackageBuildScheduler;
 namespace Ui { class ROSCatkinMakeStep; }
 
 class ROSCatkinMakeStep : public ProjectExplorer::AbstractProcessStep
@@ -56,7 +62,8 @@ public:
     ROSBuildConfiguration *rosBuildConfiguration() const;
     BuildTargets buildTarget() const;
     void setBuildTarget(const BuildTargets &target);
-    QString allArguments(ROSUtils::BuildType buildType, bool includeDefault = true) const;
+    QString allArguments(ROSUtils::BuildType buildType, ROSUtils::BuildGenerator buildGenerator,
+                         ROSUtils::CompilerLauncher compilerLauncher, bool includeDefault = true) const;
     QString makeCommand() const;
 
     QVariantMap toMap() const;
@@ -68,18 +75,54 @@ protected:
     bool fromMap(const QVariantMap &map) override;
 
     void stdOutput(const QString &line) override;
+    void stdError(const QString &line) override;
     void processStarted() override;
     void processFinished(int exitCode, QProcess::ExitStatus status) override;
 
+private slots:
+    void schedulerProgressChanged(int finished, int total);
+    void schedulerFinished(bool success);
+    void startBuild();
+    void finishRun(bool success);
+    void reportRunFinished(const QString &summary);
+
 private:
     void ctor();
     ROSBuildConfiguration *targetsActiveBuildConfiguration() const;
+    void startCompilerCacheStatistics();
+    void reportCompilerCacheStatistics();
+    bool runScheduler(QFutureInterface<bool> &fi);
+    QHash<QString, QString> targetPackages() const;
+    void packageBuilt(const QString &package, bool success);
+    void updateEstimate(int percent = -1);
+    QString unityBuildArguments() const;
+    QString precompiledHeaderArguments() const;
+    void startProfile();
+    void finishProfile(bool success);
+    void clearBuiltChangedPaths(bool success);
 
     BuildTargets m_target;
     QString m_catkinMakeArguments;
     QString m_cmakeArguments;
     QString m_makeArguments;
-    QRegExp m_percentProgress;
+    bool m_parallelScheduler = false;
+    int m_schedulerJobs = 0;
+    QStringList m_unityBuildExclude;
+    bool m_fullBuild = false;
+    QStringList m_builtChangedPaths; /**< @brief Changed paths when the build started */
+    ROSPackageBuildScheduler *m_scheduler = nullptr;
+    QFutureInterface<bool> *m_schedulerFutureInterface = nullptr;
+    ROSBuildOutputParser *m_outputParser = nullptr;
+    ROSBuildProfiler m_profiler;
+    ROSBuildHistory m_history;
+    QStringList m_profiledPackages;
+    qint64 m_lastEstimate = 0;
+    Utils::FileName m_profilePath;
+    ROSUtils::CompilerLauncher m_compilerLauncher = ROSUtils::NoCompilerLauncher;
+    ROSCompilerCacheStatistics *m_compilerCacheStatistics = nullptr;
+    ROSDeferredStepFuture *m_deferredFuture = nullptr;
+    QFutureInterface<bool> *m_runFutureInterface = nullptr; /**< @brief Future of the running build step */
+    bool m_runSucceeded = false;
 };
 
 class ROSCatkinMakeStepWidget : public ProjectExplorer::BuildStepConfigWidget
@@ -21,6 +21,8 @@
 #include "ros_catkin_tools_step.h"
 #include "ros_project_constants.h"
 #include "ros_project.h"
+#include "ros_build_progress_scanner.h"
+#include "ros_deferred_step_future.h"
 #include "ui_ros_catkin_tools_step.h"
 #include "ui_ros_catkin_tools_list_editor.h"
 #include "ui_ros_catkin_tools_config_editor.h"
@@ -42,6 +44,7 @@
 
 #include <fstream>
 #include <QDir>
+#include <QFileInfo>
 #include <QInputDialog>
 
 using namespace Core;
@@ -59,6 +62,7 @@ const char ROS_CTS_CATKIN_TOOLS_ARGUMENTS_KEY[] = "ROSProjectManager.ROSCatkinTo
 const char ROS_CTS_CATKIN_MAKE_ARGUMENTS_KEY[] = "ROSProjectManager.ROSCatkinToolsStep.CatkinMakeArguments";
 const char ROS_CTS_CMAKE_ARGUMENTS_KEY[] = "ROSProjectManager.ROSCatkinToolsStep.CMakeArguments";
 const char ROS_CTS_MAKE_ARGUMENTS_KEY[] = "ROSProjectManager.ROSCatkinToolsStep.MakeArguments";
+const char ROS_CTS_AFFECTED_PACKAGES_ONLY_KEY[] = "ROSProjectManager.ROSCatkinToolsStep.AffectedPackagesOnly";
 
 ROSCatkinToolsStep::ROSCatkinToolsStep(BuildStepList *parent) :
     AbstractProcessStep(parent, Id(ROS_CTS_ID))
@@ -79,7 +83,8 @@ ROSCatkinToolsStep::ROSCatkinToolsStep(BuildStepList *parent, ROSCatkinToolsStep
     m_catkinToolsArguments(bs->m_catkinToolsArguments),
     m_catkinMakeArguments(bs->m_catkinMakeArguments),
     m_cmakeArguments(bs->m_cmakeArguments),
-    m_makeArguments(bs->m_makeArguments)
+    m_makeArguments(bs->m_makeArguments),
+    m_affectedPackagesOnly(bs->m_affectedPackagesOnly)
 {
     ctor();
 }
@@ -92,7 +97,18 @@ void ROSCatkinToolsStep::ctor()
     if (m_activeProfile.isEmpty())
         m_activeProfile = "default";
 
-    m_percentProgress = QRegExp(QLatin1String(".+\\[(\\d+)/(\\d+) complete\\]")); // Example: [0/24 complete]
+    m_outputParser = new ROSBuildOutputParser(this);
+    connect(m_outputParser, &ROSBuildOutputParser::addTask,
+            this, [this](const Task &task) { emit addTask(task); });
+    connect(m_outputParser, &ROSBuildOutputParser::flushed, this, &ROSCatkinToolsStep::reportCompilerCacheStatistics);
+
+    // The process step reports to a proxy future, so the step finishes once its summary was added
+    m_deferredFuture = new ROSDeferredStepFuture(this);
+    connect(m_deferredFuture, &ROSDeferredStepFuture::processFinished, this, &ROSCatkinToolsStep::finishRun);
+
+    m_compilerCacheStatistics = new ROSCompilerCacheStatistics(this);
+    connect(m_compilerCacheStatistics, &ROSCompilerCacheStatistics::started, this, &ROSCatkinToolsStep::startBuild);
+    connect(m_compilerCacheStatistics, &ROSCompilerCacheStatistics::finished, this, &ROSCatkinToolsStep::reportRunFinished);
 
     ROSBuildConfiguration *bc = rosBuildConfiguration();
     if (bc->buildSystem() != ROSUtils::CatkinTools)
@@ -134,6 +150,17 @@ bool ROSCatkinToolsStep::init(QList<const BuildStep *> &earlierSteps)
     // Set Catkin Tools Active Profile
     ROSUtils::setCatkinToolsActiveProfile(bc->project()->projectDirectory(), activeProfile());
     ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(bc->project()->projectDirectory(), bc->buildSystem(), bc->project()->distribution());
+    m_profilePath = workspaceInfo.buildPath;
+
+    // catkin tools creates a build directory for each package, none exist before the first build
+    m_fullBuild = QDir(workspaceInfo.buildPath.toString()).entryList(QDir::Dirs | QDir::NoDotAndDotDot).isEmpty();
+    m_unityBuild = bc->unityBuild();
+    if (m_unityBuild)
+        ROSUtils::writeUnityBuildExcludeFile(workspaceInfo.buildPath);
+
+    m_precompiledHeaders = bc->precompiledHeaders();
+    if (m_precompiledHeaders)
+        ROSUtils::writePrecompiledHeaderFile(workspaceInfo.buildPath, bc->project()->getPrecompiledHeaderCandidates());
 
     ProcessParameters *pp = processParameters();
     pp->setMacroExpander(bc->macroExpander());
@@ -143,9 +170,16 @@ bool ROSCatkinToolsStep::init(QList<const BuildStep *> &earlierSteps)
     // Force output to english for the parsers. Do this here and not in the toolchain's
     // addToEnvironment() to not screw up the users run environment.
     env.set(QLatin1String("LC_ALL"), QLatin1String("C"));
+    bc->addCompilerCacheEnvironment(env);
     pp->setEnvironment(env);
+    m_compilerLauncher = bc->compilerLauncher();
+
+    // Full and affected package builds both build every changed path. Only the paths built now
+    // are cleared, files changed while building are built next time.
+    ROSProject *pro = static_cast<ROSProject *>(bc->project());
+    m_builtChangedPaths = (m_target == BUILD) ? pro->getChangedPaths() : QStringList();
     pp->setCommand(makeCommand());
-    pp->setArguments(allArguments(bc->cmakeBuildType()));
+    pp->setArguments(allArguments(bc->cmakeBuildType(), bc->buildGenerator(), bc->compilerLauncher()));
     pp->resolveAll();
 
     // If we are cleaning, then make can fail with an error code, but that doesn't mean
@@ -153,14 +187,16 @@ bool ROSCatkinToolsStep::init(QList<const BuildStep *> &earlierSteps)
     // That is mostly so that rebuild works on an already clean project
     setIgnoreReturnValue(m_target == CLEAN);
 
-    setOutputParser(new GnuMakeParser());
-    setOutputParser(new CMakeProjectManager::CMakeParser());
+    // The parsers run on a worker thread so large compiler logs do not block the GUI
+    IOutputParser *parser = new GnuMakeParser();
+    parser->appendOutputParser(new CMakeProjectManager::CMakeParser());
 
-    IOutputParser *parser = target()->kit()->createOutputParser();
-    if (parser)
-        appendOutputParser(parser);
+    IOutputParser *kitParser = target()->kit()->createOutputParser();
+    if (kitParser)
+        parser->appendOutputParser(kitParser);
 
-    outputParser()->setWorkingDirectory(pp->effectiveWorkingDirectory());
+    parser->setWorkingDirectory(pp->effectiveWorkingDirectory());
+    m_outputParser->setParser(parser, pp->effectiveWorkingDirectory());
 
     return AbstractProcessStep::init(earlierSteps);
 }
@@ -175,6 +211,7 @@ QVariantMap ROSCatkinToolsStep::toMap() const
     map.insert(QLatin1String(ROS_CTS_CATKIN_MAKE_ARGUMENTS_KEY), m_catkinMakeArguments);
     map.insert(QLatin1String(ROS_CTS_CMAKE_ARGUMENTS_KEY), m_cmakeArguments);
     map.insert(QLatin1String(ROS_CTS_MAKE_ARGUMENTS_KEY), m_makeArguments);
+    map.insert(QLatin1String(ROS_CTS_AFFECTED_PACKAGES_ONLY_KEY), m_affectedPackagesOnly);
     return map;
 }
 
@@ -186,10 +223,12 @@ bool ROSCatkinToolsStep::fromMap(const QVariantMap &map)
     m_catkinMakeArguments = map.value(QLatin1String(ROS_CTS_CATKIN_MAKE_ARGUMENTS_KEY)).toString();
     m_cmakeArguments = map.value(QLatin1String(ROS_CTS_CMAKE_ARGUMENTS_KEY)).toString();
     m_makeArguments = map.value(QLatin1String(ROS_CTS_MAKE_ARGUMENTS_KEY)).toString();
+    m_affectedPackagesOnly = map.value(QLatin1String(ROS_CTS_AFFECTED_PACKAGES_ONLY_KEY), false).toBool();
     return BuildStep::fromMap(map);
 }
 
-QString ROSCatkinToolsStep::allArguments(ROSUtils::BuildType buildType, bool includeDefault) const
+QString ROSCatkinToolsStep::allArguments(ROSUtils::BuildType buildType, ROSUtils::BuildGenerator buildGenerator,
+                                     ROSUtils::CompilerLauncher compilerLauncher, bool includeDefault) const
 {
     QString args;
 
@@ -198,11 +237,22 @@ QString ROSCatkinToolsStep::allArguments(ROSUtils::BuildType buildType, bool inc
         Utils::QtcProcess::addArgs(&args, QLatin1String("build"));
         Utils::QtcProcess::addArgs(&args, m_catkinToolsArguments);
 
+        // If nothing has changed or a dependency was never built the whole workspace is built
+        if (m_affectedPackagesOnly)
+        {
+            QStringList packages = affectedPackages();
+            if (!packages.isEmpty())
+            {
+                Utils::QtcProcess::addArgs(&args, QLatin1String("--no-deps"));
+                Utils::QtcProcess::addArgs(&args, packages);
+            }
+        }
+
         if (!m_catkinMakeArguments.isEmpty())
             Utils::QtcProcess::addArgs(&args, QString("--catkin-make-args %1").arg(m_catkinMakeArguments));
 
         if (includeDefault)
-            Utils::QtcProcess::addArgs(&args, QString("--cmake-args -G \"CodeBlocks - Unix Makefiles\" %1 %2").arg(ROSUtils::getCMakeBuildTypeArgument(buildType), m_cmakeArguments));
+            Utils::QtcProcess::addArgs(&args, QString("--cmake-args %1 %2 %3 %4 %5 %6").arg(ROSUtils::getCMakeGeneratorArguments(buildGenerator), ROSUtils::getCMakeBuildTypeArgument(buildType), ROSUtils::getCMakeCompilerLauncherArguments(compilerLauncher), unityBuildArguments(), precompiledHeaderArguments(), m_cmakeArguments));
         else
             if (!m_cmakeArguments.isEmpty())
                 Utils::QtcProcess::addArgs(&args, QString("--cmake-args %1").arg(m_cmakeArguments));
@@ -227,6 +277,24 @@ QString ROSCatkinToolsStep::allArguments(ROSUtils::BuildType buildType, bool inc
     return args;
 }
 
+QString ROSCatkinToolsStep::unityBuildArguments() const
+{
+    ROSBuildConfiguration *bc = rosBuildConfiguration();
+    if (!bc || !bc->unityBuild())
+        return QString("-DCMAKE_UNITY_BUILD=OFF");
+
+    ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(bc->project()->projectDirectory(), bc->buildSystem(), bc->project()->distribution());
+    QStringList excluded = ROSUtils::getCatkinToolsUnityBuildExclude(bc->project()->projectDirectory(), m_activeProfile);
+    return ROSUtils::getCMakeUnityBuildArguments(workspaceInfo.buildPath, bc->unityBuildBatchSize(), excluded);
+}
+
+QString ROSCatkinToolsStep::precompiledHeaderArguments() const
+{
+    ROSBuildConfiguration *bc = rosBuildConfiguration();
+    ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(bc->project()->projectDirectory(), bc->buildSystem(), bc->project()->distribution());
+    return ROSUtils::getCMakePrecompiledHeaderArguments(workspaceInfo.buildPath, bc->precompiledHeaders());
+}
+
 QString ROSCatkinToolsStep::makeCommand() const
 {
     return QLatin1String("catkin");
@@ -234,12 +302,67 @@ QString ROSCatkinToolsStep::makeCommand() const
 
 void ROSCatkinToolsStep::run(QFutureInterface<bool> &fi)
 {
-    AbstractProcessStep::run(fi);
+    // The statistics before the build are read first, so the build starts once they are known
+    m_runFutureInterface = &fi;
+    startCompilerCacheStatistics();
+}
+
+void ROSCatkinToolsStep::startBuild()
+{
+    if (!m_runFutureInterface)
+        return;
+
+    if (m_runFutureInterface->isCanceled())
+    {
+        finishRun(false);
+        return;
+    }
+
+    AbstractProcessStep::run(m_deferredFuture->start(*m_runFutureInterface));
+}
+
+void ROSCatkinToolsStep::finishRun(bool success)
+{
+    // The tasks of the remaining output are added before the statistics are read
+    m_runSucceeded = success;
+    m_outputParser->flush();
+}
+
+void ROSCatkinToolsStep::reportRunFinished(const QString &summary)
+{
+    if (!summary.isEmpty())
+        emit addOutput(summary, BuildStep::OutputFormat::NormalMessage);
+
+    m_deferredFuture->take();
+    QFutureInterface<bool> *fi = m_runFutureInterface;
+    m_runFutureInterface = nullptr;
+    if (fi)
+        reportRunResult(*fi, m_runSucceeded);
 }
 
 void ROSCatkinToolsStep::processStarted()
 {
     futureInterface()->setProgressRange(0, 100);
+    if (m_target == BUILD)
+    {
+        // Toggling the unity build or precompiled headers rebuilds every target, so it is compared like a build from scratch
+        ROSBuildProfiler::ProfileList profiles = ROSBuildProfiler::loadProfiles(m_profilePath);
+        bool modeChanged = !profiles.isEmpty() && (profiles.first().unityBuild != m_unityBuild ||
+                                                   profiles.first().precompiledHeaders != m_precompiledHeaders);
+
+        m_profiler.start(QLatin1String("CatkinTools"));
+        m_profiler.setBuildOptions(m_unityBuild, m_precompiledHeaders, m_fullBuild || modeChanged);
+        m_history.load(m_profilePath);
+        m_lastEstimate = 0;
+        m_completedJobs = 0;
+        m_totalJobs = 0;
+
+        ROSProject *pro = static_cast<ROSProject *>(target()->project());
+        m_profiledPackages = m_affectedPackagesOnly ? affectedPackages() : QStringList();
+        if (m_profiledPackages.isEmpty())
+            m_profiledPackages = pro->getPackageInfo().keys();
+    }
+
     AbstractProcessStep::processStarted();
 }
 
@@ -247,18 +370,112 @@ void ROSCatkinToolsStep::processFinished(int exitCode, QProcess::ExitStatus stat
 {
     AbstractProcessStep::processFinished(exitCode, status);
     futureInterface()->setProgressValue(100);
+
+    if (!m_builtChangedPaths.isEmpty() && processSucceeded(exitCode, status))
+        static_cast<ROSProject *>(target()->project())->removeChangedPaths(m_builtChangedPaths);
+    m_builtChangedPaths.clear();
+
+    if (m_profiler.isActive())
+    {
+        ROSBuildProfiler::Profile profile = m_profiler.finish(processSucceeded(exitCode, status));
+        ROSBuildProfiler::saveProfile(m_profilePath, profile);
+        m_history.append(profile);
+
+        if (profile.fullBuild && profile.success)
+        {
+            ROSBuildProfiler::ProfileList profiles = ROSBuildProfiler::loadProfiles(m_profilePath);
+            QString comparison = ROSBuildProfiler::unityBuildComparison(profiles);
+            if (!comparison.isEmpty())
+                emit addOutput(comparison, BuildStep::OutputFormat::NormalMessage);
+
+            foreach (const QString &saving, ROSBuildProfiler::precompiledHeaderSavings(profiles))
+                emit addOutput(saving, BuildStep::OutputFormat::NormalMessage);
+        }
+    }
+}
+
+void ROSCatkinToolsStep::packageBuilt(const QString &package)
+{
+    QString message = m_history.regressionMessage(m_profiler.packageEntry(package));
+    if (!message.isEmpty())
+        emit addTask(Task(Task::Warning, message, Utils::FileName(), -1, ProjectExplorer::Constants::TASK_CATEGORY_BUILDSYSTEM));
+}
+
+void ROSCatkinToolsStep::updateEstimate(bool force)
+{
+    // Estimating is cheap, but there is no need to do it for every output line
+    qint64 elapsed = m_profiler.elapsed();
+    if (!force && elapsed - m_lastEstimate < 500)
+        return;
+
+    m_lastEstimate = elapsed;
+    qint64 remaining = -1;
+    int percent = 0;
+    if (m_totalJobs > 0)
+    {
+        // catkin knows which packages it builds, the history only interpolates the running ones
+        double done = qMin(m_completedJobs + m_history.runningProgress(m_profiler.currentProfile(), elapsed), double(m_totalJobs));
+        percent = qBound(0, int((100.0 * done) / m_totalJobs), 100);
+        if (done > 0.0)
+            remaining = qint64((m_totalJobs - done) * (elapsed / done));
+    }
+    else
+    {
+        percent = m_history.estimateProgress(m_profiledPackages, m_profiler.currentProfile(), elapsed, &remaining);
+    }
+
+    if (remaining >= 0)
+        futureInterface()->setProgressValueAndText(percent, tr("%1 remaining").arg(ROSBuildHistory::formatDuration(remaining)));
+    else
+        futureInterface()->setProgressValue(percent);
+}
+
+void ROSCatkinToolsStep::startCompilerCacheStatistics()
+{
+    // Read in the background, the compiler launcher may take a while with a large cache
+    ROSUtils::CompilerLauncher compilerLauncher = (m_target == BUILD) ? m_compilerLauncher : ROSUtils::NoCompilerLauncher;
+    m_compilerCacheStatistics->start(compilerLauncher, processParameters()->environment().toProcessEnvironment());
+}
+
+void ROSCatkinToolsStep::reportCompilerCacheStatistics()
+{
+    m_compilerCacheStatistics->finish();
+}
+
+void ROSCatkinToolsStep::stdError(const QString &line)
+{
+    AbstractProcessStep::stdError(line);
+    m_outputParser->stdError(line);
 }
 
 void ROSCatkinToolsStep::stdOutput(const QString &line)
 {
     AbstractProcessStep::stdOutput(line);
-    if (m_percentProgress.indexIn(line, 0) != -1)
+    m_outputParser->stdOutput(line);
+
+    // Example: [build 12.3 s] [4/24 complete] ...
+    int finished = 0;
+    int total = 0;
+    bool counted = ROSBuildProgressScanner::catkinToolsProgress(line, finished, total) && total > 0 && finished <= total;
+    if (counted)
     {
-        bool ok = false;
-        int percent = (m_percentProgress.cap(1).toDouble(&ok)/m_percentProgress.cap(2).toDouble(&ok)) * 100.0;
-        if (ok)
-            futureInterface()->setProgressValue(percent);
+        m_completedJobs = finished;
+        m_totalJobs = total;
     }
+
+    // The historical package build durations interpolate between catkin's counts when profiling
+    if (m_profiler.isActive() && !m_profiledPackages.isEmpty())
+    {
+        QString finishedPackage;
+        if (m_profiler.parseCatkinToolsLine(line, &finishedPackage) && !finishedPackage.isEmpty())
+            packageBuilt(finishedPackage);
+
+        updateEstimate(counted);
+        return;
+    }
+
+    if (counted)
+        futureInterface()->setProgressValue((finished * 100) / total);
 }
 
 BuildStepConfigWidget *ROSCatkinToolsStep::createConfigWidget()
@@ -291,6 +508,44 @@ void ROSCatkinToolsStep::setActiveProfile(const QString &profileName)
     m_activeProfile = profileName;
 }
 
+bool ROSCatkinToolsStep::affectedPackagesOnly() const
+{
+    return m_affectedPackagesOnly;
+}
+
+void ROSCatkinToolsStep::setAffectedPackagesOnly(const bool &affectedPackagesOnly)
+{
+    m_affectedPackagesOnly = affectedPackagesOnly;
+}
+
+QStringList ROSCatkinToolsStep::affectedPackages() const
+{
+    // The changed packages and all packages depending on them
+    ROSProject *pro = static_cast<ROSProject *>(target()->project());
+    QStringList changedPackages = ROSUtils::getPackagesContainingPaths(pro->getPackageInfo(), pro->getChangedPaths());
+    QStringList packages = pro->getPackageGraph().reverseDependencyClosure(changedPackages);
+
+    // Packages are built with --no-deps, so every dependency outside the set must already be built
+    ROSBuildConfiguration *bc = rosBuildConfiguration();
+    if (!bc)
+        bc = targetsActiveBuildConfiguration();
+    if (!bc)
+        return QStringList();
+
+    ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(pro->projectDirectory(), bc->buildSystem(), pro->distribution());
+    const ROSUtils::PackageInfoMap packageInfo = pro->getPackageInfo();
+    foreach (const QString &dependency, pro->getPackageGraph().transitiveDependencies(packages))
+    {
+        Utils::FileName packageBuildPath;
+        ROSUtils::findPackageBuildDirectory(workspaceInfo, packageInfo.value(dependency), packageBuildPath);
+        if (!QFileInfo(QDir(packageBuildPath.toString()).absoluteFilePath(QLatin1String("CMakeCache.txt"))).exists())
+            return QStringList();
+    }
+
+    packages.sort();
+    return packages;
+}
+
 //
 // ROSCatkinToolsStepWidget
 //
@@ -305,6 +560,7 @@ ROSCatkinToolsStepWidget::ROSCatkinToolsStepWidget(ROSCatkinToolsStep *makeStep)
     m_ui->catkinMakeArgumentsLineEdit->setText(m_makeStep->m_catkinMakeArguments);
     m_ui->cmakeArgumentsLineEdit->setText(m_makeStep->m_cmakeArguments);
     m_ui->makeArgumentsLineEdit->setText(m_makeStep->m_makeArguments);
+    m_ui->affectedPackagesCheckBox->setChecked(m_makeStep->m_affectedPackagesOnly);
     setProfile(m_makeStep->m_activeProfile);
 
     m_addButtonMenu = new QMenu(this);
@@ -347,6 +603,12 @@ ROSCatkinToolsStepWidget::ROSCatkinToolsStepWidget(ROSCatkinToolsStep *makeStep)
     connect(m_ui->makeArgumentsLineEdit, &QLineEdit::textEdited,
             this, &ROSCatkinToolsStepWidget::updateDetails);
 
+    connect(m_ui->affectedPackagesCheckBox, &QCheckBox::toggled,
+            this, &ROSCatkinToolsStepWidget::updateDetails);
+
+    connect(m_ui->unityBuildExcludeLineEdit, &QLineEdit::editingFinished,
+            this, &ROSCatkinToolsStepWidget::unityBuildExcludeChanged);
+
     connect(m_makeStep, SIGNAL(enabledChanged()),
             this, SLOT(enabledChanged()));
 
@@ -357,6 +619,15 @@ ROSCatkinToolsStepWidget::ROSCatkinToolsStepWidget(ROSCatkinToolsStep *makeStep)
     connect(bc, &ROSBuildConfiguration::cmakeBuildTypeChanged,
             this, &ROSCatkinToolsStepWidget::updateDetails);
 
+    connect(bc, &ROSBuildConfiguration::buildGeneratorChanged,
+            this, &ROSCatkinToolsStepWidget::updateDetails);
+
+    connect(bc, &ROSBuildConfiguration::compilerLauncherChanged,
+            this, &ROSCatkinToolsStepWidget::updateDetails);
+
+    connect(bc, &ROSBuildConfiguration::unityBuildChanged,
+            this, &ROSCatkinToolsStepWidget::updateUnityBuildExclude);
+
     ROSProject *pro = static_cast<ROSProject *>(m_makeStep->target()->project());
     connect(pro, &ROSProject::environmentChanged,
             this, &ROSCatkinToolsStepWidget::updateDetails);
@@ -381,6 +652,7 @@ void ROSCatkinToolsStepWidget::updateDetails()
     m_makeStep->m_catkinMakeArguments = m_ui->catkinMakeArgumentsLineEdit->text();
     m_makeStep->m_cmakeArguments = m_ui->cmakeArgumentsLineEdit->text();
     m_makeStep->m_makeArguments = m_ui->makeArgumentsLineEdit->text();
+    m_makeStep->m_affectedPackagesOnly = m_ui->affectedPackagesCheckBox->isChecked();
 
     ROSBuildConfiguration *bc = m_makeStep->rosBuildConfiguration();
     ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(bc->project()->projectDirectory(), bc->buildSystem(), bc->project()->distribution());
@@ -391,7 +663,7 @@ void ROSCatkinToolsStepWidget::updateDetails()
     param.setWorkingDirectory(workspaceInfo.buildPath.toString());
     param.setEnvironment(env);
     param.setCommand(m_makeStep->makeCommand());
-    param.setArguments(m_makeStep->allArguments(bc->cmakeBuildType(), false));
+    param.setArguments(m_makeStep->allArguments(bc->cmakeBuildType(), bc->buildGenerator(), bc->compilerLauncher(), false));
     m_summaryText = param.summary(displayName());
     emit updateSummary();
 }
@@ -429,6 +701,24 @@ void ROSCatkinToolsStepWidget::setProfile(const QString profileName)
 {
     m_makeStep->setActiveProfile(profileName);
     m_ui->profilePushButton->setText(QString(" %1").arg(profileName));
+    updateUnityBuildExclude();
+}
+
+void ROSCatkinToolsStepWidget::unityBuildExcludeChanged()
+{
+    QStringList packages = m_ui->unityBuildExcludeLineEdit->text().split(QLatin1Char(' '), QString::SkipEmptyParts);
+    ROSBuildConfiguration *bc = m_makeStep->rosBuildConfiguration();
+    if (packages != ROSUtils::getCatkinToolsUnityBuildExclude(bc->project()->projectDirectory(), m_makeStep->activeProfile()))
+        ROSUtils::setCatkinToolsUnityBuildExclude(bc->project()->projectDirectory(), m_makeStep->activeProfile(), packages);
+}
+
+void ROSCatkinToolsStepWidget::updateUnityBuildExclude()
+{
+    // The exclude list belongs to the profile, so it is reloaded whenever the profile changes
+    ROSBuildConfiguration *bc = m_makeStep->rosBuildConfiguration();
+    QStringList packages = ROSUtils::getCatkinToolsUnityBuildExclude(bc->project()->projectDirectory(), m_makeStep->activeProfile());
+    m_ui->unityBuildExcludeLineEdit->setText(packages.join(QLatin1Char(' ')));
+    m_ui->unityBuildExcludeLineEdit->setEnabled(bc->unityBuild());
 }
 
 void ROSCatkinToolsStepWidget::cloneProfile(const QString profileName)
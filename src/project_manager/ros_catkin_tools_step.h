@@ -24,6 +24,10 @@
 #include <projectexplorer/abstractprocessstep.h>
 
 #include "ros_build_configuration.h"
+#include "ros_build_history.h"
+#include "ros_build_output_parser.h"
+#include "ros_build_profiler.h"
+#include "ros_compiler_cache_statistics.h"
 
 #include <QDialog>
 #include <QLineEdit>
@@ -38,6 +42,7 @@ namespace ROSProjectManager {
 namespace Internal {
 
 class ROSCatkinToolsStepWidget;
+class ROSDeferredStepFuture;
 class ROSCatkinToolsStepFactory;
 namespace Ui {class ROSCatkinToolsStep;
               class ROSCatkinToolsListEditor;
@@ -48,6 +53,7 @@ class ROSCatkinToolsStep : public ProjectExplorer::AbstractProcessStep
     Q_OBJECT
 
     friend class ROSCatkinToolsStepWidget;
+class ROSDeferredStepFuture;
     friend class ROSCatkinToolsStepFactory;
 
 public:
@@ -68,7 +74,13 @@ public:
     QString activeProfile() const;
     void setActiveProfile(const QString &profileName);
 
-    QString allArguments(ROSUtils::BuildType buildType, bool includeDefault = true) const;
+    bool affectedPackagesOnly() const;
+    void setAffectedPackagesOnly(const bool &affectedPackagesOnly);
+    /** @brief Changed packages and their dependents, empty if the whole workspace must be built */
+    QStringList affectedPackages() const;
+
+    QString allArguments(ROSUtils::BuildType buildType, ROSUtils::BuildGenerator buildGenerator,
+                         ROSUtils::CompilerLauncher compilerLauncher, bool includeDefault = true) const;
     QString makeCommand() const;
 
     QVariantMap toMap() const;
@@ -82,12 +94,24 @@ protected:
     bool fromMap(const QVariantMap &map) override;
 
     void stdOutput(const QString &line) override;
+    void stdError(const QString &line) override;
     void processStarted() override;
     void processFinished(int exitCode, QProcess::ExitStatus status) override;
 
+private slots:
+    void startBuild();
+    void finishRun(bool success);
+    void reportRunFinished(const QString &summary);
+
 private:
     void ctor();
     ROSBuildConfiguration *targetsActiveBuildConfiguration() const;
+    void startCompilerCacheStatistics();
+    void reportCompilerCacheStatistics();
+    void packageBuilt(const QString &package);
+    void updateEstimate(bool force = false);
+    QString unityBuildArguments() const;
+    QString precompiledHeaderArguments() const;
 
     BuildTargets m_target;
     QString m_activeProfile;
@@ -95,7 +119,24 @@ private:
     QString m_catkinMakeArguments;
     QString m_cmakeArguments;
     QString m_makeArguments;
-    QRegExp m_percentProgress;
+    bool m_affectedPackagesOnly = false;
+    QStringList m_builtChangedPaths; /**< @brief Changed paths when the build started */
+    ROSBuildOutputParser *m_outputParser = nullptr;
+    ROSBuildProfiler m_profiler;
+    ROSBuildHistory m_history;
+    QStringList m_profiledPackages;
+    qint64 m_lastEstimate = 0;
+    int m_completedJobs = 0; /**< @brief Jobs catkin reported as complete */
+    int m_totalJobs = 0;     /**< @brief Jobs catkin runs, 0 until it reported them */
+    Utils::FileName m_profilePath;
+    bool m_fullBuild = false;
+    bool m_unityBuild = false;
+    bool m_precompiledHeaders = false;
+    ROSDeferredStepFuture *m_deferredFuture = nullptr;
+    QFutureInterface<bool> *m_runFutureInterface = nullptr; /**< @brief Future of the running build step */
+    bool m_runSucceeded = false;
+    ROSUtils::CompilerLauncher m_compilerLauncher = ROSUtils::NoCompilerLauncher;
+    ROSCompilerCacheStatistics *m_compilerCacheStatistics = nullptr;
 };
 
 class ROSCatkinToolsStepWidget : public ProjectExplorer::BuildStepConfigWidget
@@ -128,6 +169,8 @@ private:
     void renameProfile(const QString profileName);
     void removeProfile(const QString profileName);
     void editProfile(const QString profileName);
+    void unityBuildExcludeChanged();
+    void updateUnityBuildExclude();
 
     QString uniqueName(const QString &name, const bool &isRename);
 };
@@ -0,0 +1,145 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_compiler_cache_statistics.h"
+
+#include <QDebug>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+ROSCompilerCacheStatistics::ROSCompilerCacheStatistics(QObject *parent) :
+    QObject(parent)
+{
+    m_timeout.setSingleShot(true);
+    m_timeout.setInterval(5000);
+    connect(&m_timeout, &QTimer::timeout, &m_process, &QProcess::kill);
+    connect(&m_process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, &ROSCompilerCacheStatistics::processFinished);
+    connect(&m_process, &QProcess::errorOccurred, this, [this](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart)
+            readFinished(false, ROSUtils::CompilerCacheStatistics());
+    });
+}
+
+void ROSCompilerCacheStatistics::start(ROSUtils::CompilerLauncher compilerLauncher, const QProcessEnvironment &env)
+{
+    // A previous read is outdated
+    m_timeout.stop();
+    if (m_process.state() != QProcess::NotRunning)
+    {
+        m_process.blockSignals(true);
+        m_process.kill();
+        m_process.waitForFinished(1000);
+        m_process.blockSignals(false);
+    }
+
+    m_state = Idle;
+    m_compilerLauncher = compilerLauncher;
+    if (ROSUtils::compilerLauncherName(compilerLauncher).isEmpty())
+    {
+        emit started();
+        return;
+    }
+
+    m_process.setProcessEnvironment(env);
+    m_state = ReadingBefore;
+    read(false);
+}
+
+void ROSCompilerCacheStatistics::finish()
+{
+    if (m_state != Building)
+    {
+        emit finished(QString());
+        return;
+    }
+
+    m_state = ReadingAfter;
+    read(false);
+}
+
+void ROSCompilerCacheStatistics::read(bool older)
+{
+    QStringList arguments;
+    if (older)
+        arguments << QLatin1String("-s");
+    else if (m_compilerLauncher == ROSUtils::CCache)
+        arguments << QLatin1String("--print-stats");
+    else
+        arguments << QLatin1String("--show-stats");
+
+    m_older = older;
+    m_process.start(ROSUtils::compilerLauncherName(m_compilerLauncher), arguments);
+    m_timeout.start();
+}
+
+void ROSCompilerCacheStatistics::processFinished(int exitCode, QProcess::ExitStatus status)
+{
+    m_timeout.stop();
+    if (status != QProcess::NormalExit)
+    {
+        readFinished(false, ROSUtils::CompilerCacheStatistics());
+        return;
+    }
+
+    // ccache before 3.7 only supports the human readable statistics
+    if (exitCode != 0 && !m_older && m_compilerLauncher == ROSUtils::CCache)
+    {
+        read(true);
+        return;
+    }
+
+    ROSUtils::CompilerCacheStatistics stats;
+    bool success = (exitCode == 0);
+    if (success)
+        ROSUtils::parseCompilerCacheStatistics(QString::fromLocal8Bit(m_process.readAllStandardOutput()), stats);
+
+    readFinished(success, stats);
+}
+
+void ROSCompilerCacheStatistics::readFinished(bool success, const ROSUtils::CompilerCacheStatistics &stats)
+{
+    State state = m_state;
+    if (!success)
+    {
+        qDebug() << "Failed to get compiler cache statistics from: " << ROSUtils::compilerLauncherName(m_compilerLauncher);
+        m_state = Idle;
+    }
+
+    // The build waits for these signals, so they are emitted even if reading failed
+    if (state == ReadingBefore)
+    {
+        if (success)
+        {
+            m_before = stats;
+            m_state = Building;
+        }
+        emit started();
+    }
+    else if (state == ReadingAfter)
+    {
+        m_state = Idle;
+        emit finished(success ? ROSUtils::compilerCacheSummary(m_compilerLauncher, m_before, stats) : QString());
+    }
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
@@ -0,0 +1,83 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_COMPILER_CACHE_STATISTICS_H
+#define ROS_COMPILER_CACHE_STATISTICS_H
+
+#include "ros_utils.h"
+
+#include <QObject>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QTimer>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Reads the compiler cache statistics before and after a build without blocking
+ *
+ * The statistics are read by running the compiler launcher (ex. ccache --print-stats). The build
+ * starts once the statistics before it were read, and the build step finishes once the summary
+ * of the hits and misses during the build was added to its output.
+ */
+class ROSCompilerCacheStatistics : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ROSCompilerCacheStatistics(QObject *parent = nullptr);
+
+    /**
+     * @brief Read the statistics before the build, started() is emitted once they were read
+     * @param compilerLauncher Compiler launcher (ccache, sccache)
+     * @param env Build environment, which selects the cache directory
+     */
+    void start(ROSUtils::CompilerLauncher compilerLauncher, const QProcessEnvironment &env);
+
+    /** @brief Read the statistics after the build, finished() is emitted once they were read */
+    void finish();
+
+signals:
+    /** @brief The statistics before the build were read or are not available, the build can start */
+    void started();
+
+    /** @brief The summary of the build, empty if the statistics are not available */
+    void finished(const QString &summary);
+
+private:
+    enum State { Idle, ReadingBefore, Building, ReadingAfter };
+
+    void read(bool older);
+    void processFinished(int exitCode, QProcess::ExitStatus status);
+    void readFinished(bool success, const ROSUtils::CompilerCacheStatistics &stats);
+
+    QProcess m_process;
+    QTimer m_timeout;
+    State m_state = Idle;
+    bool m_older = false;         /**< @brief Reading the human readable statistics of an older ccache */
+    ROSUtils::CompilerLauncher m_compilerLauncher = ROSUtils::NoCompilerLauncher;
+    ROSUtils::CompilerCacheStatistics m_before;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_COMPILER_CACHE_STATISTICS_H
@@ -0,0 +1,77 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_deferred_step_future.h"
+
+namespace ROSProjectManager {
+namespace Internal {
+
+ROSDeferredStepFuture::ROSDeferredStepFuture(QObject *parent) :
+    QObject(parent)
+{
+    connect(&m_watcher, &QFutureWatcher<bool>::progressRangeChanged, this, [this](int minimum, int maximum) {
+        if (m_future)
+            m_future->setProgressRange(minimum, maximum);
+    });
+    connect(&m_watcher, &QFutureWatcher<bool>::progressValueChanged, this, [this](int value) {
+        if (m_future)
+            m_future->setProgressValue(value);
+    });
+    connect(&m_watcher, &QFutureWatcher<bool>::progressTextChanged, this, [this](const QString &text) {
+        if (m_future)
+            m_future->setProgressValueAndText(m_future->progressValue(), text);
+    });
+    connect(&m_watcher, &QFutureWatcher<bool>::finished, this, [this]() {
+        m_cancelTimer.stop();
+
+        // A canceled future drops the result, which counts as a failure
+        QFuture<bool> future = m_watcher.future();
+        emit processFinished(future.resultCount() > 0 && future.resultAt(0));
+    });
+
+    // The build is canceled on its own future, AbstractProcessStep only polls the proxy
+    m_cancelTimer.setInterval(250);
+    connect(&m_cancelTimer, &QTimer::timeout, this, [this]() {
+        if (m_future && m_future->isCanceled())
+            m_proxy.cancel();
+    });
+}
+
+QFutureInterface<bool> &ROSDeferredStepFuture::start(QFutureInterface<bool> &fi)
+{
+    QFutureInterface<bool> proxy;
+    proxy.reportStarted();
+    m_watcher.setFuture(proxy.future());
+    m_proxy = proxy;
+    m_future = &fi;
+    m_cancelTimer.start();
+    return m_proxy;
+}
+
+QFutureInterface<bool> *ROSDeferredStepFuture::take()
+{
+    m_cancelTimer.stop();
+    QFutureInterface<bool> *fi = m_future;
+    m_future = nullptr;
+    return fi;
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
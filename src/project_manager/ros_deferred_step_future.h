@@ -0,0 +1,70 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_DEFERRED_STEP_FUTURE_H
+#define ROS_DEFERRED_STEP_FUTURE_H
+
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QObject>
+#include <QTimer>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Lets a process step keep working after its process exited
+ *
+ * AbstractProcessStep reports its result right after processFinished(). The step is run on a
+ * proxy future instead, its progress and the cancellation of the build are forwarded, and the
+ * build step reports the result on the build's future once its remaining work is done.
+ */
+class ROSDeferredStepFuture : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ROSDeferredStepFuture(QObject *parent = nullptr);
+
+    /**
+     * @brief Start forwarding to the build's future
+     * @param fi Future of the build step
+     * @return Proxy future to run the process step with
+     */
+    QFutureInterface<bool> &start(QFutureInterface<bool> &fi);
+
+    /** @brief Stop forwarding, returns the build's future to report the result on */
+    QFutureInterface<bool> *take();
+
+signals:
+    /** @brief The process step reported its result on the proxy future */
+    void processFinished(bool success);
+
+private:
+    QFutureInterface<bool> *m_future = nullptr;
+    QFutureInterface<bool> m_proxy;
+    QFutureWatcher<bool> m_watcher;
+    QTimer m_cancelTimer;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_DEFERRED_STEP_FUTURE_H
@@ -0,0 +1,432 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_exec_watcher.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QSocketNotifier>
+
+#include <cerrno>
+#include <dirent.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/** @brief Number of polls a new process is checked again, it may exec after being forked */
+const int ROS_EXEC_WATCHER_RECHECK_POLLS = 10;
+
+// The proc_event enum moved out of the struct in newer kernel headers, use the ABI values
+const unsigned int ROS_PROC_EVENT_EXEC = 0x00000002;
+const unsigned int ROS_PROC_EVENT_EXIT = 0x80000000;
+
+static qint64 clockMilliseconds(clockid_t clock)
+{
+    struct timespec ts;
+    if (clock_gettime(clock, &ts) != 0)
+        return -1;
+
+    return qint64(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000;
+}
+
+static QString processExecutable(qint64 pid)
+{
+    char path[64];
+    char target[4096];
+    snprintf(path, sizeof(path), "/proc/%lld/exe", static_cast<long long>(pid));
+    ssize_t len = readlink(path, target, sizeof(target) - 1);
+    if (len <= 0)
+        return QString();
+
+    QString exe = QString::fromLocal8Bit(target, int(len));
+    if (exe.endsWith(QLatin1String(" (deleted)")))
+        exe.chop(10);
+
+    return exe;
+}
+
+ROSExecWatcher::ROSExecWatcher(QObject *parent) :
+    QObject(parent)
+{
+    m_pollTimer.setInterval(PollInterval);
+    connect(&m_pollTimer, &QTimer::timeout, this, &ROSExecWatcher::pollProcesses);
+
+    m_timeoutTimer.setSingleShot(true);
+    connect(&m_timeoutTimer, &QTimer::timeout, this, [this]() {
+        stop();
+        emit timedOut();
+    });
+}
+
+ROSExecWatcher::~ROSExecWatcher()
+{
+    stop();
+}
+
+void ROSExecWatcher::setTargets(const QStringList &executables)
+{
+    m_targets.clear();
+    m_scriptTargets.clear();
+    foreach (const QString &executable, executables)
+    {
+        QFileInfo info(executable);
+        QString canonical = info.canonicalFilePath();
+        if (canonical.isEmpty())
+            canonical = info.absoluteFilePath();
+
+        m_targets.insert(canonical, executable);
+
+        // Scripts (ex. python nodes) show up as their interpreter
+        QFile file(canonical);
+        if (file.open(QIODevice::ReadOnly) && file.read(2) == "#!")
+            m_scriptTargets.insert(canonical);
+    }
+}
+
+QStringList ROSExecWatcher::targets() const
+{
+    return m_targets.values();
+}
+
+void ROSExecWatcher::setLaunchWrapper(const QString &wrapper)
+{
+    m_launchWrapper = wrapper.isEmpty() ? QString() : QFileInfo(wrapper).canonicalFilePath();
+}
+
+QString ROSExecWatcher::launchWrapper() const
+{
+    return m_launchWrapper;
+}
+
+bool ROSExecWatcher::isLaunchWrapper(qint64 pid) const
+{
+    if (m_launchWrapper.isEmpty())
+        return false;
+
+    QFile cmdline(QString("/proc/%1/cmdline").arg(pid));
+    if (!cmdline.open(QIODevice::ReadOnly))
+        return false;
+
+    const QList<QByteArray> args = cmdline.read(8192).split('\0');
+    return (args.size() > 1 && QFileInfo(QString::fromLocal8Bit(args.at(1))).canonicalFilePath() == m_launchWrapper);
+}
+
+ROSExecWatcher::Method ROSExecWatcher::start(int timeout)
+{
+    stop();
+    m_knownPids.clear();
+    m_recentPids.clear();
+    m_reportedPids.clear();
+
+    // Subscribe before scanning so a process started in between is not missed
+    if (startConnector())
+    {
+        m_method = ProcConnector;
+    }
+    else
+    {
+        m_method = ProcPolling;
+        m_pollTimer.start();
+    }
+
+    scanProcesses(true);
+
+    if (timeout > 0 && m_method != NotRunning)
+        m_timeoutTimer.start(timeout);
+
+    return m_method;
+}
+
+void ROSExecWatcher::stop()
+{
+    stopConnector();
+    m_pollTimer.stop();
+    m_timeoutTimer.stop();
+    m_method = NotRunning;
+}
+
+bool ROSExecWatcher::isActive() const
+{
+    return m_method != NotRunning;
+}
+
+ROSExecWatcher::Method ROSExecWatcher::method() const
+{
+    return m_method;
+}
+
+bool ROSExecWatcher::startConnector()
+{
+    m_socket = socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+    if (m_socket == -1)
+        return false;
+
+    struct sockaddr_nl address = {};
+    address.nl_family = AF_NETLINK;
+    address.nl_groups = CN_IDX_PROC;
+    address.nl_pid = 0;
+
+    // Joining the process connector group requires CAP_NET_ADMIN
+    if (bind(m_socket, reinterpret_cast<struct sockaddr *>(&address), sizeof(address)) == -1)
+    {
+        stopConnector();
+        return false;
+    }
+
+    char buffer[NLMSG_SPACE(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op))] = {};
+    struct nlmsghdr *header = reinterpret_cast<struct nlmsghdr *>(buffer);
+    header->nlmsg_len = NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op));
+    header->nlmsg_type = NLMSG_DONE;
+    header->nlmsg_pid = 0;
+
+    struct cn_msg *message = reinterpret_cast<struct cn_msg *>(NLMSG_DATA(header));
+    message->id.idx = CN_IDX_PROC;
+    message->id.val = CN_VAL_PROC;
+    message->len = sizeof(enum proc_cn_mcast_op);
+    *reinterpret_cast<enum proc_cn_mcast_op *>(message->data) = PROC_CN_MCAST_LISTEN;
+
+    if (send(m_socket, buffer, header->nlmsg_len, 0) == -1)
+    {
+        stopConnector();
+        return false;
+    }
+
+    m_notifier = new QSocketNotifier(m_socket, QSocketNotifier::Read, this);
+    connect(m_notifier, &QSocketNotifier::activated, this, &ROSExecWatcher::readConnector);
+    return true;
+}
+
+void ROSExecWatcher::stopConnector()
+{
+    // May be called from the notifier's own activated signal
+    if (m_notifier)
+    {
+        m_notifier->setEnabled(false);
+        m_notifier->deleteLater();
+        m_notifier = nullptr;
+    }
+
+    if (m_socket != -1)
+    {
+        close(m_socket);
+        m_socket = -1;
+    }
+}
+
+void ROSExecWatcher::readConnector()
+{
+    alignas(struct nlmsghdr) char buffer[8192];
+    while (m_socket != -1)
+    {
+        ssize_t len = recv(m_socket, buffer, sizeof(buffer), 0);
+        if (len == -1)
+        {
+            // Events were dropped, catch up by scanning /proc
+            if (errno == ENOBUFS)
+            {
+                scanProcesses(false);
+                continue;
+            }
+            return;
+        }
+
+        for (struct nlmsghdr *header = reinterpret_cast<struct nlmsghdr *>(buffer);
+             NLMSG_OK(header, len); header = NLMSG_NEXT(header, len))
+        {
+            if (header->nlmsg_type == NLMSG_ERROR || header->nlmsg_type == NLMSG_OVERRUN)
+                break;
+
+            struct cn_msg *message = reinterpret_cast<struct cn_msg *>(NLMSG_DATA(header));
+            if (message->id.idx != CN_IDX_PROC || message->id.val != CN_VAL_PROC)
+                continue;
+
+            struct proc_event *event = reinterpret_cast<struct proc_event *>(message->data);
+            if (static_cast<unsigned int>(event->what) == ROS_PROC_EVENT_EXEC)
+            {
+                // The event timestamp uses the monotonic clock
+                qint64 latency = clockMilliseconds(CLOCK_MONOTONIC) - qint64(event->timestamp_ns / 1000000);
+                checkProcess(event->event_data.exec.process_tgid, latency);
+            }
+            else if (static_cast<unsigned int>(event->what) == ROS_PROC_EVENT_EXIT)
+            {
+                m_reportedPids.remove(event->event_data.exit.process_tgid);
+            }
+        }
+    }
+}
+
+void ROSExecWatcher::pollProcesses()
+{
+    scanProcesses(false);
+}
+
+void ROSExecWatcher::scanProcesses(bool initial)
+{
+    DIR *proc = opendir("/proc");
+    if (!proc)
+        return;
+
+    QSet<qint64> current;
+    current.reserve(m_knownPids.size() + 64);
+    while (struct dirent *entry = readdir(proc))
+    {
+        const char *name = entry->d_name;
+        if (name[0] < '1' || name[0] > '9')
+            continue;
+
+        qint64 pid = strtoll(name, nullptr, 10);
+        current.insert(pid);
+
+        if (!m_knownPids.contains(pid))
+        {
+            if (!initial)
+                m_recentPids.insert(pid, ROS_EXEC_WATCHER_RECHECK_POLLS);
+
+            checkProcess(pid, -1);
+        }
+        else
+        {
+            // The iterator is not used across checkProcess, whose listeners may change the watcher
+            auto it = m_recentPids.find(pid);
+            if (it != m_recentPids.end())
+            {
+                if (--it.value() <= 0)
+                    m_recentPids.erase(it);
+
+                checkProcess(pid, -1);
+            }
+        }
+    }
+    closedir(proc);
+
+    // Forget processes which exited so a reused pid is checked again
+    for (auto it = m_recentPids.begin(); it != m_recentPids.end();)
+        it = current.contains(it.key()) ? it + 1 : m_recentPids.erase(it);
+
+    m_reportedPids.intersect(current);
+    m_knownPids.swap(current);
+}
+
+void ROSExecWatcher::checkProcess(qint64 pid, qint64 latency)
+{
+    if (m_method == NotRunning || m_reportedPids.contains(pid))
+        return;
+
+    const QString target = matchTarget(pid);
+    if (target.isEmpty())
+        return;
+
+    m_reportedPids.insert(pid);
+    if (latency < 0)
+        latency = processLatency(pid);
+
+    emit processStarted(pid, m_targets.value(target), latency);
+}
+
+QString ROSExecWatcher::matchTarget(qint64 pid) const
+{
+    const QString exe = processExecutable(pid);
+    if (exe.isEmpty())
+        return QString();
+
+    if (m_targets.contains(exe))
+        return exe;
+
+    if (m_scriptTargets.isEmpty() && m_launchWrapper.isEmpty())
+        return QString();
+
+    QFile cmdline(QString("/proc/%1/cmdline").arg(pid));
+    if (!cmdline.open(QIODevice::ReadOnly))
+        return QString();
+
+    const QList<QByteArray> args = cmdline.read(8192).split('\0');
+    auto canonicalArgument = [&args](int i) {
+        if (i >= args.size())
+            return QString();
+
+        QFileInfo info(QString::fromLocal8Bit(args.at(i)));
+        return info.isAbsolute() ? info.canonicalFilePath() : QString();
+    };
+
+    // The launch prefix script is run by the shell (ex. /bin/sh wrapper.sh /path/node)
+    if (!m_launchWrapper.isEmpty() && canonicalArgument(1) == m_launchWrapper)
+    {
+        const QString target = canonicalArgument(2);
+        return m_targets.contains(target) ? target : QString();
+    }
+
+    // Interpreted nodes: the script is the first or second argument (ex. python /path/node.py)
+    for (int i = 0; i < 2; ++i)
+    {
+        const QString canonical = canonicalArgument(i);
+        if (!canonical.isEmpty() && m_scriptTargets.contains(canonical))
+            return canonical;
+    }
+
+    return QString();
+}
+
+bool ROSExecWatcher::isProcessStopped(qint64 pid)
+{
+    // The state follows the command name in /proc/<pid>/stat
+    QFile stat(QString("/proc/%1/stat").arg(pid));
+    if (!stat.open(QIODevice::ReadOnly))
+        return false;
+
+    const QByteArray data = stat.readAll();
+    const int commEnd = data.lastIndexOf(')');
+    return (commEnd != -1 && commEnd + 2 < data.size() && data.at(commEnd + 2) == 'T');
+}
+
+qint64 ROSExecWatcher::processLatency(qint64 pid)
+{
+    // Field 22 of /proc/<pid>/stat is the start time in clock ticks since boot
+    QFile stat(QString("/proc/%1/stat").arg(pid));
+    if (!stat.open(QIODevice::ReadOnly))
+        return -1;
+
+    const QByteArray data = stat.readAll();
+    const int commEnd = data.lastIndexOf(')');
+    if (commEnd == -1)
+        return -1;
+
+    const QList<QByteArray> fields = data.mid(commEnd + 2).split(' ');
+    if (fields.size() < 20)
+        return -1;
+
+    bool ok = false;
+    const qint64 ticks = fields.at(19).toLongLong(&ok);
+    const long ticksPerSecond = sysconf(_SC_CLK_TCK);
+    if (!ok || ticksPerSecond <= 0)
+        return -1;
+
+    const qint64 now = clockMilliseconds(CLOCK_BOOTTIME);
+    return (now < 0) ? -1 : qMax(Q_INT64_C(0), now - (ticks * 1000) / ticksPerSecond);
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
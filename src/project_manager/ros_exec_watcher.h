@@ -0,0 +1,128 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_EXEC_WATCHER_H
+#define ROS_EXEC_WATCHER_H
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+QT_BEGIN_NAMESPACE
+class QSocketNotifier;
+QT_END_NAMESPACE
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Reports processes executing one of a set of executables
+ *
+ * Exec events are received from the kernel's netlink process connector as they happen. The
+ * connector requires CAP_NET_ADMIN, without it the new processes in /proc are checked at a
+ * fixed interval instead. Processes which are already running when the watcher starts are reported too.
+ */
+class ROSExecWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Method {
+        NotRunning = 0,
+        ProcConnector = 1, /**< @brief Netlink process connector exec events */
+        ProcPolling = 2    /**< @brief Periodic scan for new processes in /proc */
+    };
+
+    explicit ROSExecWatcher(QObject *parent = nullptr);
+    ~ROSExecWatcher();
+
+    /** @brief Executables to watch for, scripts are matched against the interpreter's arguments */
+    void setTargets(const QStringList &executables);
+    QStringList targets() const;
+
+    /**
+     * @brief Launch prefix script which runs the targets, a process running the script with
+     * a target as its first argument is reported as that target before the target is executed.
+     */
+    void setLaunchWrapper(const QString &wrapper);
+    QString launchWrapper() const;
+
+    /** @brief Check if a process is running the launch prefix script, it has not executed the target yet */
+    bool isLaunchWrapper(qint64 pid) const;
+
+    /**
+     * @brief Start watching
+     * @param timeout Milliseconds after which watching stops, 0 to watch until stopped
+     * @return The method used to watch for new processes
+     */
+    Method start(int timeout = 30000);
+    void stop();
+    bool isActive() const;
+    Method method() const;
+
+    /** @brief Check if a process is stopped by a signal (ex. SIGSTOP) */
+    static bool isProcessStopped(qint64 pid);
+
+    /** @brief Interval at which /proc is scanned if the process connector is not available */
+    static const int PollInterval = 100;
+
+signals:
+    /**
+     * @brief A watched executable was started
+     * @param pid Process id
+     * @param executable The watched executable
+     * @param latency Milliseconds between the exec and it being reported, -1 if unknown
+     */
+    void processStarted(qint64 pid, const QString &executable, qint64 latency);
+
+    /** @brief The timeout elapsed */
+    void timedOut();
+
+private slots:
+    void readConnector();
+    void pollProcesses();
+
+private:
+    bool startConnector();
+    void stopConnector();
+    void scanProcesses(bool initial);
+    void checkProcess(qint64 pid, qint64 latency);
+    QString matchTarget(qint64 pid) const;
+    static qint64 processLatency(qint64 pid);
+
+    QHash<QString, QString> m_targets; /**< @brief Canonical path to the path as given */
+    QSet<QString> m_scriptTargets;     /**< @brief Canonical paths of targets run by an interpreter */
+    QString m_launchWrapper;           /**< @brief Canonical path of the launch prefix script */
+    Method m_method = NotRunning;
+    int m_socket = -1;
+    QSocketNotifier *m_notifier = nullptr;
+    QTimer m_pollTimer;
+    QTimer m_timeoutTimer;
+    QHash<qint64, int> m_recentPids;   /**< @brief Pids which are checked again, they may still exec */
+    QSet<qint64> m_knownPids;
+    QSet<qint64> m_reportedPids;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_EXEC_WATCHER_H
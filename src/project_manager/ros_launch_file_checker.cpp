@@ -0,0 +1,307 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_launch_file_checker.h"
+#include "ros_launch_parser.h"
+#include "ros_project_constants.h"
+#include "ros_utils.h"
+
+#include <projectexplorer/task.h>
+#include <projectexplorer/taskhub.h>
+#include <utils/fileutils.h>
+#include <utils/runextensions.h>
+
+#include <QCryptographicHash>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QSet>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+static QByteArray fileHash(const QString &file)
+{
+    QFile f(file);
+    if (!f.open(QIODevice::ReadOnly))
+        return QByteArray();
+
+    return QCryptographicHash::hash(f.readAll(), QCryptographicHash::Md5);
+}
+
+/** @brief Package paths and executables, looked up once per check */
+class ROSLaunchPackageLookup
+{
+public:
+    explicit ROSLaunchPackageLookup(const QStringList &env) :
+        m_env(env),
+        m_packagePaths(ROSLaunchParser::findPackages(env))
+    {
+    }
+
+    const QMap<QString, QString> &packagePaths() const { return m_packagePaths; }
+
+    /** @brief Changes if the package moved or its executables changed */
+    QString signature(const QString &package)
+    {
+        auto it = m_packagePaths.constFind(package);
+        if (it == m_packagePaths.constEnd())
+            return QString();
+
+        return it.value() + QLatin1Char('\n') + QStringList(executables(package).keys()).join(QLatin1Char(' '));
+    }
+
+    /**
+     * @brief Check if a package provides an executable
+     * @param sourceLookup Set to true if the package directory was searched, which the signature does not cover
+     */
+    bool hasExecutable(const QString &package, const QString &type, bool &sourceLookup)
+    {
+        sourceLookup = false;
+        if (executables(package).contains(type))
+            return true;
+
+        // Like roslaunch, fall back to the package directory (ex. python scripts which are not installed)
+        sourceLookup = true;
+        QDirIterator it(m_packagePaths.value(package), QStringList() << type, QDir::Files | QDir::Executable, QDirIterator::Subdirectories);
+        return it.hasNext();
+    }
+
+private:
+    const QMap<QString, QString> &executables(const QString &package)
+    {
+        auto it = m_executables.find(package);
+        if (it == m_executables.end())
+            it = m_executables.insert(package, ROSUtils::getROSPackageExecutables(package, m_env));
+
+        return it.value();
+    }
+
+    QStringList m_env;
+    QMap<QString, QString> m_packagePaths;
+    QHash<QString, QMap<QString, QString> > m_executables;
+};
+
+ROSLaunchFileChecker::ROSLaunchFileChecker(QObject *parent) :
+    QObject(parent)
+{
+    // Wait for a pause in the saves
+    m_delayTimer.setSingleShot(true);
+    m_delayTimer.setInterval(500);
+    connect(&m_delayTimer, &QTimer::timeout, this, &ROSLaunchFileChecker::startCheck);
+
+    connect(&m_futureWatcher, &QFutureWatcher<CheckInfo>::finished,
+            this, &ROSLaunchFileChecker::checkFinished);
+}
+
+ROSLaunchFileChecker::~ROSLaunchFileChecker()
+{
+    m_futureWatcher.cancel();
+    m_futureWatcher.waitForFinished();
+    clear();
+}
+
+void ROSLaunchFileChecker::check(const QStringList &launchFiles, const QStringList &env)
+{
+    // The arguments and packages resolved by the previous checks depend on the environment
+    if (env != m_env)
+        m_entries.clear();
+
+    m_launchFiles = launchFiles;
+    m_env = env;
+    m_delayTimer.start();
+}
+
+void ROSLaunchFileChecker::clear()
+{
+    ProjectExplorer::TaskHub::clearTasks(Constants::ROS_TASK_CATEGORY_LAUNCH);
+}
+
+void ROSLaunchFileChecker::startCheck()
+{
+    // Check again once the running check finished, it uses the entries of the running check
+    if (m_futureWatcher.isRunning())
+    {
+        m_pending = true;
+        return;
+    }
+
+    m_pending = false;
+
+    CheckInfo info;
+    info.launchFiles = m_launchFiles;
+    info.env = m_env;
+    info.entries = m_entries;
+
+    m_futureWatcher.setFuture(Utils::runAsync(&ROSLaunchFileChecker::checkAsync, info));
+}
+
+void ROSLaunchFileChecker::checkFinished()
+{
+    if (!m_futureWatcher.isCanceled() && m_futureWatcher.future().resultCount() > 0)
+    {
+        CheckInfo info = m_futureWatcher.result();
+        if (info.env == m_env)
+            m_entries = info.entries;
+
+        clear();
+        foreach (const Issue &issue, info.issues)
+        {
+            ProjectExplorer::TaskHub::addTask(ProjectExplorer::Task(ProjectExplorer::Task::Error,
+                                                                    issue.message,
+                                                                    Utils::FileName::fromString(issue.file),
+                                                                    issue.line,
+                                                                    Constants::ROS_TASK_CATEGORY_LAUNCH));
+        }
+    }
+
+    if (m_pending)
+        startCheck();
+}
+
+void ROSLaunchFileChecker::checkAsync(QFutureInterface<CheckInfo> &fi, CheckInfo info)
+{
+    ROSLaunchPackageLookup lookup(info.env);
+    ROSLaunchParser parser(lookup.packagePaths(), info.env);
+    const QRegularExpression errorFormat(QLatin1String("^(.*):(\\d+): (.*)$"));
+
+    QHash<QString, Entry> entries;
+    foreach (const QString &launchFile, info.launchFiles)
+    {
+        if (fi.isCanceled())
+            return;
+
+        // Reuse the previous result if none of its files or packages changed
+        auto previous = info.entries.constFind(launchFile);
+        if (previous != info.entries.constEnd())
+        {
+            bool valid = previous.value().cacheable && !previous.value().fileHashes.isEmpty();
+            for (auto it = previous.value().fileHashes.constBegin(); valid && it != previous.value().fileHashes.constEnd(); ++it)
+                valid = (fileHash(it.key()) == it.value());
+
+            for (auto it = previous.value().packages.constBegin(); valid && it != previous.value().packages.constEnd(); ++it)
+                valid = (lookup.signature(it.key()) == it.value());
+
+            if (valid)
+            {
+                entries.insert(launchFile, previous.value());
+                continue;
+            }
+        }
+
+        const ROSLaunchParser::LaunchFile launch = parser.parse(launchFile);
+        ++info.checkedCount;
+
+        Entry entry;
+        foreach (const QString &file, launch.files)
+        {
+            entry.fileHashes.insert(file, fileHash(file));
+            if (file != launch.file)
+                entry.includes.append(file);
+        }
+
+        foreach (const QString &package, launch.packages)
+            entry.packages.insert(package, lookup.signature(package));
+
+        foreach (const QString &error, launch.errors)
+        {
+            Issue issue;
+            QRegularExpressionMatch match = errorFormat.match(error);
+            if (match.hasMatch())
+            {
+                issue.file = match.captured(1);
+                issue.line = match.captured(2).toInt();
+                issue.message = match.captured(3);
+            }
+            else
+            {
+                issue.file = launch.file;
+                issue.message = error;
+            }
+            entry.issues.append(issue);
+        }
+
+        QHash<QString, Issue> names; /**< @brief Node name to where it was declared */
+        foreach (const ROSLaunchParser::Node &node, launch.nodes)
+        {
+            Issue issue;
+            issue.file = node.file;
+            issue.line = node.line;
+
+            // A missing pkg or type was already reported by the parser
+            if (!node.package.isEmpty() && !node.type.isEmpty())
+            {
+                entry.packages.insert(node.package, lookup.signature(node.package));
+                bool sourceLookup = false;
+                if (!lookup.packagePaths().contains(node.package))
+                {
+                    issue.message = tr("Package %1 of node %2 not found").arg(node.package, node.fullName());
+                    entry.issues.append(issue);
+                }
+                else if (!lookup.hasExecutable(node.package, node.type, sourceLookup))
+                {
+                    issue.message = tr("Executable %1 of node %2 not found in package %3, is it built?").arg(node.type, node.fullName(), node.package);
+                    entry.issues.append(issue);
+                }
+
+                // Files in the package directory may change without changing the signature
+                if (sourceLookup)
+                    entry.cacheable = false;
+            }
+
+            // Tests are only started by rostest, one at a time, and nodes under a python
+            // condition may be alternatives of each other
+            if (node.test || node.uncertain)
+                continue;
+
+            auto other = names.constFind(node.fullName());
+            if (other != names.constEnd())
+            {
+                issue.message = tr("Duplicate node name %1, also declared at %2:%3").arg(node.fullName(), other.value().file).arg(other.value().line);
+                entry.issues.append(issue);
+            }
+            else
+            {
+                names.insert(node.fullName(), issue);
+            }
+        }
+
+        entries.insert(launchFile, entry);
+    }
+
+    // Included launch files are checked with the arguments of the including launch file
+    QSet<QString> included;
+    foreach (const Entry &entry, entries)
+        included.unite(entry.includes.toSet());
+
+    info.issues.clear();
+    for (auto it = entries.constBegin(); it != entries.constEnd(); ++it)
+    {
+        if (!included.contains(QFileInfo(it.key()).canonicalFilePath()))
+            info.issues.append(it.value().issues);
+    }
+
+    info.entries = entries;
+    fi.reportResult(info);
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
@@ -0,0 +1,108 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_LAUNCH_FILE_CHECKER_H
+#define ROS_LAUNCH_FILE_CHECKER_H
+
+#include <QByteArray>
+#include <QFutureInterface>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Checks the workspace launch files in the background and reports the problems as tasks
+ *
+ * Every node is checked against the package executables, every $(find) against the packages on the
+ * ROS_PACKAGE_PATH, and unresolved arguments and duplicate node names are reported. A launch file is
+ * only checked again if one of the files it reads or one of the packages it references changed.
+ * Launch files included by another workspace launch file are only reported as part of the including file.
+ */
+class ROSLaunchFileChecker : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Issue
+    {
+        QString file;
+        int line = -1;
+        QString message;
+    };
+
+    explicit ROSLaunchFileChecker(QObject *parent = nullptr);
+    ~ROSLaunchFileChecker();
+
+    /**
+     * @brief Schedule a check, checks requested in quick succession are combined
+     * @param launchFiles Workspace launch files
+     * @param env ROS Workspace Environment
+     */
+    void check(const QStringList &launchFiles, const QStringList &env);
+
+    /** @brief Remove the reported tasks */
+    void clear();
+
+private:
+    struct Entry
+    {
+        QHash<QString, QByteArray> fileHashes; /**< @brief Files read while parsing to their content hash */
+        QHash<QString, QString> packages;      /**< @brief Referenced packages to their signature */
+        QStringList includes;
+        QList<Issue> issues;
+        bool cacheable = true; /**< @brief False if the result depends on files the hashes and signatures do not cover */
+    };
+
+    struct CheckInfo
+    {
+        // Inputs
+        QStringList launchFiles;
+        QStringList env;
+
+        // Inputs and outputs
+        QHash<QString, Entry> entries;
+
+        // Outputs
+        QList<Issue> issues;
+        int checkedCount = 0;
+    };
+
+    void startCheck();
+    void checkFinished();
+    static void checkAsync(QFutureInterface<CheckInfo> &fi, CheckInfo info);
+
+    QTimer m_delayTimer;
+    QFutureWatcher<CheckInfo> m_futureWatcher;
+    QStringList m_launchFiles;
+    QStringList m_env;
+    QHash<QString, Entry> m_entries;
+    bool m_pending = false;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_LAUNCH_FILE_CHECKER_H
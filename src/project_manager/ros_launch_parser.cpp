@@ -0,0 +1,714 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_launch_parser.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QXmlStreamReader>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/** @brief Maximum include depth, protects against recursive includes */
+const int ROS_LAUNCH_PARSER_MAX_DEPTH = 32;
+
+/** @brief Maximum number of cached models, each launch file and argument combination is an entry */
+const int ROS_LAUNCH_PARSER_MAX_CACHE_SIZE = 64;
+
+struct ROSLaunchCacheEntry
+{
+    QHash<QString, QByteArray> fileHashes;
+    QHash<QString, QString> environment;
+    ROSLaunchParser::LaunchFile result;
+};
+
+typedef QHash<QString, ROSLaunchCacheEntry> ROSLaunchCache;
+Q_GLOBAL_STATIC(ROSLaunchCache, rosLaunchCache)
+Q_GLOBAL_STATIC(QMutex, rosLaunchCacheMutex)
+
+static QByteArray contentHash(const QByteArray &content)
+{
+    return QCryptographicHash::hash(content, QCryptographicHash::Md5);
+}
+
+static QByteArray fileHash(const QString &file)
+{
+    QFile f(file);
+    if (!f.open(QIODevice::ReadOnly))
+        return QByteArray();
+
+    return contentHash(f.readAll());
+}
+
+static bool isTrue(const QString &value)
+{
+    // roslaunch compares lower case values
+    const QString lower = value.toLower();
+    return lower == QLatin1String("true") || lower == QLatin1String("1");
+}
+
+static bool isFalse(const QString &value)
+{
+    const QString lower = value.toLower();
+    return lower == QLatin1String("false") || lower == QLatin1String("0");
+}
+
+static bool isEval(const QString &value)
+{
+    // $(eval) contains a python expression and must be the whole attribute value
+    return value.startsWith(QLatin1String("$(eval ")) && value.endsWith(QLatin1Char(')'));
+}
+
+ROSLaunchParser::ROSLaunchParser(const QMap<QString, QString> &packagePaths, const QStringList &env) :
+    m_packagePaths(packagePaths)
+{
+    foreach (const QString &variable, env)
+    {
+        int separator = variable.indexOf(QLatin1Char('='));
+        if (separator > 0)
+            m_environment.insert(variable.left(separator), variable.mid(separator + 1));
+    }
+}
+
+void ROSLaunchParser::setArguments(const QMap<QString, QString> &arguments)
+{
+    m_arguments = arguments;
+}
+
+ROSLaunchParser::LaunchFile ROSLaunchParser::parse(const QString &file) const
+{
+    const QString canonical = QFileInfo(file).canonicalFilePath();
+    const QString key = cacheKey(canonical.isEmpty() ? file : canonical);
+
+    ROSLaunchCacheEntry entry;
+    bool cached = false;
+    {
+        QMutexLocker lock(rosLaunchCacheMutex());
+        auto it = rosLaunchCache()->constFind(key);
+        if (it != rosLaunchCache()->constEnd())
+        {
+            entry = it.value();
+            cached = true;
+        }
+    }
+
+    // Reuse the cached model if none of the files or environment variables it was built from changed
+    if (cached)
+    {
+        bool valid = !entry.fileHashes.isEmpty();
+        for (auto it = entry.fileHashes.constBegin(); valid && it != entry.fileHashes.constEnd(); ++it)
+            valid = (fileHash(it.key()) == it.value());
+
+        for (auto it = entry.environment.constBegin(); valid && it != entry.environment.constEnd(); ++it)
+            valid = (m_environment.value(it.key()) == it.value());
+
+        if (valid)
+            return entry.result;
+    }
+
+    LaunchFile result;
+    result.file = canonical.isEmpty() ? file : canonical;
+
+    Context context;
+    context.result = &result;
+
+    Scope scope;
+    scope.file = result.file;
+    scope.args = m_arguments;
+    parseFile(result.file, scope, context);
+
+    entry.fileHashes = context.fileHashes;
+    entry.environment = context.environment;
+    entry.result = result;
+    {
+        QMutexLocker lock(rosLaunchCacheMutex());
+        ROSLaunchCache *cache = rosLaunchCache();
+        if (!cache->contains(key) && cache->size() >= ROS_LAUNCH_PARSER_MAX_CACHE_SIZE)
+            cache->erase(cache->begin());
+
+        cache->insert(key, entry);
+    }
+
+    return result;
+}
+
+QMap<QString, QString> ROSLaunchParser::findPackages(const QStringList &env)
+{
+    QStringList packagePaths;
+    foreach (const QString &variable, env)
+    {
+        if (variable.startsWith(QLatin1String("ROS_PACKAGE_PATH=")))
+        {
+            packagePaths = variable.mid(17).split(QLatin1Char(':'), QString::SkipEmptyParts);
+            break;
+        }
+    }
+
+    // Search each path for package.xml files without descending into packages, like rospack
+    QMap<QString, QString> packages;
+    foreach (const QString &packagePath, packagePaths)
+    {
+        QStringList directories;
+        directories << packagePath;
+        for (int i = 0; i < directories.size(); ++i)
+        {
+            const QDir dir(directories.at(i));
+            if (dir.exists(QLatin1String("CATKIN_IGNORE")))
+                continue;
+
+            if (dir.exists(QLatin1String("package.xml")))
+            {
+                QString name = dir.dirName();
+                QFile packageXml(dir.filePath(QLatin1String("package.xml")));
+                if (packageXml.open(QIODevice::ReadOnly))
+                {
+                    QXmlStreamReader xml(&packageXml);
+                    while (!xml.atEnd())
+                    {
+                        if (xml.readNext() == QXmlStreamReader::StartElement && xml.name() == QLatin1String("name"))
+                        {
+                            name = xml.readElementText().trimmed();
+                            break;
+                        }
+                    }
+                }
+
+                // The first package on the path takes precedence
+                if (!packages.contains(name))
+                    packages.insert(name, dir.absolutePath());
+
+                continue;
+            }
+
+            foreach (const QString &subdirectory, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot))
+                directories << dir.filePath(subdirectory);
+        }
+    }
+
+    return packages;
+}
+
+QMap<QString, QString> ROSLaunchParser::parseArguments(const QString &arguments)
+{
+    QMap<QString, QString> result;
+    foreach (const QString &argument, arguments.split(QLatin1Char(' '), QString::SkipEmptyParts))
+    {
+        int separator = argument.indexOf(QLatin1String(":="));
+        if (separator > 0)
+            result.insert(argument.left(separator), argument.mid(separator + 2));
+    }
+    return result;
+}
+
+void ROSLaunchParser::clearCache()
+{
+    QMutexLocker lock(rosLaunchCacheMutex());
+    rosLaunchCache()->clear();
+}
+
+void ROSLaunchParser::parseFile(const QString &file, Scope scope, Context &context) const
+{
+    if (context.depth > ROS_LAUNCH_PARSER_MAX_DEPTH)
+    {
+        addError(context, scope, 0, QString("Maximum include depth exceeded including %1").arg(file));
+        return;
+    }
+
+    QFile launchFile(file);
+    if (!launchFile.open(QIODevice::ReadOnly))
+    {
+        // Recorded with an empty hash so the cached model is invalidated once the file exists
+        context.fileHashes.insert(QFileInfo(file).absoluteFilePath(), QByteArray());
+        addError(context, scope, 0, QString("Failed to open launch file %1").arg(file));
+        return;
+    }
+
+    const QByteArray content = launchFile.readAll();
+    const QString canonical = QFileInfo(file).canonicalFilePath();
+    context.fileHashes.insert(canonical, contentHash(content));
+    if (!context.result->files.contains(canonical))
+        context.result->files.append(canonical);
+
+    scope.file = canonical;
+
+    QXmlStreamReader xml(content);
+    while (xml.readNextStartElement())
+    {
+        if (xml.name() == QLatin1String("launch"))
+        {
+            parseChildren(xml, scope, context);
+        }
+        else
+        {
+            addError(context, scope, xml.lineNumber(), QString("Root element must be launch, not %1").arg(xml.name().toString()));
+            xml.skipCurrentElement();
+        }
+    }
+
+    if (xml.hasError())
+        addError(context, scope, xml.lineNumber(), xml.errorString());
+}
+
+void ROSLaunchParser::parseChildren(QXmlStreamReader &xml, Scope &scope, Context &context) const
+{
+    while (xml.readNextStartElement())
+    {
+        const int line = xml.lineNumber();
+        bool uncertain = false;
+        if (!isEnabled(xml.attributes(), scope, context, line, &uncertain))
+        {
+            xml.skipCurrentElement();
+            continue;
+        }
+
+        // The nodes of an element with a python condition may not be started
+        const bool scopeUncertain = scope.uncertain;
+        scope.uncertain = scopeUncertain || uncertain;
+
+        const QStringRef name = xml.name();
+        if (name == QLatin1String("group"))
+        {
+            Scope group = scope;
+            const QString ns = attribute(xml.attributes(), QLatin1String("ns"), scope, context, line);
+            if (!ns.isEmpty())
+                group.ns = resolveName(scope.ns, ns) + QLatin1Char('/');
+
+            parseChildren(xml, group, context);
+
+            // Arguments are scoped to the file, remaps to the group
+            scope.args = group.args;
+        }
+        else if (name == QLatin1String("arg"))
+        {
+            parseArg(xml, scope, context);
+        }
+        else if (name == QLatin1String("include"))
+        {
+            parseInclude(xml, scope, context);
+        }
+        else if (name == QLatin1String("node") || name == QLatin1String("test"))
+        {
+            parseNode(xml, scope, context, name == QLatin1String("test"));
+        }
+        else if (name == QLatin1String("param"))
+        {
+            parseParam(xml, scope, QString(), context);
+        }
+        else if (name == QLatin1String("rosparam"))
+        {
+            parseRosParam(xml, scope, QString(), context);
+        }
+        else if (name == QLatin1String("remap"))
+        {
+            parseRemap(xml, scope, scope.remaps, context);
+        }
+        else
+        {
+            // machine, env and unknown tags do not contribute to the model
+            xml.skipCurrentElement();
+        }
+
+        scope.uncertain = scopeUncertain;
+    }
+}
+
+void ROSLaunchParser::parseArg(QXmlStreamReader &xml, Scope &scope, Context &context) const
+{
+    const int line = xml.lineNumber();
+    const QXmlStreamAttributes attributes = xml.attributes();
+    const QString name = attribute(attributes, QLatin1String("name"), scope, context, line);
+    if (name.isEmpty())
+    {
+        addError(context, scope, line, QLatin1String("arg tag requires a name"));
+    }
+    else if (attributes.hasAttribute(QLatin1String("value")))
+    {
+        scope.args.insert(name, attribute(attributes, QLatin1String("value"), scope, context, line));
+    }
+    else if (attributes.hasAttribute(QLatin1String("default")))
+    {
+        if (!scope.args.contains(name))
+            scope.args.insert(name, attribute(attributes, QLatin1String("default"), scope, context, line));
+    }
+    else if (!scope.args.contains(name))
+    {
+        addError(context, scope, line, QString("Required argument %1 is not set").arg(name));
+    }
+
+    xml.skipCurrentElement();
+}
+
+void ROSLaunchParser::parseInclude(QXmlStreamReader &xml, const Scope &scope, Context &context) const
+{
+    const int line = xml.lineNumber();
+    const QXmlStreamAttributes attributes = xml.attributes();
+    const QString file = attribute(attributes, QLatin1String("file"), scope, context, line);
+
+    Scope include;
+    include.file = scope.file;
+    include.ns = scope.ns;
+    include.remaps = scope.remaps;
+    include.uncertain = scope.uncertain;
+
+    const QString ns = attribute(attributes, QLatin1String("ns"), scope, context, line);
+    if (!ns.isEmpty())
+        include.ns = resolveName(scope.ns, ns) + QLatin1Char('/');
+
+    if (isTrue(attribute(attributes, QLatin1String("pass_all_args"), scope, context, line)))
+        include.args = scope.args;
+
+    // Arguments passed to the included file are evaluated in this file's scope
+    while (xml.readNextStartElement())
+    {
+        const int argLine = xml.lineNumber();
+        const QXmlStreamAttributes argAttributes = xml.attributes();
+        if (xml.name() == QLatin1String("arg") && isEnabled(argAttributes, scope, context, argLine))
+        {
+            const QString name = attribute(argAttributes, QLatin1String("name"), scope, context, argLine);
+            if (argAttributes.hasAttribute(QLatin1String("value")))
+                include.args.insert(name, attribute(argAttributes, QLatin1String("value"), scope, context, argLine));
+            else if (argAttributes.hasAttribute(QLatin1String("default")) && !include.args.contains(name))
+                include.args.insert(name, attribute(argAttributes, QLatin1String("default"), scope, context, argLine));
+        }
+        xml.skipCurrentElement();
+    }
+
+    if (file.isEmpty())
+    {
+        addError(context, scope, line, QLatin1String("include tag requires a file"));
+        return;
+    }
+
+    ++context.depth;
+    parseFile(file, include, context);
+    --context.depth;
+}
+
+void ROSLaunchParser::parseNode(QXmlStreamReader &xml, const Scope &scope, Context &context, bool test) const
+{
+    const int line = xml.lineNumber();
+    const QXmlStreamAttributes attributes = xml.attributes();
+
+    Node node;
+    node.test = test;
+    node.uncertain = scope.uncertain;
+    node.file = scope.file;
+    node.line = line;
+    node.ns = scope.ns;
+    node.remaps = scope.remaps;
+    node.package = attribute(attributes, QLatin1String("pkg"), scope, context, line);
+    node.type = attribute(attributes, QLatin1String("type"), scope, context, line);
+    node.name = attribute(attributes, test ? QLatin1String("test-name") : QLatin1String("name"), scope, context, line);
+    node.args = attribute(attributes, QLatin1String("args"), scope, context, line);
+    node.launchPrefix = attribute(attributes, QLatin1String("launch-prefix"), scope, context, line);
+    node.output = attribute(attributes, QLatin1String("output"), scope, context, line);
+    node.required = isTrue(attribute(attributes, QLatin1String("required"), scope, context, line));
+    node.respawn = isTrue(attribute(attributes, QLatin1String("respawn"), scope, context, line));
+
+    const QString ns = attribute(attributes, QLatin1String("ns"), scope, context, line);
+    if (!ns.isEmpty())
+        node.ns = resolveName(scope.ns, ns) + QLatin1Char('/');
+
+    if (node.package.isEmpty() || node.type.isEmpty())
+        addError(context, scope, line, QString("%1 tag requires pkg and type").arg(test ? QLatin1String("test") : QLatin1String("node")));
+
+    if (node.name.isEmpty())
+        addError(context, scope, line, QString("%1 tag requires a name").arg(test ? QLatin1String("test") : QLatin1String("node")));
+
+    // Parameters declared within a node are private to it
+    const QString privateNs = node.fullName() + QLatin1Char('/');
+    while (xml.readNextStartElement())
+    {
+        const int childLine = xml.lineNumber();
+        if (!isEnabled(xml.attributes(), scope, context, childLine))
+            xml.skipCurrentElement();
+        else if (xml.name() == QLatin1String("remap"))
+            parseRemap(xml, scope, node.remaps, context);
+        else if (xml.name() == QLatin1String("param"))
+            parseParam(xml, scope, privateNs, context);
+        else if (xml.name() == QLatin1String("rosparam"))
+            parseRosParam(xml, scope, privateNs, context);
+        else
+            xml.skipCurrentElement();
+    }
+
+    context.result->nodes.append(node);
+}
+
+void ROSLaunchParser::parseParam(QXmlStreamReader &xml, const Scope &scope, const QString &privateNs, Context &context) const
+{
+    const int line = xml.lineNumber();
+    const QXmlStreamAttributes attributes = xml.attributes();
+    xml.skipCurrentElement();
+
+    QString name = attribute(attributes, QLatin1String("name"), scope, context, line);
+    if (name.isEmpty())
+    {
+        addError(context, scope, line, QLatin1String("param tag requires a name"));
+        return;
+    }
+
+    if (name.startsWith(QLatin1Char('~')))
+        name = name.mid(1);
+
+    Parameter parameter;
+    parameter.name = resolveName(privateNs.isEmpty() ? scope.ns : privateNs, name);
+    parameter.file = scope.file;
+    parameter.line = line;
+
+    if (attributes.hasAttribute(QLatin1String("value")))
+    {
+        parameter.value = attribute(attributes, QLatin1String("value"), scope, context, line);
+        parameter.type = attribute(attributes, QLatin1String("type"), scope, context, line);
+    }
+    else if (attributes.hasAttribute(QLatin1String("textfile")))
+    {
+        parameter.value = attribute(attributes, QLatin1String("textfile"), scope, context, line);
+        parameter.type = QLatin1String("textfile");
+    }
+    else if (attributes.hasAttribute(QLatin1String("binfile")))
+    {
+        parameter.value = attribute(attributes, QLatin1String("binfile"), scope, context, line);
+        parameter.type = QLatin1String("binfile");
+    }
+    else if (attributes.hasAttribute(QLatin1String("command")))
+    {
+        parameter.value = attribute(attributes, QLatin1String("command"), scope, context, line);
+        parameter.type = QLatin1String("command");
+    }
+    else
+    {
+        addError(context, scope, line, QString("param %1 requires a value, textfile, binfile or command").arg(name));
+        return;
+    }
+
+    context.result->parameters.append(parameter);
+}
+
+void ROSLaunchParser::parseRosParam(QXmlStreamReader &xml, const Scope &scope, const QString &privateNs, Context &context) const
+{
+    const int line = xml.lineNumber();
+    const QXmlStreamAttributes attributes = xml.attributes();
+    const QString text = xml.readElementText(QXmlStreamReader::SkipChildElements).trimmed();
+
+    QString ns = privateNs.isEmpty() ? scope.ns : privateNs;
+    const QString nsAttribute = attribute(attributes, QLatin1String("ns"), scope, context, line);
+    if (!nsAttribute.isEmpty())
+        ns = resolveName(ns, nsAttribute) + QLatin1Char('/');
+
+    QString param = attribute(attributes, QLatin1String("param"), scope, context, line);
+    if (param.startsWith(QLatin1Char('~')))
+        param = param.mid(1);
+
+    Parameter parameter;
+    parameter.name = param.isEmpty() ? ns : resolveName(ns, param);
+    parameter.type = QLatin1String("rosparam");
+    parameter.file = scope.file;
+    parameter.line = line;
+
+    const QString command = attribute(attributes, QLatin1String("command"), scope, context, line);
+    if (!command.isEmpty() && command != QLatin1String("load"))
+        parameter.type += QLatin1Char(' ') + command;
+
+    if (attributes.hasAttribute(QLatin1String("file")))
+        parameter.value = attribute(attributes, QLatin1String("file"), scope, context, line);
+    else
+        parameter.value = text;
+
+    context.result->parameters.append(parameter);
+}
+
+bool ROSLaunchParser::parseRemap(QXmlStreamReader &xml, const Scope &scope, QMap<QString, QString> &remaps, Context &context) const
+{
+    const int line = xml.lineNumber();
+    const QXmlStreamAttributes attributes = xml.attributes();
+    xml.skipCurrentElement();
+
+    const QString from = attribute(attributes, QLatin1String("from"), scope, context, line);
+    const QString to = attribute(attributes, QLatin1String("to"), scope, context, line);
+    if (from.isEmpty() || to.isEmpty())
+    {
+        addError(context, scope, line, QLatin1String("remap tag requires from and to"));
+        return false;
+    }
+
+    remaps.insert(from, to);
+    return true;
+}
+
+bool ROSLaunchParser::isEnabled(const QXmlStreamAttributes &attributes, const Scope &scope, Context &context, int line,
+                                bool *uncertain) const
+{
+    const bool hasIf = attributes.hasAttribute(QLatin1String("if"));
+    const bool hasUnless = attributes.hasAttribute(QLatin1String("unless"));
+    if (!hasIf && !hasUnless)
+        return true;
+
+    if (hasIf && hasUnless)
+    {
+        addError(context, scope, line, QLatin1String("if and unless cannot be used together"));
+        return false;
+    }
+
+    // Python expressions can not be evaluated, so the element is assumed to be enabled
+    const QString name = hasIf ? QLatin1String("if") : QLatin1String("unless");
+    if (isEval(attributes.value(name).toString()))
+    {
+        if (uncertain)
+            *uncertain = true;
+        return true;
+    }
+
+    const QString value = attribute(attributes, name, scope, context, line);
+    bool enabled = isTrue(value);
+    if (!enabled && !isFalse(value))
+    {
+        addError(context, scope, line, QString("Condition value must be true or false, not \"%1\"").arg(value));
+        return false;
+    }
+
+    return hasIf ? enabled : !enabled;
+}
+
+QString ROSLaunchParser::attribute(const QXmlStreamAttributes &attributes, const QString &name, const Scope &scope,
+                                   Context &context, int line) const
+{
+    return substitute(attributes.value(name).toString(), scope, context, line);
+}
+
+QString ROSLaunchParser::substitute(const QString &value, const Scope &scope, Context &context, int line) const
+{
+    int start = value.indexOf(QLatin1String("$("));
+    if (start == -1)
+        return value;
+
+    // Python expressions are not evaluated, the value is unknown but it is not an error
+    if (isEval(value))
+        return QString();
+
+    QString result;
+    int position = 0;
+    while (start != -1)
+    {
+        const int end = value.indexOf(QLatin1Char(')'), start);
+        if (end == -1)
+        {
+            addError(context, scope, line, QString("Unterminated substitution in \"%1\"").arg(value));
+            return result + value.mid(position);
+        }
+
+        result += value.midRef(position, start - position);
+
+        const QStringList parts = value.mid(start + 2, end - start - 2).split(QLatin1Char(' '), QString::SkipEmptyParts);
+        const QString command = parts.value(0);
+        const QString argument = parts.value(1);
+        if (command == QLatin1String("find"))
+        {
+            if (!context.result->packages.contains(argument))
+                context.result->packages.append(argument);
+
+            auto it = m_packagePaths.constFind(argument);
+            if (it == m_packagePaths.constEnd())
+                addError(context, scope, line, QString("Package %1 not found").arg(argument));
+            else
+                result += it.value();
+        }
+        else if (command == QLatin1String("arg"))
+        {
+            auto it = scope.args.constFind(argument);
+            if (it == scope.args.constEnd())
+                addError(context, scope, line, QString("Argument %1 is not set").arg(argument));
+            else
+                result += it.value();
+        }
+        else if (command == QLatin1String("env"))
+        {
+            context.environment.insert(argument, m_environment.value(argument));
+            auto it = m_environment.constFind(argument);
+            if (it == m_environment.constEnd())
+                addError(context, scope, line, QString("Environment variable %1 is not set").arg(argument));
+            else
+                result += it.value();
+        }
+        else if (command == QLatin1String("optenv"))
+        {
+            context.environment.insert(argument, m_environment.value(argument));
+            auto it = m_environment.constFind(argument);
+            result += (it == m_environment.constEnd()) ? QStringList(parts.mid(2)).join(QLatin1Char(' ')) : it.value();
+        }
+        else if (command == QLatin1String("anon"))
+        {
+            // The real name has a random suffix, a stable one keeps the model comparable
+            result += argument + QLatin1String("_anon");
+        }
+        else if (command == QLatin1String("dirname"))
+        {
+            result += QFileInfo(scope.file).absolutePath();
+        }
+        else
+        {
+            addError(context, scope, line, QString("Unsupported substitution $(%1)").arg(command));
+        }
+
+        position = end + 1;
+        start = value.indexOf(QLatin1String("$("), position);
+    }
+
+    result += value.midRef(position);
+    return result;
+}
+
+void ROSLaunchParser::addError(Context &context, const Scope &scope, int line, const QString &message) const
+{
+    context.result->errors.append(QString("%1:%2: %3").arg(scope.file).arg(line).arg(message));
+}
+
+QString ROSLaunchParser::resolveName(const QString &ns, const QString &name)
+{
+    if (name.isEmpty())
+        return ns;
+
+    if (name.startsWith(QLatin1Char('/')))
+        return name.endsWith(QLatin1Char('/')) ? name.left(name.size() - 1) : name;
+
+    QString resolved = ns.endsWith(QLatin1Char('/')) ? ns + name : ns + QLatin1Char('/') + name;
+    return resolved.endsWith(QLatin1Char('/')) ? resolved.left(resolved.size() - 1) : resolved;
+}
+
+QString ROSLaunchParser::cacheKey(const QString &file) const
+{
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    for (auto it = m_arguments.constBegin(); it != m_arguments.constEnd(); ++it)
+        hash.addData((it.key() + QLatin1String(":=") + it.value() + QLatin1Char('\n')).toUtf8());
+
+    for (auto it = m_packagePaths.constBegin(); it != m_packagePaths.constEnd(); ++it)
+        hash.addData((it.key() + QLatin1Char('=') + it.value() + QLatin1Char('\n')).toUtf8());
+
+    return file + QLatin1Char('\n') + QString::fromLatin1(hash.result().toHex());
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
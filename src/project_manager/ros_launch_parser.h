@@ -0,0 +1,161 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_LAUNCH_PARSER_H
+#define ROS_LAUNCH_PARSER_H
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+QT_BEGIN_NAMESPACE
+class QXmlStreamReader;
+class QXmlStreamAttributes;
+QT_END_NAMESPACE
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Parses roslaunch XML files in process into a static model of their nodes, parameters and remaps
+ *
+ * Includes, groups, if/unless conditions and the $(find), $(arg), $(env), $(optenv), $(anon) and
+ * $(dirname) substitutions are resolved. Results are cached per launch file and arguments, a cached
+ * result is reused as long as the content hash of every file read while parsing it is unchanged.
+ */
+class ROSLaunchParser
+{
+public:
+    struct Node
+    {
+        QString name;
+        QString ns;                    /**< @brief Resolved namespace, always ends with a '/' */
+        QString package;
+        QString type;
+        QString args;
+        QString launchPrefix;
+        QString output;
+        bool required = false;
+        bool respawn = false;
+        bool test = false;             /**< @brief Declared with a test tag */
+        bool uncertain = false;        /**< @brief Declared under a condition which is not evaluated ($(eval)), it may not be started */
+        QMap<QString, QString> remaps; /**< @brief Remaps in effect for the node, from to to */
+        QString file;                  /**< @brief Launch file declaring the node */
+        int line = 0;
+
+        QString fullName() const { return ns + name; }
+    };
+
+    struct Parameter
+    {
+        QString name;                  /**< @brief Resolved name, for rosparam tags the namespace it is loaded into */
+        QString value;                 /**< @brief Value, file or command depending on the source */
+        QString type;                  /**< @brief Type attribute, textfile, binfile, command or rosparam */
+        QString file;
+        int line = 0;
+    };
+
+    struct LaunchFile
+    {
+        QString file;
+        QList<Node> nodes;
+        QList<Parameter> parameters;
+        QStringList files;             /**< @brief The launch file and all of the files it includes */
+        QStringList packages;          /**< @brief Packages referenced by $(find) */
+        QStringList errors;            /**< @brief Errors formatted as file:line: message */
+
+        bool isValid() const { return errors.isEmpty(); }
+    };
+
+    /**
+     * @brief Constructor
+     * @param packagePaths Package name to package directory, used to resolve $(find pkg)
+     * @param env Environment (KEY=VALUE), used to resolve $(env) and $(optenv)
+     */
+    ROSLaunchParser(const QMap<QString, QString> &packagePaths, const QStringList &env);
+
+    /** @brief Arguments passed to the top level launch file (ex. name:=value on the command line) */
+    void setArguments(const QMap<QString, QString> &arguments);
+
+    /**
+     * @brief Parse a launch file, the cached result is returned if none of its files changed
+     * @param file Path to the launch file
+     * @return Static model of the launch file
+     */
+    LaunchFile parse(const QString &file) const;
+
+    /**
+     * @brief Find the packages on the ROS_PACKAGE_PATH without calling rospack
+     * @param env Environment (KEY=VALUE) containing ROS_PACKAGE_PATH
+     * @return Package name to package directory
+     */
+    static QMap<QString, QString> findPackages(const QStringList &env);
+
+    /** @brief Parse command line style arguments (name:=value), other arguments are ignored */
+    static QMap<QString, QString> parseArguments(const QString &arguments);
+
+    static void clearCache();
+
+private:
+    struct Scope
+    {
+        QString file;
+        QString ns = QLatin1String("/");
+        QMap<QString, QString> args;
+        QMap<QString, QString> remaps;
+        bool uncertain = false; /**< @brief Within an element whose condition is not evaluated */
+    };
+
+    struct Context
+    {
+        LaunchFile *result;
+        QHash<QString, QByteArray> fileHashes;
+        QHash<QString, QString> environment; /**< @brief Environment variables read by substitutions */
+        int depth = 0;
+    };
+
+    void parseFile(const QString &file, Scope scope, Context &context) const;
+    void parseChildren(QXmlStreamReader &xml, Scope &scope, Context &context) const;
+    void parseArg(QXmlStreamReader &xml, Scope &scope, Context &context) const;
+    void parseInclude(QXmlStreamReader &xml, const Scope &scope, Context &context) const;
+    void parseNode(QXmlStreamReader &xml, const Scope &scope, Context &context, bool test) const;
+    void parseParam(QXmlStreamReader &xml, const Scope &scope, const QString &privateNs, Context &context) const;
+    void parseRosParam(QXmlStreamReader &xml, const Scope &scope, const QString &privateNs, Context &context) const;
+    bool parseRemap(QXmlStreamReader &xml, const Scope &scope, QMap<QString, QString> &remaps, Context &context) const;
+    bool isEnabled(const QXmlStreamAttributes &attributes, const Scope &scope, Context &context, int line,
+                   bool *uncertain = nullptr) const;
+    QString attribute(const QXmlStreamAttributes &attributes, const QString &name, const Scope &scope,
+                      Context &context, int line) const;
+    QString substitute(const QString &value, const Scope &scope, Context &context, int line) const;
+    void addError(Context &context, const Scope &scope, int line, const QString &message) const;
+    static QString resolveName(const QString &ns, const QString &name);
+    QString cacheKey(const QString &file) const;
+
+    QMap<QString, QString> m_packagePaths;
+    QHash<QString, QString> m_environment;
+    QMap<QString, QString> m_arguments;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_LAUNCH_PARSER_H
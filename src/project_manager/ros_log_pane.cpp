@@ -0,0 +1,381 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_log_pane.h"
+
+#include <coreplugin/icore.h>
+#include <utils/runextensions.h>
+#include <utils/utilsicons.h>
+
+#include <QColor>
+#include <QComboBox>
+#include <QDateTime>
+#include <QFileDialog>
+#include <QHeaderView>
+#include <QLineEdit>
+#include <QMessageBox>
+#include <QScrollBar>
+#include <QToolButton>
+#include <QTreeView>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+static void findEntries(QFutureInterface<QVector<qint64> > &fi, const ROSLogStore *store, ROSLogStore::Filter filter, qint64 end)
+{
+    const QVector<qint64> sequences = store->find(filter, 0, end, &fi);
+    if (!fi.isCanceled())
+        fi.reportResult(sequences);
+}
+
+////////////////////////////////////
+/// ROSLogModel
+////////////////////////////////////
+
+ROSLogModel::ROSLogModel(ROSLogStore *store, QObject *parent) :
+    QAbstractTableModel(parent),
+    m_store(store)
+{
+    connect(m_store, &ROSLogStore::cleared, this, [this]() {
+        beginResetModel();
+        m_sequences.clear();
+        m_checkedEnd = 0;
+        endResetModel();
+    });
+}
+
+int ROSLogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_sequences.size();
+}
+
+int ROSLogModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant ROSLogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_sequences.size())
+        return QVariant();
+
+    const ROSLogStore::Entry &entry = m_store->entry(m_sequences.at(index.row()));
+    if (role == Qt::DisplayRole)
+    {
+        switch (index.column())
+        {
+        case TimeColumn:
+            return QDateTime::fromMSecsSinceEpoch(entry.timestamp).toString(QLatin1String("hh:mm:ss.zzz"));
+        case SeverityColumn:
+            return ROSLogStore::severityName(static_cast<ROSLogStore::Severity>(entry.severity));
+        case NodeColumn:
+            return m_store->nodes().value(entry.node);
+        case MessageColumn:
+            return m_store->message(m_sequences.at(index.row()));
+        }
+    }
+    else if (role == Qt::ForegroundRole)
+    {
+        if (entry.severity == ROSLogStore::Warn)
+            return QColor(Qt::darkYellow);
+        if (entry.severity == ROSLogStore::Error || entry.severity == ROSLogStore::Fatal)
+            return QColor(Qt::red);
+    }
+
+    return QVariant();
+}
+
+QVariant ROSLogModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QVariant();
+
+    switch (section)
+    {
+    case TimeColumn:
+        return tr("Time");
+    case SeverityColumn:
+        return tr("Severity");
+    case NodeColumn:
+        return tr("Node");
+    case MessageColumn:
+        return tr("Message");
+    }
+    return QVariant();
+}
+
+void ROSLogModel::setFilter(const ROSLogStore::Filter &filter, const QVector<qint64> &sequences, qint64 end)
+{
+    beginResetModel();
+    m_filter = filter;
+    m_sequences = sequences;
+    m_checkedEnd = end;
+    endResetModel();
+
+    // Add the entries received while filtering
+    update();
+}
+
+void ROSLogModel::update()
+{
+    // Remove the entries dropped from the ring buffer
+    int dropped = 0;
+    while (dropped < m_sequences.size() && m_sequences.at(dropped) < m_store->firstSequence())
+        ++dropped;
+
+    if (dropped > 0)
+    {
+        beginRemoveRows(QModelIndex(), 0, dropped - 1);
+        m_sequences.remove(0, dropped);
+        endRemoveRows();
+    }
+
+    // Only the new entries are checked against the filter
+    const QVector<qint64> added = m_store->find(m_filter, m_checkedEnd);
+    m_checkedEnd = m_store->endSequence();
+    if (added.isEmpty())
+        return;
+
+    beginInsertRows(QModelIndex(), m_sequences.size(), m_sequences.size() + added.size() - 1);
+    m_sequences += added;
+    endInsertRows();
+}
+
+const QVector<qint64> &ROSLogModel::sequences() const
+{
+    return m_sequences;
+}
+
+////////////////////////////////////
+/// ROSLogPane
+////////////////////////////////////
+
+ROSLogPane::ROSLogPane(ROSLogStore *store) :
+    m_store(store),
+    m_model(new ROSLogModel(store, this)),
+    m_view(new QTreeView),
+    m_severityComboBox(new QComboBox),
+    m_nodeComboBox(new QComboBox),
+    m_filterLineEdit(new QLineEdit),
+    m_exportButton(new QToolButton)
+{
+    m_view->setModel(m_model);
+    m_view->setRootIsDecorated(false);
+    m_view->setUniformRowHeights(true);
+    m_view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    m_view->header()->setStretchLastSection(true);
+    m_view->header()->setSectionResizeMode(ROSLogModel::TimeColumn, QHeaderView::ResizeToContents);
+    m_view->header()->setSectionResizeMode(ROSLogModel::SeverityColumn, QHeaderView::ResizeToContents);
+
+    m_severityComboBox->setToolTip(tr("Minimum severity"));
+    m_severityComboBox->addItems(QStringList() << tr("All Output") << tr("Debug") << tr("Info")
+                                               << tr("Warn") << tr("Error") << tr("Fatal"));
+
+    m_nodeComboBox->setToolTip(tr("Node"));
+    m_nodeComboBox->setSizeAdjustPolicy(QComboBox::AdjustToContents);
+    m_nodeComboBox->addItem(tr("All Nodes"), -1);
+
+    m_filterLineEdit->setPlaceholderText(tr("Filter (regular expression)"));
+    m_filterLineEdit->setClearButtonEnabled(true);
+
+    m_exportButton->setToolTip(tr("Export the shown entries"));
+    m_exportButton->setIcon(Utils::Icons::SAVEFILE_TOOLBAR.icon());
+
+    // The view is updated at a fixed rate instead of for every line
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(200);
+    connect(&m_updateTimer, &QTimer::timeout, this, &ROSLogPane::updateEntries);
+    connect(m_store, &ROSLogStore::entriesAdded, this, [this]() {
+        if (!m_updateTimer.isActive())
+            m_updateTimer.start();
+    });
+    connect(m_store, &ROSLogStore::cleared, this, &ROSLogPane::updateNodes);
+
+    // The results of a filter started before clearing refer to dropped entries, so it is restarted
+    connect(m_store, &ROSLogStore::cleared, this, [this]() {
+        if (m_filterWatcher.isRunning())
+            updateFilter();
+    });
+
+    // Filtering searches every message, so it is delayed while typing and done on a worker thread
+    m_filterTimer.setSingleShot(true);
+    m_filterTimer.setInterval(300);
+    connect(&m_filterTimer, &QTimer::timeout, this, &ROSLogPane::updateFilter);
+    connect(&m_filterWatcher, &QFutureWatcher<QVector<qint64> >::finished, this, &ROSLogPane::filterFinished);
+
+    connect(m_severityComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(updateFilter()));
+    connect(m_nodeComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(updateFilter()));
+    connect(m_filterLineEdit, SIGNAL(textChanged(QString)), &m_filterTimer, SLOT(start()));
+    connect(m_exportButton, SIGNAL(clicked()), this, SLOT(exportEntries()));
+}
+
+ROSLogPane::~ROSLogPane()
+{
+    m_filterWatcher.cancel();
+    m_filterWatcher.waitForFinished();
+
+    delete m_view;
+    delete m_severityComboBox;
+    delete m_nodeComboBox;
+    delete m_filterLineEdit;
+    delete m_exportButton;
+}
+
+void ROSLogPane::updateFilter()
+{
+    ROSLogStore::Filter filter;
+    filter.includeOutput = (m_severityComboBox->currentIndex() <= 0);
+    filter.minimumSeverity = static_cast<ROSLogStore::Severity>(qMax(0, m_severityComboBox->currentIndex() - 1));
+    filter.node = m_nodeComboBox->currentData().isValid() ? m_nodeComboBox->currentData().toInt() : -1;
+    filter.expression = QRegularExpression(m_filterLineEdit->text(), QRegularExpression::CaseInsensitiveOption);
+
+    if (filter.expression.isValid())
+        m_filterLineEdit->setToolTip(QString());
+    else
+        m_filterLineEdit->setToolTip(filter.expression.errorString());
+
+    // A filter which is still running is outdated
+    m_filterTimer.stop();
+    m_filterWatcher.cancel();
+    m_pendingFilter = filter;
+    m_pendingEnd = m_store->endSequence();
+    m_filterWatcher.setFuture(Utils::runAsync(&findEntries, m_store, filter, m_pendingEnd));
+}
+
+void ROSLogPane::filterFinished()
+{
+    if (m_filterWatcher.isCanceled() || m_filterWatcher.future().resultCount() == 0)
+        return;
+
+    m_model->setFilter(m_pendingFilter, m_filterWatcher.result(), m_pendingEnd);
+    m_view->scrollToBottom();
+}
+
+void ROSLogPane::updateEntries()
+{
+    // Keep showing the newest entries unless the user scrolled up
+    QScrollBar *scrollBar = m_view->verticalScrollBar();
+    const bool autoScroll = (scrollBar->value() == scrollBar->maximum());
+    m_model->update();
+    updateNodes();
+
+    if (autoScroll)
+        m_view->scrollToBottom();
+}
+
+void ROSLogPane::updateNodes()
+{
+    // The nodes are only ever added, until the log is cleared
+    const QStringList &nodes = m_store->nodes();
+    if (m_nodeComboBox->count() - 1 > nodes.size())
+    {
+        m_nodeComboBox->setCurrentIndex(0);
+        while (m_nodeComboBox->count() > 1)
+            m_nodeComboBox->removeItem(1);
+    }
+
+    for (int i = m_nodeComboBox->count() - 1; i < nodes.size(); ++i)
+        m_nodeComboBox->addItem(nodes.at(i), i);
+}
+
+void ROSLogPane::exportEntries()
+{
+    const QString fileName = QFileDialog::getSaveFileName(Core::ICore::mainWindow(), tr("Export Log"),
+                                                          QString(), tr("Log Files (*.log);;All Files (*)"));
+    if (fileName.isEmpty())
+        return;
+
+    if (!m_store->exportToFile(fileName, m_model->sequences()))
+        QMessageBox::warning(Core::ICore::mainWindow(), tr("Export Log"), tr("Failed to write %1.").arg(fileName));
+}
+
+QList<QWidget *> ROSLogPane::toolBarWidgets() const
+{
+    return QList<QWidget *>() << m_severityComboBox
+                              << m_nodeComboBox
+                              << m_filterLineEdit
+                              << m_exportButton;
+}
+
+QWidget *ROSLogPane::outputWidget(QWidget *parent)
+{
+    m_view->setParent(parent);
+    return m_view;
+}
+
+QString ROSLogPane::displayName() const
+{
+    return tr("ROS Log");
+}
+
+int ROSLogPane::priorityInStatusBar() const
+{
+    return -1;
+}
+
+void ROSLogPane::clearContents()
+{
+    m_store->clear();
+}
+
+void ROSLogPane::visibilityChanged(bool /*visible*/)
+{
+}
+
+void ROSLogPane::setFocus()
+{
+    m_view->setFocus();
+}
+
+bool ROSLogPane::hasFocus() const
+{
+    return m_view->window()->focusWidget() == m_view;
+}
+
+bool ROSLogPane::canFocus() const
+{
+    return true;
+}
+
+bool ROSLogPane::canNavigate() const
+{
+    return false;
+}
+
+bool ROSLogPane::canNext() const
+{
+    return false;
+}
+
+bool ROSLogPane::canPrevious() const
+{
+    return false;
+}
+
+void ROSLogPane::goToNext()
+{
+}
+
+void ROSLogPane::goToPrev()
+{
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
@@ -0,0 +1,143 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_LOG_PANE_H
+#define ROS_LOG_PANE_H
+
+#include "ros_log_store.h"
+
+#include <coreplugin/ioutputpane.h>
+
+#include <QAbstractTableModel>
+#include <QFutureWatcher>
+#include <QTimer>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+class QComboBox;
+class QLineEdit;
+class QToolButton;
+class QTreeView;
+QT_END_NAMESPACE
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/** @brief Table of the log entries matching the current filter */
+class ROSLogModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column {
+        TimeColumn = 0,
+        SeverityColumn,
+        NodeColumn,
+        MessageColumn,
+        ColumnCount
+    };
+
+    explicit ROSLogModel(ROSLogStore *store, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    /**
+     * @brief Show the entries matching a filter
+     * @param filter Filter
+     * @param sequences Entries matching the filter up to the end sequence number
+     * @param end Entries from this sequence number on are checked by the next update
+     */
+    void setFilter(const ROSLogStore::Filter &filter, const QVector<qint64> &sequences, qint64 end);
+
+    /** @brief Add the matching entries added since the last update and remove the dropped entries */
+    void update();
+
+    const QVector<qint64> &sequences() const;
+
+private:
+    ROSLogStore *m_store;
+    ROSLogStore::Filter m_filter;
+    QVector<qint64> m_sequences;
+    qint64 m_checkedEnd = 0;  /**< @brief Entries before this sequence number were checked against the filter */
+};
+
+/**
+ * @brief Output pane showing the structured run step log
+ *
+ * The entries can be filtered by severity, node and a regular expression on the message,
+ * and the filtered entries can be exported to a file.
+ */
+class ROSLogPane : public Core::IOutputPane
+{
+    Q_OBJECT
+
+public:
+    explicit ROSLogPane(ROSLogStore *store);
+    ~ROSLogPane();
+
+    QWidget *outputWidget(QWidget *parent) override;
+    QList<QWidget *> toolBarWidgets() const override;
+    QString displayName() const override;
+
+    int priorityInStatusBar() const override;
+
+    void clearContents() override;
+    void visibilityChanged(bool visible) override;
+
+    void setFocus() override;
+    bool hasFocus() const override;
+    bool canFocus() const override;
+
+    bool canNavigate() const override;
+    bool canNext() const override;
+    bool canPrevious() const override;
+    void goToNext() override;
+    void goToPrev() override;
+
+private slots:
+    void updateFilter();
+    void filterFinished();
+    void updateEntries();
+    void exportEntries();
+
+private:
+    void updateNodes();
+
+    ROSLogStore *m_store;
+    ROSLogModel *m_model;
+    QTreeView *m_view;
+    QComboBox *m_severityComboBox;
+    QComboBox *m_nodeComboBox;
+    QLineEdit *m_filterLineEdit;
+    QToolButton *m_exportButton;
+    QTimer m_updateTimer;
+    QTimer m_filterTimer; /**< @brief Delays filtering while the expression is typed */
+    QFutureWatcher<QVector<qint64> > m_filterWatcher;
+    ROSLogStore::Filter m_pendingFilter;
+    qint64 m_pendingEnd = 0;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_LOG_PANE_H
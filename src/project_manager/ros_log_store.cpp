@@ -0,0 +1,389 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_log_store.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/** @brief Number of sequence numbers searched while the store is locked */
+const qint64 ROS_LOG_STORE_FIND_CHUNK_SIZE = 16384;
+
+static void appendSequences(const QVector<qint64> &sequences, qint64 from, qint64 to, QVector<qint64> &result)
+{
+    auto it = std::lower_bound(sequences.constBegin(), sequences.constEnd(), from);
+    for (; it != sequences.constEnd() && *it < to; ++it)
+        result.append(*it);
+}
+
+ROSLogStore::ROSLogStore(int capacity, int messageCapacity, QObject *parent) :
+    QObject(parent),
+    m_capacity(qMax(1, capacity)),
+    m_messageCapacity(qMax(1, messageCapacity)),
+    m_severitySequences(Output + 1)
+{
+}
+
+void ROSLogStore::addOutput(const QString &source, qint64 pid, const QString &text, bool isError)
+{
+    QString &partial = m_partialLines[pid * 2 + (isError ? 1 : 0)];
+    int start = 0;
+    int end = text.indexOf(QLatin1Char('\n'));
+    if (end == -1)
+    {
+        partial.append(text);
+        return;
+    }
+
+    while (end != -1)
+    {
+        addLine(source, partial + text.mid(start, end - start));
+        partial.clear();
+        start = end + 1;
+        end = text.indexOf(QLatin1Char('\n'), start);
+    }
+    partial = text.mid(start);
+
+    emit entriesAdded();
+}
+
+void ROSLogStore::flush(const QString &source, qint64 pid)
+{
+    bool added = false;
+    for (int channel = 0; channel < 2; ++channel)
+    {
+        const QString partial = m_partialLines.take(pid * 2 + channel);
+        if (!partial.isEmpty())
+        {
+            addLine(source, partial);
+            added = true;
+        }
+    }
+
+    if (added)
+        emit entriesAdded();
+}
+
+void ROSLogStore::clear()
+{
+    {
+        QWriteLocker locker(&m_lock);
+        m_entries.clear();
+        m_first = 0;
+        m_end = 0;
+        m_messages.clear();
+        m_messageEnd = 0;
+        m_severitySequences = QVector<QVector<qint64> >(Output + 1);
+        m_nodeSequences.clear();
+        m_prunedFirst = 0;
+        m_nodes.clear();
+        m_nodeIndexes.clear();
+    }
+    m_partialLines.clear();
+    emit cleared();
+}
+
+qint64 ROSLogStore::firstSequence() const
+{
+    return m_first;
+}
+
+qint64 ROSLogStore::endSequence() const
+{
+    return m_end;
+}
+
+const ROSLogStore::Entry &ROSLogStore::entry(qint64 sequence) const
+{
+    return m_entries.at(static_cast<int>(sequence % m_capacity));
+}
+
+QString ROSLogStore::message(qint64 sequence) const
+{
+    return messageRef(entry(sequence)).toString();
+}
+
+QStringRef ROSLogStore::messageRef(const Entry &e) const
+{
+    return QStringRef(&m_messages, static_cast<int>(e.messageStart % m_messageCapacity), e.messageLength);
+}
+
+const QStringList &ROSLogStore::nodes() const
+{
+    return m_nodes;
+}
+
+QVector<qint64> ROSLogStore::find(const Filter &filter, qint64 from, qint64 to, QFutureInterfaceBase *future) const
+{
+    QVector<qint64> result;
+    const bool matchExpression = !filter.expression.pattern().isEmpty() && filter.expression.isValid();
+
+    // The severity and node are compared as integers first, only their matches are searched
+    auto matches = [&](qint64 sequence) {
+        const Entry &e = entry(sequence);
+        if (e.severity == Output ? !filter.includeOutput : e.severity < filter.minimumSeverity)
+            return false;
+
+        if (filter.node != -1 && e.node != filter.node)
+            return false;
+
+        return !matchExpression || filter.expression.match(messageRef(e)).hasMatch();
+    };
+
+    {
+        QReadLocker locker(&m_lock);
+        if (to < 0 || to > m_end)
+            to = m_end;
+    }
+
+    // The indexes are used if they contain fewer candidates than all entries
+    const bool useIndexes = (filter.node != -1 || !filter.includeOutput);
+    QVector<qint64> candidates;
+    qint64 sequence = from;
+    while (sequence < to)
+    {
+        if (future && future->isCanceled())
+            break;
+
+        // Entries may have been dropped or cleared while the store was unlocked
+        QReadLocker locker(&m_lock);
+        sequence = qMax(sequence, m_first);
+        const qint64 chunkEnd = qMin(qMin(sequence + ROS_LOG_STORE_FIND_CHUNK_SIZE, to), m_end);
+        if (sequence >= chunkEnd)
+            break;
+
+        if (useIndexes)
+        {
+            candidates.clear();
+            if (filter.node != -1)
+            {
+                if (filter.node < m_nodeSequences.size())
+                    appendSequences(m_nodeSequences.at(filter.node), sequence, chunkEnd, candidates);
+            }
+            else
+            {
+                for (int severity = filter.minimumSeverity; severity < Output; ++severity)
+                    appendSequences(m_severitySequences.at(severity), sequence, chunkEnd, candidates);
+
+                std::sort(candidates.begin(), candidates.end());
+            }
+
+            foreach (qint64 candidate, candidates)
+            {
+                if (matches(candidate))
+                    result.append(candidate);
+            }
+        }
+        else
+        {
+            for (qint64 candidate = sequence; candidate < chunkEnd; ++candidate)
+            {
+                if (matches(candidate))
+                    result.append(candidate);
+            }
+        }
+
+        sequence = chunkEnd;
+    }
+
+    return result;
+}
+
+bool ROSLogStore::exportToFile(const QString &fileName, const QVector<qint64> &sequences) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        qDebug() << "Failed to open " << fileName << ": " << file.errorString();
+        return false;
+    }
+
+    QTextStream stream(&file);
+    foreach (qint64 sequence, sequences)
+    {
+        if (sequence >= m_first && sequence < m_end)
+            stream << format(sequence) << QLatin1Char('\n');
+    }
+
+    stream.flush();
+    return file.error() == QFile::NoError;
+}
+
+QString ROSLogStore::severityName(Severity severity)
+{
+    switch (severity)
+    {
+    case Debug:
+        return QLatin1String("DEBUG");
+    case Info:
+        return QLatin1String("INFO");
+    case Warn:
+        return QLatin1String("WARN");
+    case Error:
+        return QLatin1String("ERROR");
+    case Fatal:
+        return QLatin1String("FATAL");
+    case Output:
+        break;
+    }
+    return QLatin1String("OUTPUT");
+}
+
+QString ROSLogStore::format(qint64 sequence) const
+{
+    const Entry &e = entry(sequence);
+    return QString("%1 [%2] [%3]: %4").arg(QDateTime::fromMSecsSinceEpoch(e.timestamp).toString(QLatin1String("yyyy-MM-dd hh:mm:ss.zzz")),
+                                           severityName(static_cast<Severity>(e.severity)),
+                                           m_nodes.value(e.node),
+                                           messageRef(e).toString());
+}
+
+bool ROSLogStore::parseLine(const QString &line, Severity &severity, qint64 &timestamp, QString &node, QString &message)
+{
+    // [ WARN] [1496075545.125464561] [/talker]: message, the node is only present if ROSCONSOLE_FORMAT includes it
+    static const QRegularExpression format(QLatin1String("^\\[\\s*(DEBUG|INFO|WARN|ERROR|FATAL)\\s*\\]\\s*"
+                                                         "\\[([0-9]+(?:\\.[0-9]+)?)[^\\]]*\\]"
+                                                         "(?:\\s*\\[([^\\]]*)\\])?:\\s?(.*)$"));
+
+    QRegularExpressionMatch match = format.match(line);
+    if (!match.hasMatch())
+        return false;
+
+    const QString name = match.captured(1);
+    if (name == QLatin1String("DEBUG"))
+        severity = Debug;
+    else if (name == QLatin1String("INFO"))
+        severity = Info;
+    else if (name == QLatin1String("WARN"))
+        severity = Warn;
+    else if (name == QLatin1String("ERROR"))
+        severity = Error;
+    else
+        severity = Fatal;
+
+    timestamp = static_cast<qint64>(match.captured(2).toDouble() * 1000.0);
+    node = match.captured(3);
+    message = match.captured(4);
+    return true;
+}
+
+void ROSLogStore::addLine(const QString &source, const QString &line)
+{
+    // rosconsole colors the warnings and errors
+    static const QRegularExpression colors(QLatin1String("\\x1b\\[[0-9;]*m"));
+    QString text = line;
+    text.remove(colors);
+    if (text.endsWith(QLatin1Char('\r')))
+        text.chop(1);
+
+    Entry e;
+    Severity severity;
+    QString node;
+    QString message;
+    if (parseLine(text, severity, e.timestamp, node, message))
+    {
+        e.severity = severity;
+    }
+    else
+    {
+        e.timestamp = QDateTime::currentMSecsSinceEpoch();
+        message = text;
+    }
+
+    QWriteLocker locker(&m_lock);
+    e.node = nodeIndex(node.isEmpty() ? source : node);
+
+    // Drop the oldest entry if the ring buffer is full, its slot is reused
+    if (m_end - m_first >= m_capacity)
+        ++m_first;
+
+    appendMessage(message, e);
+
+    if (m_entries.size() < m_capacity)
+        m_entries.append(e);
+    else
+        m_entries[static_cast<int>(m_end % m_capacity)] = e;
+
+    m_severitySequences[e.severity].append(m_end);
+    m_nodeSequences[e.node].append(m_end);
+    ++m_end;
+
+    if (m_first - m_prunedFirst > m_capacity / 2)
+        pruneIndexes();
+}
+
+void ROSLogStore::appendMessage(const QString &message, Entry &e)
+{
+    // Messages are not split at the end of the buffer, they start at its beginning instead
+    const int length = qMin(message.size(), m_messageCapacity);
+    int position = static_cast<int>(m_messageEnd % m_messageCapacity);
+    if (position + length > m_messageCapacity)
+    {
+        m_messageEnd += m_messageCapacity - position;
+        position = 0;
+    }
+
+    // Drop the entries whose messages are overwritten
+    const qint64 overwritten = m_messageEnd + length - m_messageCapacity;
+    while (m_first < m_end && entry(m_first).messageStart < overwritten)
+        ++m_first;
+
+    if (m_messages.size() < position + length)
+        m_messages.resize(position + length);
+
+    std::copy(message.constBegin(), message.constBegin() + length, m_messages.begin() + position);
+    e.messageStart = m_messageEnd;
+    e.messageLength = length;
+    m_messageEnd += length;
+}
+
+void ROSLogStore::pruneIndexes()
+{
+    // The dropped entries are removed from the indexes in batches
+    for (QVector<qint64> &sequences : m_severitySequences)
+        sequences.erase(sequences.begin(), std::lower_bound(sequences.begin(), sequences.end(), m_first));
+
+    for (QVector<qint64> &sequences : m_nodeSequences)
+        sequences.erase(sequences.begin(), std::lower_bound(sequences.begin(), sequences.end(), m_first));
+
+    m_prunedFirst = m_first;
+}
+
+int ROSLogStore::nodeIndex(const QString &node)
+{
+    auto it = m_nodeIndexes.constFind(node);
+    if (it != m_nodeIndexes.constEnd())
+        return it.value();
+
+    m_nodes.append(node);
+    m_nodeIndexes.insert(node, m_nodes.size() - 1);
+    m_nodeSequences.append(QVector<qint64>());
+    return m_nodes.size() - 1;
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
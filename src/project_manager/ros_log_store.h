@@ -0,0 +1,165 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_LOG_STORE_H
+#define ROS_LOG_STORE_H
+
+#include <QFutureInterface>
+#include <QHash>
+#include <QObject>
+#include <QReadWriteLock>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QVector>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Stores the run step output as structured log entries
+ *
+ * Lines in the rosconsole format ([SEVERITY] [time] [node]: message) are split into their fields,
+ * other lines are stored as plain output of the run step. The entries and their messages are kept
+ * in ring buffers, once either is full the oldest entries are dropped. Each entry is addressed by
+ * a sequence number which stays valid until the entry is dropped.
+ *
+ * The store is modified on the GUI thread only, so the GUI thread reads it without locking.
+ * find() may be called from other threads.
+ */
+class ROSLogStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Severity {
+        Debug = 0,
+        Info,
+        Warn,
+        Error,
+        Fatal,
+        Output  /**< @brief Line which is not in the rosconsole format */
+    };
+
+    struct Entry
+    {
+        qint64 timestamp = 0; /**< @brief Milliseconds since epoch */
+        int node = -1;        /**< @brief Index in nodes() */
+        quint8 severity = Output;
+        int messageLength = 0;
+        qint64 messageStart = 0; /**< @brief Position in the message buffer, it wraps like the sequence numbers */
+    };
+
+    struct Filter
+    {
+        Severity minimumSeverity = Debug;
+        bool includeOutput = true;      /**< @brief Include lines which are not in the rosconsole format */
+        int node = -1;                  /**< @brief Node index, -1 for all nodes */
+        QRegularExpression expression;  /**< @brief Matched against the message, ignored if empty */
+    };
+
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of entries
+     * @param messageCapacity Maximum number of characters of all messages
+     * @param parent Parent object
+     */
+    explicit ROSLogStore(int capacity = 1000000, int messageCapacity = 32 * 1024 * 1024, QObject *parent = nullptr);
+
+    /**
+     * @brief Add process output, incomplete lines are kept until the rest of the line is received
+     * @param source Name of the run step, used as the node of lines without one
+     * @param pid Process id the output was read from
+     * @param text Output
+     * @param isError True if read from the standard error
+     */
+    void addOutput(const QString &source, qint64 pid, const QString &text, bool isError);
+
+    /** @brief Store the incomplete line of a process, called once it exited */
+    void flush(const QString &source, qint64 pid);
+
+    void clear();
+
+    qint64 firstSequence() const;
+    qint64 endSequence() const;   /**< @brief Sequence number the next entry will get */
+    const Entry &entry(qint64 sequence) const;
+    QString message(qint64 sequence) const;
+    const QStringList &nodes() const;
+
+    /**
+     * @brief Find the entries matching a filter, thread safe
+     *
+     * The per severity and per node indexes are used to only check candidate entries. The store
+     * is locked in chunks, so it can be modified while a long search is running.
+     * @param filter Filter
+     * @param from First sequence number to check, entries which were dropped are skipped
+     * @param to Sequence number to stop at, -1 for the end
+     * @param future Stops searching early if canceled
+     * @return Sequence numbers of the matching entries
+     */
+    QVector<qint64> find(const Filter &filter, qint64 from = 0, qint64 to = -1, QFutureInterfaceBase *future = nullptr) const;
+
+    /**
+     * @brief Write entries to a file, one line per entry
+     * @param fileName File to write
+     * @param sequences Sequence numbers of the entries
+     * @return True if written, otherwise false.
+     */
+    bool exportToFile(const QString &fileName, const QVector<qint64> &sequences) const;
+
+    static QString severityName(Severity severity);
+    QString format(qint64 sequence) const;
+
+    /**
+     * @brief Parse a line in the rosconsole format
+     * @return False if the line is not in the rosconsole format
+     */
+    static bool parseLine(const QString &line, Severity &severity, qint64 &timestamp, QString &node, QString &message);
+
+signals:
+    void entriesAdded();
+    void cleared();
+
+private:
+    void addLine(const QString &source, const QString &line);
+    void appendMessage(const QString &message, Entry &e);
+    void pruneIndexes();
+    int nodeIndex(const QString &node);
+    QStringRef messageRef(const Entry &e) const;
+
+    mutable QReadWriteLock m_lock; /**< @brief Only taken for writing by the GUI thread */
+    QVector<Entry> m_entries;   /**< @brief Ring buffer, entry n is at n % capacity */
+    int m_capacity;
+    qint64 m_first = 0;
+    qint64 m_end = 0;
+    QString m_messages;         /**< @brief Ring buffer of all messages, position n is at n % messageCapacity */
+    int m_messageCapacity;
+    qint64 m_messageEnd = 0;
+    QVector<QVector<qint64> > m_severitySequences; /**< @brief Sequence numbers of each severity */
+    QVector<QVector<qint64> > m_nodeSequences;     /**< @brief Sequence numbers of each node */
+    qint64 m_prunedFirst = 0;   /**< @brief First sequence number when the indexes were last pruned */
+    QStringList m_nodes;
+    QHash<QString, int> m_nodeIndexes;
+    QHash<qint64, QString> m_partialLines; /**< @brief Process output channel to its incomplete line */
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_LOG_STORE_H
@@ -0,0 +1,485 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_package_build_scheduler.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QSet>
+#include <QSocketNotifier>
+#include <QThread>
+#include <QTimer>
+
+#include <algorithm>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/** @brief Process started in its own process group, so it can be killed with all of its children */
+class ProcessGroupProcess : public QProcess
+{
+public:
+    explicit ProcessGroupProcess(QObject *parent = nullptr) : QProcess(parent) {}
+
+    /** @brief Terminate the process group, it is killed if still running after the timeout */
+    void terminateGroup(int killTimeout = 3000)
+    {
+        if (state() == QProcess::NotRunning)
+            return;
+
+        // make returns its jobserver tokens and removes partial outputs when terminated
+        ::kill(-static_cast<pid_t>(processId()), SIGTERM);
+        QTimer::singleShot(killTimeout, this, [this]() {
+            if (state() != QProcess::NotRunning)
+                ::kill(-static_cast<pid_t>(processId()), SIGKILL);
+        });
+    }
+
+protected:
+    void setupChildProcess() override
+    {
+        ::setpgid(0, 0);
+    }
+};
+
+ROSPackageBuildScheduler::ROSPackageBuildScheduler(QObject *parent) :
+    QObject(parent)
+{
+}
+
+ROSPackageBuildScheduler::~ROSPackageBuildScheduler()
+{
+    cancel();
+    destroyJobServer();
+}
+
+void ROSPackageBuildScheduler::setEnvironment(const QProcessEnvironment &environment)
+{
+    m_environment = environment;
+}
+
+void ROSPackageBuildScheduler::setJobBudget(int jobs)
+{
+    m_jobBudget = jobs;
+}
+
+int ROSPackageBuildScheduler::jobBudget() const
+{
+    return (m_jobBudget > 0) ? m_jobBudget : qMax(1, QThread::idealThreadCount());
+}
+
+void ROSPackageBuildScheduler::setConfigureCommand(const QString &workingDirectory, const QString &command, const QStringList &arguments)
+{
+    m_configureWorkingDirectory = workingDirectory;
+    m_configureCommand = command;
+    m_configureArguments = arguments;
+}
+
+void ROSPackageBuildScheduler::setSharedBuildDirectory(const QString &buildDirectory)
+{
+    m_sharedBuildDirectory = buildDirectory;
+}
+
+void ROSPackageBuildScheduler::setMakeArguments(const QStringList &arguments)
+{
+    m_makeArguments.clear();
+    for (int i = 0; i < arguments.size(); ++i)
+    {
+        const QString &arg = arguments.at(i);
+        if (arg == QLatin1String("-j") || arg == QLatin1String("--jobs") || arg == QLatin1String("-l"))
+        {
+            // Skip the optional job count
+            if (i + 1 < arguments.size() && !arguments.at(i + 1).startsWith(QLatin1Char('-')))
+                ++i;
+            continue;
+        }
+
+        if (arg.startsWith(QLatin1String("-j")) || arg.startsWith(QLatin1String("--jobs=")) || arg.startsWith(QLatin1String("-l")))
+            continue;
+
+        m_makeArguments.append(arg);
+    }
+}
+
+void ROSPackageBuildScheduler::setPackageWeights(const QHash<QString, double> &weights)
+{
+    m_weights = weights;
+}
+
+QHash<QString, double> ROSPackageBuildScheduler::criticalPathPriorities(const ROSPackageGraph &graph, const QStringList &packages, const QHash<QString, double> &weights)
+{
+    QSet<QString> packageSet = packages.toSet();
+    QHash<QString, double> priorities;
+
+    // Visit dependents before their dependencies
+    QStringList order = graph.topologicalOrder();
+    for (int i = order.size() - 1; i >= 0; --i)
+    {
+        const QString &package = order.at(i);
+        if (!packageSet.contains(package))
+            continue;
+
+        double longest = 0.0;
+        foreach (const QString &dependent, graph.dependents(package))
+            longest = qMax(longest, priorities.value(dependent, 0.0));
+
+        priorities.insert(package, weights.value(package, 1.0) + longest);
+    }
+
+    // Packages in a dependency cycle are not in the topological order
+    foreach (const QString &package, packages)
+    {
+        if (!priorities.contains(package))
+            priorities.insert(package, weights.value(package, 1.0));
+    }
+
+    return priorities;
+}
+
+bool ROSPackageBuildScheduler::start(const ROSPackageGraph &graph, const QMap<QString, QString> &packageBuildDirectories)
+{
+    if (m_active)
+        return false;
+
+    bool ok = false;
+    graph.topologicalOrder(&ok);
+    if (!ok)
+    {
+        emit stdError(tr("The package dependency graph contains a cycle."));
+        return false;
+    }
+
+    if (!createJobServer())
+    {
+        emit stdError(tr("Unable to create the make jobserver."));
+        return false;
+    }
+
+    m_buildDirectories = packageBuildDirectories;
+    m_dependents.clear();
+    m_remainingDependencies.clear();
+    m_ready.clear();
+    m_running.clear();
+    m_finishedCount = 0;
+    m_totalCount = m_buildDirectories.size();
+    m_failed = false;
+    m_active = true;
+
+    // Only the dependencies between packages being built matter
+    foreach (const QString &package, m_buildDirectories.keys())
+    {
+        int remaining = 0;
+        foreach (const QString &dependency, graph.dependencies(package))
+        {
+            if (m_buildDirectories.contains(dependency))
+            {
+                m_dependents[dependency].append(package);
+                ++remaining;
+            }
+        }
+
+        m_remainingDependencies.insert(package, remaining);
+        if (remaining == 0)
+            m_ready.append(package);
+    }
+
+    m_priorities = criticalPathPriorities(graph, m_buildDirectories.keys(), m_weights);
+
+    emit stdOutput(tr("Scheduling %1 packages with a budget of %2 jobs").arg(m_totalCount).arg(jobBudget()));
+    emit progressChanged(0, m_totalCount);
+
+    if (m_configureCommand.isEmpty())
+    {
+        schedule();
+        return true;
+    }
+
+    m_configureProcess = createProcess(m_configureWorkingDirectory);
+    connect(m_configureProcess, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, &ROSPackageBuildScheduler::configureFinished);
+
+    emit stdOutput(QString::fromLatin1("%1 %2").arg(m_configureCommand, m_configureArguments.join(QLatin1Char(' '))));
+    m_configureProcess->start(m_configureCommand, m_configureArguments);
+    return true;
+}
+
+void ROSPackageBuildScheduler::cancel()
+{
+    if (!m_active)
+        return;
+
+    m_failed = true;
+    m_ready.clear();
+
+    // Kill the whole process groups, otherwise the compilers started by make keep running
+    if (m_configureProcess)
+        static_cast<ProcessGroupProcess *>(m_configureProcess)->terminateGroup();
+
+    foreach (QProcess *process, m_running.keys())
+        static_cast<ProcessGroupProcess *>(process)->terminateGroup();
+}
+
+bool ROSPackageBuildScheduler::isRunning() const
+{
+    return m_active;
+}
+
+void ROSPackageBuildScheduler::configureFinished(int exitCode, QProcess::ExitStatus status)
+{
+    readOutput(m_configureProcess, false);
+    readOutput(m_configureProcess, true);
+    m_configureProcess->deleteLater();
+    m_configureProcess = nullptr;
+
+    if (m_failed || status != QProcess::NormalExit || exitCode != 0)
+    {
+        emit stdError(tr("Configuring the workspace failed."));
+        finish(false);
+        return;
+    }
+
+    schedule();
+}
+
+void ROSPackageBuildScheduler::packageProcessFinished(int exitCode, QProcess::ExitStatus status)
+{
+    QProcess *process = qobject_cast<QProcess *>(sender());
+    if (!process || !m_running.contains(process))
+        return;
+
+    readOutput(process, false);
+    readOutput(process, true);
+
+    QString package = m_running.take(process);
+    process->deleteLater();
+    releaseToken();
+
+    bool success = (status == QProcess::NormalExit && exitCode == 0);
+    ++m_finishedCount;
+    emit packageFinished(package, success);
+    emit progressChanged(m_finishedCount, m_totalCount);
+
+    if (!success)
+    {
+        // Let the running packages finish, but do not start new ones
+        emit stdError(tr("Building package %1 failed.").arg(package));
+        m_failed = true;
+        m_ready.clear();
+    }
+    else if (!m_failed)
+    {
+        foreach (const QString &dependent, m_dependents.value(package))
+        {
+            if (--m_remainingDependencies[dependent] == 0)
+                m_ready.append(dependent);
+        }
+    }
+
+    schedule();
+}
+
+void ROSPackageBuildScheduler::tokensAvailable()
+{
+    schedule();
+}
+
+void ROSPackageBuildScheduler::schedule()
+{
+    if (!m_active)
+        return;
+
+    // Start the packages with the longest remaining critical path first. Skipped packages
+    // finish immediately and may make more packages ready, so sort again after each start.
+    while (!m_ready.isEmpty() && acquireToken())
+    {
+        std::sort(m_ready.begin(), m_ready.end(), [this](const QString &a, const QString &b) {
+            return m_priorities.value(a) > m_priorities.value(b);
+        });
+
+        startPackage(m_ready.takeFirst());
+    }
+
+    if (m_ready.isEmpty() && m_running.isEmpty())
+    {
+        finish(!m_failed && m_finishedCount == m_totalCount);
+        return;
+    }
+
+    // Wait for a token to be returned to the jobserver
+    m_tokenNotifier->setEnabled(!m_ready.isEmpty());
+}
+
+void ROSPackageBuildScheduler::startPackage(const QString &package)
+{
+    QString buildDirectory = m_buildDirectories.value(package);
+    emit packageStarted(package);
+
+    // Packages without a Makefile have nothing to build (ex. non catkin packages)
+    if (!QFileInfo(QDir(buildDirectory).absoluteFilePath(QLatin1String("Makefile"))).exists())
+    {
+        emit stdOutput(tr("No Makefile found for package %1, skipping.").arg(package));
+        releaseToken();
+        ++m_finishedCount;
+        emit packageFinished(package, true);
+        emit progressChanged(m_finishedCount, m_totalCount);
+
+        foreach (const QString &dependent, m_dependents.value(package))
+        {
+            if (--m_remainingDependencies[dependent] == 0)
+                m_ready.append(dependent);
+        }
+        return;
+    }
+
+    QStringList arguments = m_makeArguments;
+    QString workingDirectory = buildDirectory;
+    if (!m_sharedBuildDirectory.isEmpty())
+    {
+        // The package's Makefile would check the shared build system and update its progress
+        // files, which races with the other packages. Its dependencies are already built,
+        // so building its directory target only checks and builds the package's own targets.
+        QString target = QDir(m_sharedBuildDirectory).relativeFilePath(buildDirectory) + QLatin1String("/all");
+        arguments << QLatin1String("-f") << QLatin1String("CMakeFiles/Makefile2") << target;
+        workingDirectory = m_sharedBuildDirectory;
+    }
+
+    QProcess *process = createProcess(workingDirectory);
+    connect(process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, &ROSPackageBuildScheduler::packageProcessFinished);
+
+    m_running.insert(process, package);
+    emit stdOutput(tr("Starting package %1").arg(package));
+    process->start(QLatin1String("make"), arguments);
+}
+
+void ROSPackageBuildScheduler::finish(bool success)
+{
+    if (!m_active)
+        return;
+
+    m_active = false;
+    destroyJobServer();
+    emit finished(success);
+}
+
+void ROSPackageBuildScheduler::readOutput(QProcess *process, bool isError)
+{
+    QByteArray data = isError ? process->readAllStandardError() : process->readAllStandardOutput();
+    if (data.isEmpty())
+        return;
+
+    foreach (const QString &line, QString::fromLocal8Bit(data).split(QLatin1Char('\n'), QString::SkipEmptyParts))
+    {
+        if (isError)
+            emit stdError(line);
+        else
+            emit stdOutput(line);
+    }
+}
+
+QProcess *ROSPackageBuildScheduler::createProcess(const QString &workingDirectory)
+{
+    // Make processes share the jobserver, the file descriptors are inherited by the child process
+    QProcessEnvironment env = m_environment;
+    QString makeFlags = env.value(QLatin1String("MAKEFLAGS"));
+    makeFlags.append(QString::fromLatin1(" -j --jobserver-fds=%1,%2").arg(m_jobServerFds[0]).arg(m_jobServerFds[1]));
+    env.insert(QLatin1String("MAKEFLAGS"), makeFlags.trimmed());
+
+    QProcess *process = new ProcessGroupProcess(this);
+    process->setWorkingDirectory(workingDirectory);
+    process->setProcessEnvironment(env);
+
+    // Output is forwarded line by line so the build output parsers can handle it
+    connect(process, &QProcess::readyReadStandardOutput, this, [this, process]() {
+        while (process->canReadLine())
+            emit stdOutput(QString::fromLocal8Bit(process->readLine()).trimmed());
+    });
+
+    connect(process, &QProcess::readyReadStandardError, this, [this, process]() {
+        process->setReadChannel(QProcess::StandardError);
+        while (process->canReadLine())
+            emit stdError(QString::fromLocal8Bit(process->readLine()).trimmed());
+        process->setReadChannel(QProcess::StandardOutput);
+    });
+
+    return process;
+}
+
+bool ROSPackageBuildScheduler::createJobServer()
+{
+    destroyJobServer();
+
+    // A socket pair is used instead of a pipe so the scheduler can take tokens without blocking,
+    // while make reads from it as it would from the jobserver pipe.
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, m_jobServerFds) != 0)
+    {
+        m_jobServerFds[0] = -1;
+        m_jobServerFds[1] = -1;
+        return false;
+    }
+
+    QByteArray tokens(jobBudget(), '+');
+    if (::write(m_jobServerFds[1], tokens.constData(), tokens.size()) != tokens.size())
+    {
+        destroyJobServer();
+        return false;
+    }
+
+    m_tokenNotifier = new QSocketNotifier(m_jobServerFds[0], QSocketNotifier::Read, this);
+    m_tokenNotifier->setEnabled(false);
+    connect(m_tokenNotifier, &QSocketNotifier::activated,
+            this, &ROSPackageBuildScheduler::tokensAvailable);
+
+    return true;
+}
+
+void ROSPackageBuildScheduler::destroyJobServer()
+{
+    delete m_tokenNotifier;
+    m_tokenNotifier = nullptr;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        if (m_jobServerFds[i] != -1)
+            ::close(m_jobServerFds[i]);
+
+        m_jobServerFds[i] = -1;
+    }
+}
+
+bool ROSPackageBuildScheduler::acquireToken()
+{
+    char token;
+    return (::recv(m_jobServerFds[0], &token, 1, MSG_DONTWAIT) == 1);
+}
+
+void ROSPackageBuildScheduler::releaseToken()
+{
+    char token = '+';
+    if (::write(m_jobServerFds[1], &token, 1) != 1)
+        qDebug() << "Error returning token to the make jobserver";
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
@@ -0,0 +1,152 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_PACKAGE_BUILD_SCHEDULER_H
+#define ROS_PACKAGE_BUILD_SCHEDULER_H
+
+#include "ros_package_graph.h"
+
+#include <QHash>
+#include <QMap>
+#include <QObject>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QStringList>
+
+QT_BEGIN_NAMESPACE
+class QSocketNotifier;
+QT_END_NAMESPACE
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Builds workspace packages concurrently in dependency order
+ *
+ * A package is started once all of its dependencies finished, ready packages are started
+ * in order of their longest remaining critical path. All make processes share a GNU make
+ * jobserver, so the total number of compile jobs across all packages is bounded by the job budget.
+ */
+class ROSPackageBuildScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ROSPackageBuildScheduler(QObject *parent = nullptr);
+    ~ROSPackageBuildScheduler();
+
+    void setEnvironment(const QProcessEnvironment &environment);
+
+    /** @brief Total number of concurrent compile jobs, if less than one the ideal thread count is used */
+    void setJobBudget(int jobs);
+    int jobBudget() const;
+
+    /** @brief Command which is run before any package is built (ex. configuring the workspace) */
+    void setConfigureCommand(const QString &workingDirectory, const QString &command, const QStringList &arguments);
+
+    /**
+     * @brief Build the packages through the Makefile of a build tree shared by all packages (ex. catkin_make)
+     *
+     * Each package is then built with its target in CMakeFiles/Makefile2, so the concurrent make
+     * processes skip the workspace wide steps (ex. cmake_check_build_system) which are done once
+     * by the configure command.
+     */
+    void setSharedBuildDirectory(const QString &buildDirectory);
+
+    /** @brief Additional make arguments, job arguments are removed since the jobserver is used */
+    void setMakeArguments(const QStringList &arguments);
+
+    /** @brief Estimated build duration of each package, packages not listed have a weight of one */
+    void setPackageWeights(const QHash<QString, double> &weights);
+
+    /**
+     * @brief Start building the packages
+     * @param graph Workspace package dependency graph
+     * @param packageBuildDirectories Package name to build directory containing its Makefile
+     * @return True if started, otherwise false.
+     */
+    bool start(const ROSPackageGraph &graph, const QMap<QString, QString> &packageBuildDirectories);
+    void cancel();
+    bool isRunning() const;
+
+    /**
+     * @brief Calculate the longest weighted path from each package to the end of the build
+     * @param graph Workspace package dependency graph
+     * @param packages Packages being built
+     * @param weights Estimated build duration of each package
+     * @return Package name to critical path length
+     */
+    static QHash<QString, double> criticalPathPriorities(const ROSPackageGraph &graph,
+                                                         const QStringList &packages,
+                                                         const QHash<QString, double> &weights);
+
+signals:
+    void stdOutput(const QString &line);
+    void stdError(const QString &line);
+    void packageStarted(const QString &package);
+    void packageFinished(const QString &package, bool success);
+    void progressChanged(int finished, int total);
+    void finished(bool success);
+
+private slots:
+    void configureFinished(int exitCode, QProcess::ExitStatus status);
+    void packageProcessFinished(int exitCode, QProcess::ExitStatus status);
+    void tokensAvailable();
+
+private:
+    bool createJobServer();
+    void destroyJobServer();
+    bool acquireToken();
+    void releaseToken();
+    void schedule();
+    void startPackage(const QString &package);
+    void finish(bool success);
+    void readOutput(QProcess *process, bool isError);
+    QProcess *createProcess(const QString &workingDirectory);
+
+    QProcessEnvironment m_environment;
+    int m_jobBudget = 0;
+    QString m_configureWorkingDirectory;
+    QString m_configureCommand;
+    QStringList m_configureArguments;
+    QString m_sharedBuildDirectory;
+    QStringList m_makeArguments;
+    QHash<QString, double> m_weights;
+
+    QMap<QString, QString> m_buildDirectories;
+    QHash<QString, double> m_priorities;
+    QHash<QString, QStringList> m_dependents;  /**< @brief Dependents within the packages being built */
+    QHash<QString, int> m_remainingDependencies;
+    QStringList m_ready;
+    QHash<QProcess *, QString> m_running;
+    QProcess *m_configureProcess = nullptr;
+    int m_finishedCount = 0;
+    int m_totalCount = 0;
+    bool m_failed = false;
+    bool m_active = false;
+
+    int m_jobServerFds[2] = {-1, -1};
+    QSocketNotifier *m_tokenNotifier = nullptr;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_PACKAGE_BUILD_SCHEDULER_H
@@ -0,0 +1,282 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_package_graph.h"
+
+#include <QSet>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+void ROSPackageGraph::build(const ROSUtils::PackageInfoMap &packageInfo)
+{
+    m_ids.clear();
+    m_names.clear();
+    m_dependencyNames.clear();
+    m_dependencies.clear();
+    m_dependents.clear();
+
+    m_names.reserve(packageInfo.size());
+    m_dependencyNames.reserve(packageInfo.size());
+    foreach (const ROSUtils::PackageInfo &package, packageInfo)
+    {
+        m_ids.insert(package.name, m_names.size());
+        m_names.append(package.name);
+        m_dependencyNames.append(dependencyNames(package));
+    }
+
+    m_dependencies.resize(m_names.size());
+    m_dependents.resize(m_names.size());
+    for (int i = 0; i < m_names.size(); ++i)
+        setDependencies(i, m_dependencyNames.at(i));
+}
+
+bool ROSPackageGraph::update(const ROSUtils::PackageInfoMap &packageInfo)
+{
+    bool changed = false;
+
+    // Remove packages which no longer exist
+    foreach (const QString &name, m_ids.keys())
+    {
+        if (!packageInfo.contains(name))
+        {
+            removePackage(name);
+            changed = true;
+        }
+    }
+
+    // Add new packages and packages whose dependencies changed
+    foreach (const ROSUtils::PackageInfo &package, packageInfo)
+    {
+        auto it = m_ids.constFind(package.name);
+        if (it == m_ids.constEnd() || m_dependencyNames.at(it.value()) != dependencyNames(package))
+        {
+            updatePackage(package);
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+void ROSPackageGraph::updatePackage(const ROSUtils::PackageInfo &packageInfo)
+{
+    int packageId = id(packageInfo.name);
+    if (packageId == -1)
+    {
+        packageId = m_names.size();
+        m_ids.insert(packageInfo.name, packageId);
+        m_names.append(packageInfo.name);
+        m_dependencyNames.append(QStringList());
+        m_dependencies.append(QVector<int>());
+        m_dependents.append(QVector<int>());
+
+        // Link existing packages which already depend on the new package
+        for (int i = 0; i < packageId; ++i)
+        {
+            if (!m_names.at(i).isEmpty() && m_dependencyNames.at(i).contains(packageInfo.name))
+            {
+                m_dependencies[i].append(packageId);
+                m_dependents[packageId].append(i);
+            }
+        }
+    }
+
+    m_dependencyNames[packageId] = dependencyNames(packageInfo);
+    setDependencies(packageId, m_dependencyNames.at(packageId));
+}
+
+void ROSPackageGraph::removePackage(const QString &name)
+{
+    int packageId = id(name);
+    if (packageId == -1)
+        return;
+
+    setDependencies(packageId, QStringList());
+    foreach (int dependent, m_dependents.at(packageId))
+        m_dependencies[dependent].removeAll(packageId);
+
+    // The id is kept so the other ids remain valid
+    m_dependents[packageId].clear();
+    m_dependencyNames[packageId].clear();
+    m_names[packageId].clear();
+    m_ids.remove(name);
+}
+
+bool ROSPackageGraph::contains(const QString &name) const
+{
+    return m_ids.contains(name);
+}
+
+int ROSPackageGraph::id(const QString &name) const
+{
+    return m_ids.value(name, -1);
+}
+
+QString ROSPackageGraph::name(int id) const
+{
+    return m_names.value(id);
+}
+
+int ROSPackageGraph::size() const
+{
+    return m_ids.size();
+}
+
+QStringList ROSPackageGraph::dependencies(const QString &name) const
+{
+    int packageId = id(name);
+    if (packageId == -1)
+        return QStringList();
+
+    return toNames(m_dependencies.at(packageId));
+}
+
+QStringList ROSPackageGraph::dependents(const QString &name) const
+{
+    int packageId = id(name);
+    if (packageId == -1)
+        return QStringList();
+
+    return toNames(m_dependents.at(packageId));
+}
+
+QStringList ROSPackageGraph::topologicalOrder(bool *ok) const
+{
+    // Kahn's algorithm, packages without dependencies first
+    QVector<int> inDegree(m_names.size(), 0);
+    QVector<int> ready;
+    for (int i = 0; i < m_names.size(); ++i)
+    {
+        if (m_names.at(i).isEmpty())
+            continue;
+
+        inDegree[i] = m_dependencies.at(i).size();
+        if (inDegree.at(i) == 0)
+            ready.append(i);
+    }
+
+    QVector<int> order;
+    order.reserve(m_ids.size());
+    for (int i = 0; i < ready.size(); ++i)
+    {
+        int current = ready.at(i);
+        order.append(current);
+        foreach (int dependent, m_dependents.at(current))
+        {
+            if (--inDegree[dependent] == 0)
+                ready.append(dependent);
+        }
+    }
+
+    if (ok)
+        *ok = (order.size() == m_ids.size());
+
+    return toNames(order);
+}
+
+QStringList ROSPackageGraph::transitiveDependencies(const QStringList &names) const
+{
+    QVector<int> ids = closure(names, m_dependencies);
+    QSet<QString> exclude = names.toSet();
+
+    QStringList result;
+    foreach (int i, ids)
+    {
+        if (!exclude.contains(m_names.at(i)))
+            result.append(m_names.at(i));
+    }
+    return result;
+}
+
+QStringList ROSPackageGraph::reverseDependencyClosure(const QStringList &names) const
+{
+    return toNames(closure(names, m_dependents));
+}
+
+QVector<int> ROSPackageGraph::closure(const QStringList &names, const QVector<QVector<int> > &edges) const
+{
+    QVector<bool> visited(m_names.size(), false);
+    QVector<int> result;
+    foreach (const QString &name, names)
+    {
+        int packageId = id(name);
+        if (packageId != -1 && !visited.at(packageId))
+        {
+            visited[packageId] = true;
+            result.append(packageId);
+        }
+    }
+
+    // The result doubles as the breadth first search queue
+    for (int i = 0; i < result.size(); ++i)
+    {
+        foreach (int next, edges.at(result.at(i)))
+        {
+            if (!visited.at(next))
+            {
+                visited[next] = true;
+                result.append(next);
+            }
+        }
+    }
+
+    return result;
+}
+
+QStringList ROSPackageGraph::toNames(const QVector<int> &ids) const
+{
+    QStringList names;
+    names.reserve(ids.size());
+    foreach (int i, ids)
+        names.append(m_names.at(i));
+
+    return names;
+}
+
+void ROSPackageGraph::setDependencies(int id, const QStringList &dependencyNames)
+{
+    // Remove the existing edges
+    foreach (int dependency, m_dependencies.at(id))
+        m_dependents[dependency].removeAll(id);
+
+    m_dependencies[id].clear();
+
+    // Dependencies outside the workspace are ignored
+    foreach (const QString &dependencyName, dependencyNames)
+    {
+        int dependency = this->id(dependencyName);
+        if (dependency == -1 || dependency == id)
+            continue;
+
+        m_dependencies[id].append(dependency);
+        m_dependents[dependency].append(id);
+    }
+}
+
+QStringList ROSPackageGraph::dependencyNames(const ROSUtils::PackageInfo &packageInfo)
+{
+    QStringList names = (packageInfo.buildDepends + packageInfo.buildExportDepends + packageInfo.testDepends).toSet().toList();
+    names.sort();
+    return names;
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
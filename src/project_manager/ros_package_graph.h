@@ -0,0 +1,111 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_PACKAGE_GRAPH_H
+#define ROS_PACKAGE_GRAPH_H
+
+#include "ros_utils.h"
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Dependency graph of the workspace packages
+ *
+ * Each package is assigned an id which indexes the adjacency arrays. Only dependencies
+ * on other workspace packages are stored (build, build export and test dependencies).
+ * Removed packages keep their id so the graph can be updated incrementally.
+ */
+class ROSPackageGraph
+{
+public:
+    ROSPackageGraph() {}
+
+    /**
+     * @brief Rebuild the graph from the workspace package information
+     * @param packageInfo Workspace package information
+     */
+    void build(const ROSUtils::PackageInfoMap &packageInfo);
+
+    /**
+     * @brief Update the graph, only packages which were added, removed or had their dependencies changed are modified.
+     * @param packageInfo Workspace package information
+     * @return True if the graph changed, otherwise false.
+     */
+    bool update(const ROSUtils::PackageInfoMap &packageInfo);
+
+    /**
+     * @brief Add or update a single package (ex. its package.xml changed)
+     * @param packageInfo Package information
+     */
+    void updatePackage(const ROSUtils::PackageInfo &packageInfo);
+
+    /**
+     * @brief Remove a package from the graph
+     * @param name Package name
+     */
+    void removePackage(const QString &name);
+
+    bool contains(const QString &name) const;
+    int id(const QString &name) const;
+    QString name(int id) const;
+    int size() const;
+
+    /** @brief Direct workspace dependencies of a package */
+    QStringList dependencies(const QString &name) const;
+
+    /** @brief Direct workspace dependents of a package */
+    QStringList dependents(const QString &name) const;
+
+    /**
+     * @brief Get the packages in dependency order (dependencies before dependents)
+     * @param ok Set to false if the graph contains a cycle, in which case the packages in the cycle are omitted
+     * @return Topologically ordered package names
+     */
+    QStringList topologicalOrder(bool *ok = nullptr) const;
+
+    /** @brief All packages the given packages depend on, directly or indirectly (excluding the given packages) */
+    QStringList transitiveDependencies(const QStringList &names) const;
+
+    /** @brief The given packages and all packages depending on them, directly or indirectly */
+    QStringList reverseDependencyClosure(const QStringList &names) const;
+
+private:
+    QVector<int> closure(const QStringList &names, const QVector<QVector<int> > &edges) const;
+    QStringList toNames(const QVector<int> &ids) const;
+    void setDependencies(int id, const QStringList &dependencyNames);
+    static QStringList dependencyNames(const ROSUtils::PackageInfo &packageInfo);
+
+    QHash<QString, int> m_ids;             /**< @brief Package name to id */
+    QVector<QString> m_names;              /**< @brief Package id to name, empty if removed */
+    QVector<QStringList> m_dependencyNames;/**< @brief Package dependencies as listed in the package.xml */
+    QVector<QVector<int> > m_dependencies; /**< @brief Package id to dependency ids */
+    QVector<QVector<int> > m_dependents;   /**< @brief Package id to dependent ids */
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_PACKAGE_GRAPH_H
@@ -26,13 +26,16 @@
 #include "ros_utils.h"
 
 #include <coreplugin/documentmanager.h>
+#include <coreplugin/editormanager/editormanager.h>
 #include <coreplugin/icontext.h>
 #include <coreplugin/icore.h>
+#include <coreplugin/messagemanager.h>
 #include <coreplugin/vcsmanager.h>
 #include <coreplugin/progressmanager/progressmanager.h>
 #include <cpptools/cpptoolsconstants.h>
 #include <cpptools/cppmodelmanager.h>
 #include <cpptools/projectinfo.h>
+#include <cpptools/projectfile.h>
 #include <cpptools/projectpartheaderpath.h>
 #include <extensionsystem/pluginmanager.h>
 #include <projectexplorer/abi.h>
@@ -40,6 +43,7 @@
 #include <projectexplorer/headerpath.h>
 #include <projectexplorer/kitinformation.h>
 #include <projectexplorer/kitmanager.h>
+#include <projectexplorer/toolchainmanager.h>
 #include <projectexplorer/projectexplorerconstants.h>
 #include <projectexplorer/buildmanager.h>
 #include <qtsupport/baseqtversion.h>
@@ -48,9 +52,11 @@
 #include <utils/fileutils.h>
 #include <utils/qtcassert.h>
 #include <utils/algorithm.h>
+#include <utils/runextensions.h>
 
 #include <QDir>
 #include <QProcessEnvironment>
+#include <QTimer>
 #include <QtXml/QDomDocument>
 
 #include <cpptools/cpprawprojectpart.h>
@@ -71,7 +77,8 @@ namespace Internal {
 ROSProject::ROSProject(const Utils::FileName &fileName) :
     ProjectExplorer::Project(Constants::ROS_MIME_TYPE, fileName, [this]() { refresh(); }),
     m_cppCodeModelUpdater(new CppTools::CppProjectUpdater(this)),
-    m_workspaceWatcher(new ROSWorkspaceWatcher(this))
+    m_workspaceWatcher(new ROSWorkspaceWatcher(this)),
+    m_launchFileChecker(new ROSLaunchFileChecker(this))
 {
     setId(Constants::ROS_PROJECT_ID);
     setProjectContext(Context(Constants::ROS_PROJECT_CONTEXT));
@@ -93,10 +100,43 @@ ROSProject::ROSProject(const Utils::FileName &fileName) :
 
     connect(m_workspaceWatcher, SIGNAL(fileListChanged()),
             this, SIGNAL(fileListChanged()));
+
+    connect(m_workspaceWatcher, &ROSWorkspaceWatcher::fileListChanged,
+            this, &ROSProject::checkLaunchFiles);
+
+    // Launch files may include other xml files, python nodes may be found in the package sources
+    connect(Core::EditorManager::instance(), &Core::EditorManager::saved, this, [this](Core::IDocument *document) {
+        const QString suffix = document->filePath().toFileInfo().suffix();
+        if (suffix == QLatin1String("launch") || suffix == QLatin1String("xml") || suffix == QLatin1String("py"))
+            checkLaunchFiles();
+    });
+
+    connect(&m_codeModelFutureWatcher, &QFutureWatcher<CodeModelRefreshInfo>::finished,
+            this, &ROSProject::refreshCppCodeModelFinished);
+
+    // The cached toolchain header paths are invalid if the kit or toolchain changes
+    connect(KitManager::instance(), &KitManager::kitUpdated,
+            this, &ROSProject::clearToolChainHeaderPaths);
+
+    connect(ToolChainManager::instance(), &ToolChainManager::toolChainUpdated,
+            this, &ROSProject::clearToolChainHeaderPaths);
+
+    // A refresh in progress may use a toolchain which changed or is about to be deleted
+    connect(KitManager::instance(), &KitManager::kitUpdated,
+            this, &ROSProject::restartCppCodeModelRefresh);
+
+    connect(KitManager::instance(), &KitManager::kitRemoved,
+            this, &ROSProject::restartCppCodeModelRefresh);
+
+    connect(ToolChainManager::instance(), &ToolChainManager::toolChainRemoved,
+            this, &ROSProject::restartCppCodeModelRefresh);
 }
 
 ROSProject::~ROSProject()
 {
+    m_codeModelFutureWatcher.cancel();
+    m_codeModelFutureWatcher.waitForFinished();
+
     delete m_cppCodeModelUpdater;
     m_cppCodeModelUpdater = nullptr;
 
@@ -140,31 +180,40 @@ void ROSProject::parseProjectFile()
     ROSUtils::parseQtCreatorWorkspaceFile(projectFilePath(), m_projectFileContent);
 }
 
-void ROSProject::update()
+ROSUtils::PackageInfoMap ROSProject::getPackageInfo() const
 {
-    ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(projectDirectory(), rosBuildConfiguration()->buildSystem(), distribution());
-    ROSBuildConfiguration *bc = rosBuildConfiguration();
-    m_wsPackageInfo = ROSUtils::getWorkspacePackageInfo(workspaceInfo, &m_wsPackageInfo);
-    m_wsPackageBuildInfo = ROSUtils::getWorkspacePackageBuildInfo(workspaceInfo, m_wsPackageInfo, &m_wsPackageBuildInfo);
+    return m_wsPackageInfo;
+}
 
-    if (m_wsPackageBuildInfo.isEmpty())
-        m_wsEnvironment = Utils::Environment(ROSUtils::getWorkspaceEnvironment(workspaceInfo).toStringList());
-    else
-        m_wsEnvironment = Utils::Environment(m_wsPackageBuildInfo.first().environment);
+ROSUtils::PackageBuildInfoMap ROSProject::getPackageBuildInfo() const
+{
+    return m_wsPackageBuildInfo;
+}
 
-    if (bc)
-        bc->updateQtEnvironment(m_wsEnvironment);
+const ROSPackageGraph &ROSProject::getPackageGraph() const
+{
+    return m_wsPackageGraph;
+}
 
+QStringList ROSProject::getChangedPaths() const
+{
+    return m_workspaceWatcher->getChangedPaths();
 }
 
-ROSUtils::PackageInfoMap ROSProject::getPackageInfo() const
+void ROSProject::removeChangedPaths(const QStringList &paths)
 {
-    return m_wsPackageInfo;
+    m_workspaceWatcher->removeChangedPaths(paths);
 }
 
-ROSUtils::PackageBuildInfoMap ROSProject::getPackageBuildInfo() const
+QMap<QString, QStringList> ROSProject::getPrecompiledHeaderCandidates() const
 {
-    return m_wsPackageBuildInfo;
+    return m_wsPrecompiledHeaderCandidates;
+}
+
+void ROSProject::updatePrecompiledHeaderCandidates()
+{
+    if (m_wsPrecompiledHeaderCandidates.isEmpty() && !m_codeModelFutureWatcher.isRunning())
+        refreshCppCodeModel();
 }
 
 void ROSProject::refresh()
@@ -223,8 +272,6 @@ void ROSProject::refresh()
 
 void ROSProject::refreshCppCodeModel()
 {
-    update();
-
     const Kit *k = nullptr;
 
     if (Target *target = activeTarget())
@@ -234,51 +281,200 @@ void ROSProject::refreshCppCodeModel()
 
     QTC_ASSERT(k, return);
 
-    const Utils::FileName sysRoot = SysRootKitInformation::sysRoot(k);
+    ROSBuildConfiguration *bc = rosBuildConfiguration();
+    QTC_ASSERT(bc, return);
 
+    // Cancel any refresh in progress, since its results are now outdated
+    m_codeModelFutureWatcher.cancel();
     m_cppCodeModelUpdater->cancel();
 
-    CppTools::ProjectPart::QtVersion activeQtVersion = CppTools::ProjectPart::NoQt;
+    if (m_toolChainHeaderPathsKitId != k->id())
+    {
+        clearToolChainHeaderPaths();
+        m_toolChainHeaderPathsKitId = k->id();
+    }
+
+    CodeModelRefreshInfo info;
+    info.workspaceInfo = ROSUtils::getWorkspaceInfo(projectDirectory(), bc->buildSystem(), distribution());
+    info.projectFilePath = projectFilePath().toString();
+    info.workspaceFiles = m_workspaceWatcher->getWorkspaceFiles();
+    info.cxxToolChain = ToolChainKitInformation::toolChain(k, ProjectExplorer::Constants::CXX_LANGUAGE_ID);
+    if (info.cxxToolChain)
+    {
+        // The runner does not reference the toolchain, so it can be used on the worker thread
+        info.headerPathsRunner = info.cxxToolChain->createSystemHeaderPathsRunner();
+        info.toolChainId = info.cxxToolChain->id();
+    }
+    info.kitId = k->id();
+    info.sysRoot = SysRootKitInformation::sysRoot(k);
+    info.precompiledHeaders = bc->precompiledHeaders();
+    info.packageInfo = m_wsPackageInfo;
+    info.packageBuildInfo = m_wsPackageBuildInfo;
+    info.toolChainHeaderPaths = m_toolChainHeaderPaths;
+    info.toolChainHeaderPathsGeneration = m_toolChainHeaderPathsGeneration;
+
     if (QtSupport::BaseQtVersion *qtVersion = QtSupport::QtKitInformation::qtVersion(k)) {
         if (qtVersion->qtVersion() <= QtSupport::QtVersionNumber(4,8,6))
-            activeQtVersion = CppTools::ProjectPart::Qt4_8_6AndOlder;
+            info.qtVersion = CppTools::ProjectPart::Qt4_8_6AndOlder;
         else if (qtVersion->qtVersion() < QtSupport::QtVersionNumber(5,0,0))
-            activeQtVersion = CppTools::ProjectPart::Qt4Latest;
+            info.qtVersion = CppTools::ProjectPart::Qt4Latest;
         else
-            activeQtVersion = CppTools::ProjectPart::Qt5;
+            info.qtVersion = CppTools::ProjectPart::Qt5;
+    }
+
+    QFuture<CodeModelRefreshInfo> future = Utils::runAsync(&ROSProject::refreshCppCodeModelAsync, info);
+    Core::ProgressManager::addTask(future,
+                                   tr("Reloading Project Build Info"),
+                                   Constants::ROS_RELOADING_BUILD_INFO);
+
+    m_codeModelFutureWatcher.setFuture(future);
+}
+
+void ROSProject::refreshCppCodeModelFinished()
+{
+    if (m_codeModelFutureWatcher.isCanceled() || m_codeModelFutureWatcher.future().resultCount() == 0)
+        return;
+
+    CodeModelRefreshInfo info = m_codeModelFutureWatcher.result();
+
+    // The kit may have changed while refreshing in which case the results are discarded
+    Kit *k = KitManager::kit(info.kitId);
+    if (!k || ToolChainKitInformation::toolChain(k, ProjectExplorer::Constants::CXX_LANGUAGE_ID) != info.cxxToolChain)
+        return;
+
+    m_wsPackageInfo = info.packageInfo;
+    m_wsPackageBuildInfo = info.packageBuildInfo;
+    m_wsPackageGraph.update(m_wsPackageInfo);
+    m_wsPrecompiledHeaderCandidates = info.precompiledHeaderCandidates;
+    m_wsEnvironment = Utils::Environment(info.environment);
+    // The cache was cleared while refreshing if the generation changed, the results are outdated
+    if (m_toolChainHeaderPathsKitId == info.kitId && m_toolChainHeaderPathsGeneration == info.toolChainHeaderPathsGeneration)
+        m_toolChainHeaderPaths = info.toolChainHeaderPaths;
+
+    if (ROSBuildConfiguration *bc = rosBuildConfiguration())
+        bc->updateQtEnvironment(m_wsEnvironment);
+
+    // The compiler flags are classified by the toolchain, which is only accessed on the GUI thread
+    if (info.cxxToolChain)
+    {
+        for (CppTools::RawProjectPart &rpp : info.rpps)
+            rpp.setFlagsForCxx({info.cxxToolChain, rpp.flagsForCxx.commandLineFlags});
+    }
+
+    m_cppCodeModelUpdater->update({this, nullptr, info.cxxToolChain, k, info.rpps});
+
+    if (!info.flagSetStatistics.isEmpty())
+        Core::MessageManager::write(info.flagSetStatistics, Core::MessageManager::Silent);
+
+    checkLaunchFiles();
+}
+
+void ROSProject::checkLaunchFiles()
+{
+    // The workspace environment is available after the first build info refresh
+    if (m_wsEnvironment.size() == 0)
+        return;
+
+    QStringList launchFiles;
+    foreach (const QString &file, m_workspaceWatcher->getWorkspaceFiles())
+    {
+        if (file.endsWith(QLatin1String(".launch")))
+            launchFiles.append(file);
     }
 
-    CppTools::RawProjectParts rpps;
+    m_launchFileChecker->check(launchFiles, m_wsEnvironment.toStringList());
+}
 
-    QStringList workspaceFiles = m_workspaceWatcher->getWorkspaceFiles();
+void ROSProject::refreshCppCodeModelAsync(QFutureInterface<CodeModelRefreshInfo> &fi, CodeModelRefreshInfo info)
+{
+    fi.setProgressRange(0, 100);
+
+    // Discover the workspace packages
+    fi.setProgressValueAndText(0, tr("Discovering packages"));
+    info.packageInfo = ROSUtils::getWorkspacePackageInfo(info.workspaceInfo, &info.packageInfo);
+    if (fi.isCanceled())
+        return;
+
+    // Source the workspace environment
+    fi.setProgressValueAndText(10, tr("Sourcing workspace environment"));
+    info.environment = ROSUtils::getWorkspaceEnvironment(info.workspaceInfo).toStringList();
+    if (fi.isCanceled())
+        return;
+
+    // Extract the package build information
+    fi.setProgressValueAndText(25, tr("Reading package build information"));
+    info.packageBuildInfo = ROSUtils::getWorkspacePackageBuildInfo(info.workspaceInfo, info.packageInfo, info.environment, &info.packageBuildInfo);
+    if (fi.isCanceled())
+        return;
+
+    // Reads every target source, so only done when precompiled headers are used
+    if (info.precompiledHeaders)
+    {
+        fi.setProgressValueAndText(50, tr("Finding precompiled header candidates"));
+        info.precompiledHeaderCandidates = ROSUtils::getPrecompiledHeaderCandidates(info.packageBuildInfo);
+        if (fi.isCanceled())
+            return;
+    }
 
-    ToolChain *cxxToolChain = ToolChainKitInformation::toolChain(k, ProjectExplorer::Constants::CXX_LANGUAGE_ID);
+    // Assemble the project parts
+    fi.setProgressValueAndText(60, tr("Creating project parts"));
 
-    foreach(ROSUtils::PackageBuildInfo buildInfo, m_wsPackageBuildInfo)
+    // Most targets share identical flag sets, so the define text and the toolchain
+    // header paths are only computed once per unique set.
+    QHash<QStringList, QByteArray> defineTable;
+    int defineLookups = 0;
+    int defineHits = 0;
+    int headerPathLookups = 0;
+    int headerPathHits = 0;
+    int cnt = 0;
+
+    foreach(ROSUtils::PackageBuildInfo buildInfo, info.packageBuildInfo)
     {
-        QStringList packgeFiles = workspaceFiles.filter(buildInfo.parent.path.toString() + QDir::separator());
+        if (fi.isCanceled())
+            return;
+
+        fi.setProgressValue(60 + (40 * cnt++) / info.packageBuildInfo.size());
+
+        QStringList packgeFiles = info.workspaceFiles.filter(buildInfo.parent.path.toString() + QDir::separator());
+        QStringList packageHeaders = Utils::filtered(packgeFiles, [](const QString &file) {
+            return CppTools::ProjectFile::isHeader(CppTools::ProjectFile::classify(file));
+        });
 
         foreach(ROSUtils::PackageTargetInfo targetInfo, buildInfo.targets)
         {
             CppTools::RawProjectPart rpp;
-            const QString defineArg
-                    = Utils::transform(targetInfo.defines, [](const QString &s) -> QString {
-                        QString result = QString::fromLatin1("#define ") + s;
-                        int assignIndex = result.indexOf('=');
-                        if (assignIndex != -1)
-                            result[assignIndex] = ' ';
-                        return result;
-                    }).join('\n');
-
-            rpp.setProjectFileLocation(projectFilePath().toString());
-            rpp.setBuildSystemTarget(buildInfo.parent.name + '|' + targetInfo.name + '|' + projectFilePath().toString());
+
+            ++defineLookups;
+            auto defineIt = defineTable.constFind(targetInfo.defines);
+            if (defineIt == defineTable.constEnd())
+            {
+                const QString defineArg
+                        = Utils::transform(targetInfo.defines, [](const QString &s) -> QString {
+                            QString result = QString::fromLatin1("#define ") + s;
+                            int assignIndex = result.indexOf('=');
+                            if (assignIndex != -1)
+                                result[assignIndex] = ' ';
+                            return result;
+                        }).join('\n');
+
+                defineIt = defineTable.insert(targetInfo.defines, defineArg.toUtf8());
+            }
+            else
+            {
+                ++defineHits;
+            }
+
+            rpp.setProjectFileLocation(info.projectFilePath);
+            rpp.setBuildSystemTarget(buildInfo.parent.name + '|' + targetInfo.name + '|' + info.projectFilePath);
             rpp.setDisplayName(buildInfo.parent.name + '|' + targetInfo.name);
-            rpp.setQtVersion(activeQtVersion);
-            rpp.setDefines(defineArg.toUtf8());
+            rpp.setQtVersion(info.qtVersion);
+            rpp.setDefines(defineIt.value());
 
-            QSet<QString> toolChainIncludes;
-            foreach (const HeaderPath &hp, cxxToolChain->systemHeaderPaths(targetInfo.flags, sysRoot))
-                toolChainIncludes.insert(hp.path());
+            bool cached = false;
+            const QSet<QString> &toolChainIncludes = toolChainHeaderPaths(info.toolChainHeaderPaths, info.headerPathsRunner, info.toolChainId, targetInfo.flags, info.sysRoot, cached);
+            ++headerPathLookups;
+            if (cached)
+                ++headerPathHits;
 
             QStringList includePaths;
             foreach (const QString &i, targetInfo.includes) {
@@ -287,13 +483,103 @@ void ROSProject::refreshCppCodeModel()
             }
 
             rpp.setIncludePaths(includePaths);
-            rpp.setFlagsForCxx({cxxToolChain, targetInfo.flags});
-            rpp.setFiles(packgeFiles);
-            rpps.append(rpp);
+            CppTools::RawProjectPartFlags cxxFlags;
+            cxxFlags.commandLineFlags = targetInfo.flags;
+            rpp.setFlagsForCxx(cxxFlags);
+
+            // The CMake file-api provides the exact target sources, otherwise use all package files
+            if (targetInfo.sources.isEmpty())
+                rpp.setFiles(packgeFiles);
+            else
+                rpp.setFiles(targetInfo.sources + packageHeaders);
+
+            info.rpps.append(rpp);
         }
     }
 
-    m_cppCodeModelUpdater->update({this, nullptr, cxxToolChain, k, rpps});
+    // Each rate is guarded on its own, a rate without lookups would be shown as nan%
+    QStringList rates;
+    if (defineLookups > 0)
+        rates << tr("define hit rate %1% (%2/%3)").arg(100.0 * defineHits / defineLookups, 0, 'f', 1).arg(defineHits).arg(defineLookups);
+
+    if (headerPathLookups > 0)
+        rates << tr("toolchain header path hit rate %1% (%2/%3)").arg(100.0 * headerPathHits / headerPathLookups, 0, 'f', 1).arg(headerPathHits).arg(headerPathLookups);
+
+    if (!rates.isEmpty())
+        info.flagSetStatistics = tr("Code model flag sets: %1").arg(rates.join(QLatin1String(", ")));
+
+    fi.setProgressValueAndText(100, info.flagSetStatistics);
+    fi.reportResult(info);
+}
+
+const QSet<QString> &ROSProject::toolChainHeaderPaths(QHash<QString, QSet<QString>> &cache,
+                                                      const ToolChain::SystemHeaderPathsRunner &headerPathsRunner,
+                                                      const QByteArray &toolChainId,
+                                                      const QStringList &flags,
+                                                      const Utils::FileName &sysRoot,
+                                                      bool &cached)
+{
+    // Only a few flags change the compiler's system include paths, so the others are
+    // dropped to maximize reuse between targets. The probe gets exactly the flags in the key.
+    QStringList relevantFlags;
+    for (int i = 0; i < flags.size(); ++i)
+    {
+        const QString &flag = flags.at(i);
+        if (flag.startsWith(QLatin1String("-std=")) ||
+            flag.startsWith(QLatin1String("-stdlib=")) ||
+            flag.startsWith(QLatin1String("-m")) ||
+            flag.startsWith(QLatin1String("-nostdinc")) ||
+            flag.startsWith(QLatin1String("--sysroot")) ||
+            flag.startsWith(QLatin1String("-target")) ||
+            flag.startsWith(QLatin1String("--target")) ||
+            flag.startsWith(QLatin1String("--gcc-toolchain")))
+        {
+            relevantFlags.append(flag);
+        }
+        else if (flag.startsWith(QLatin1String("-isystem")) ||
+                 flag.startsWith(QLatin1String("-idirafter")) ||
+                 flag.startsWith(QLatin1String("-isysroot")))
+        {
+            // The path may be the next argument
+            relevantFlags.append(flag);
+            if ((flag == QLatin1String("-isystem") || flag == QLatin1String("-idirafter") || flag == QLatin1String("-isysroot")) && i + 1 < flags.size())
+                relevantFlags.append(flags.at(++i));
+        }
+    }
+
+    QString key = QString::fromUtf8(toolChainId) + QLatin1Char('|') + sysRoot.toString() + QLatin1Char('|') + relevantFlags.join(QLatin1Char(' '));
+
+    auto it = cache.constFind(key);
+    cached = (it != cache.constEnd());
+    if (!cached)
+    {
+        QSet<QString> headerPaths;
+        if (headerPathsRunner)
+        {
+            foreach (const HeaderPath &hp, headerPathsRunner(relevantFlags, sysRoot.toString()))
+                headerPaths.insert(hp.path());
+        }
+
+        it = cache.insert(key, headerPaths);
+    }
+
+    return it.value();
+}
+
+void ROSProject::clearToolChainHeaderPaths()
+{
+    m_toolChainHeaderPaths.clear();
+    ++m_toolChainHeaderPathsGeneration;
+}
+
+void ROSProject::restartCppCodeModelRefresh()
+{
+    if (!m_codeModelFutureWatcher.isRunning())
+        return;
+
+    // Restarted once the kits and toolchains finished changing
+    m_codeModelFutureWatcher.cancel();
+    QTimer::singleShot(0, this, &ROSProject::refreshCppCodeModel);
 }
 
 QStringList ROSProject::files(FilesMode fileMode) const
@@ -338,6 +624,11 @@ void ROSProject::repositoryChanged(const QString &repository)
 void ROSProject::buildQueueFinished(bool success)
 {
     Q_UNUSED(success);
+
+    // The build may have added or removed executables
+    ROSUtils::clearExecutableIndex();
+    checkLaunchFiles();
+
     refreshCppCodeModel();
 }
 
@@ -23,6 +23,8 @@
 
 
 #include "ros_workspace_watcher.h"
+#include "ros_package_graph.h"
+#include "ros_launch_file_checker.h"
 #include "ros_project_manager.h"
 #include "ros_project_nodes.h"
 #include "ros_project_plugin.h"
@@ -35,8 +37,14 @@
 #include <projectexplorer/buildconfiguration.h>
 #include <coreplugin/idocument.h>
 
+#include <cpptools/cpprawprojectpart.h>
+#include <cpptools/projectpart.h>
+
 #include <QFuture>
+#include <QHash>
+#include <QSet>
 #include <QFutureInterface>
+#include <QFutureWatcher>
 
 namespace CppTools {
     class CppProjectUpdater;
@@ -69,6 +77,17 @@ public:
 
     ROSUtils::PackageInfoMap getPackageInfo() const;
     ROSUtils::PackageBuildInfoMap getPackageBuildInfo() const;
+    const ROSPackageGraph &getPackageGraph() const;
+    QStringList getChangedPaths() const;
+
+    /** @brief Remove paths which were built, paths changed since the build started are kept */
+    void removeChangedPaths(const QStringList &paths);
+
+    /** @brief Precompiled header candidates of each target, found by the build info refresh */
+    QMap<QString, QStringList> getPrecompiledHeaderCandidates() const;
+
+    /** @brief Refresh the build info if the precompiled header candidates were not searched yet */
+    void updatePrecompiledHeaderCandidates();
 
 public slots:
     void buildQueueFinished(bool success);
@@ -79,19 +98,64 @@ protected:
 private:
     bool saveProjectFile();
     void parseProjectFile();
+    void checkLaunchFiles();
+
+    /** @brief Data passed to and returned from the background code model refresh */
+    struct CodeModelRefreshInfo {
+        // Inputs
+        ROSUtils::WorkspaceInfo workspaceInfo;
+        QString projectFilePath;
+        QStringList workspaceFiles;
+        CppTools::ProjectPart::QtVersion qtVersion = CppTools::ProjectPart::NoQt;
+        ProjectExplorer::ToolChain *cxxToolChain = nullptr; /**< @brief Only used on the GUI thread, it may be deleted while refreshing */
+        ProjectExplorer::ToolChain::SystemHeaderPathsRunner headerPathsRunner;
+        QByteArray toolChainId;
+        int toolChainHeaderPathsGeneration = 0;
+        Core::Id kitId;
+        Utils::FileName sysRoot;
+        bool precompiledHeaders = false;
+
+        // Inputs which are updated by the refresh
+        ROSUtils::PackageInfoMap packageInfo;
+        ROSUtils::PackageBuildInfoMap packageBuildInfo;
+        QHash<QString, QSet<QString>> toolChainHeaderPaths;
+
+        // Outputs
+        QStringList environment;
+        CppTools::RawProjectParts rpps;
+        QMap<QString, QStringList> precompiledHeaderCandidates;
+        QString flagSetStatistics; /**< @brief Define and header path cache hit rates shown in General Messages */
+    };
 
-    void update();
     void refreshCppCodeModel();
+    void refreshCppCodeModelFinished();
     void repositoryChanged(const QString &repository);
+    void clearToolChainHeaderPaths();
+    void restartCppCodeModelRefresh();
+
+    static void refreshCppCodeModelAsync(QFutureInterface<CodeModelRefreshInfo> &fi, CodeModelRefreshInfo info);
+    static const QSet<QString> &toolChainHeaderPaths(QHash<QString, QSet<QString>> &cache,
+                                                     const ProjectExplorer::ToolChain::SystemHeaderPathsRunner &headerPathsRunner,
+                                                     const QByteArray &toolChainId,
+                                                     const QStringList &flags,
+                                                     const Utils::FileName &sysRoot,
+                                                     bool &cached);
 
     ROSUtils::ROSProjectFileContent m_projectFileContent;
     QFutureInterface<void>         *m_projectFutureInterface = nullptr;
     ROSUtils::PackageInfoMap        m_wsPackageInfo;
     ROSUtils::PackageBuildInfoMap   m_wsPackageBuildInfo;
+    ROSPackageGraph                 m_wsPackageGraph;
+    QMap<QString, QStringList>      m_wsPrecompiledHeaderCandidates;
     Utils::Environment              m_wsEnvironment;
+    QHash<QString, QSet<QString>>   m_toolChainHeaderPaths;
+    Core::Id                        m_toolChainHeaderPathsKitId;
+    int                             m_toolChainHeaderPathsGeneration = 0; /**< @brief Incremented when the cache is cleared */
 
     CppTools::CppProjectUpdater *m_cppCodeModelUpdater;
+    QFutureWatcher<CodeModelRefreshInfo> m_codeModelFutureWatcher;
     ROSWorkspaceWatcher         *m_workspaceWatcher;
+    ROSLaunchFileChecker        *m_launchFileChecker;
 };
 
 } // namespace Internal
@@ -34,6 +34,7 @@ const char ROS_MIME_TYPE[]    = "application/ros.project";
 // Tasks
 const char ROS_READING_PROJECT[] = "ROSProjectManager.ReadingProject";
 const char ROS_RELOADING_BUILD_INFO[] = "ROSProjectManager.ReloadingBuildInfo";
+const char ROS_TASK_CATEGORY_LAUNCH[] = "ROSProjectManager.Task.Category.Launch";
 
 
 // ROS default install directory
@@ -43,6 +44,7 @@ const char ROS_INSTALL_DIRECTORY[] = "/opt/ros";
 const char ROS_RELOAD_BUILD_INFO[] = "ROSProjectManager.reloadProjectBuildInfo";
 const char ROS_REMOVE_DIR[] = "ROSProjectManager.removeDirectory";
 const char ROS_RENAME_FILE[] = "ROSProjectManager.renameFile";
+const char ROS_SHOW_BUILD_PROFILE[] = "ROSProjectManager.showBuildProfile";
 
 // ROS wizards constants
 const char ROS_WIZARD_CATEGORY[] = "A.ROS";
@@ -42,6 +42,10 @@ ROSManager::ROSManager()
   m_instance = this;
   m_terminalPane = new ROSTerminalPane();
   ExtensionSystem::PluginManager::addObject(m_terminalPane);
+
+  m_logStore = new ROSLogStore(1000000, 32 * 1024 * 1024, this);
+  m_logPane = new ROSLogPane(m_logStore);
+  ExtensionSystem::PluginManager::addObject(m_logPane);
 }
 
 ROSManager::~ROSManager()
@@ -49,6 +53,8 @@ ROSManager::~ROSManager()
   m_instance = 0;
   ExtensionSystem::PluginManager::removeObject(m_terminalPane);
   delete m_terminalPane;
+  ExtensionSystem::PluginManager::removeObject(m_logPane);
+  delete m_logPane;
 }
 
 ROSManager *ROSManager::instance()
@@ -61,5 +67,10 @@ QTermWidget &ROSManager::startTerminal(int startnow, const QString name)
   return m_terminalPane->startTerminal(startnow, name);
 }
 
+ROSLogStore *ROSManager::logStore() const
+{
+  return m_logStore;
+}
+
 } // namespace Internal
 } // namespace ROSProjectManager
@@ -23,6 +23,7 @@
 
 #include "ros_project_constants.h"
 #include "ros_terminal_pane.h"
+#include "ros_log_pane.h"
 #include <projectexplorer/processparameters.h>
 #include <qtermwidget5/qtermwidget.h>
 
@@ -43,8 +44,13 @@ public:
 
     QTermWidget &startTerminal(int startnow = 1, const QString name = QString());
 
+    /** @brief Structured log of the run step output */
+    ROSLogStore *logStore() const;
+
 private:
     ROSTerminalPane *m_terminalPane;
+    ROSLogStore *m_logStore;
+    ROSLogPane *m_logPane;
 
 };
 
@@ -33,6 +33,7 @@
 #include "ros_project_constants.h"
 #include "ros_package_wizard.h"
 #include "remove_directory_dialog.h"
+#include "ros_build_profile_dialog.h"
 
 #include <coreplugin/icore.h>
 #include <coreplugin/actionmanager/actionmanager.h>
@@ -61,6 +62,7 @@
 #include <projectexplorer/compileoutputwindow.h>
 #include <projectexplorer/appoutputpane.h>
 #include <projectexplorer/projecttreewidget.h>
+#include <projectexplorer/taskhub.h>
 
 #include <extensionsystem/pluginmanager.h>
 #include <extensionsystem/invoker.h>
@@ -106,6 +108,8 @@ bool ROSProjectPlugin::initialize(const QStringList &, QString *errorMessage)
 
     ProjectManager::registerProjectType<ROSProject>(Constants::ROS_MIME_TYPE);
 
+    TaskHub::addCategory(Constants::ROS_TASK_CATEGORY_LAUNCH, tr("ROS Launch Files"));
+
     IWizardFactory::registerFactoryCreator([]() { return QList<IWizardFactory *>() << new ROSProjectWizard << new ROSPackageWizard; });
 
     ActionContainer *mproject = ActionManager::actionContainer(ProjectExplorer::Constants::M_PROJECTCONTEXT);
@@ -119,6 +123,15 @@ bool ROSProjectPlugin::initialize(const QStringList &, QString *errorMessage)
      mproject->addAction(reloadCommand, ProjectExplorer::Constants::G_PROJECT_FILES);
      connect(reloadProjectBuildInfoAction, &QAction::triggered, this, &ROSProjectPlugin::reloadProjectBuildInfo);
 
+     auto showBuildProfileAction = new QAction(tr("Show Build Profile..."), this);
+     Command *showBuildProfileCommand = ActionManager::registerAction(showBuildProfileAction,
+                                                                      Constants::ROS_SHOW_BUILD_PROFILE,
+                                                                      Context(Constants::ROS_PROJECT_CONTEXT));
+
+     showBuildProfileCommand->setAttribute(Command::CA_Hide);
+     mproject->addAction(showBuildProfileCommand, ProjectExplorer::Constants::G_PROJECT_FILES);
+     connect(showBuildProfileAction, &QAction::triggered, this, &ROSProjectPlugin::showBuildProfile);
+
     // This will context menu action for deleting and renaming project folders from the ProjectTree.
     ActionContainer *mfolderContextMenu = ActionManager::actionContainer(ProjectExplorer::Constants::M_FOLDERCONTEXT);
 
@@ -192,25 +205,30 @@ void ROSProjectPlugin::createCppCodeStyle()
 
 void ROSProjectPlugin::reloadProjectBuildInfo()
 {
-    QFutureInterface<void> f;
-
-    f.setProgressRange(0, 100);
-    Core::ProgressManager::addTask(f.future(),
-                                   tr("Reloading Project Build Info"),
-                                   Constants::ROS_RELOADING_BUILD_INFO);
-
-    f.reportStarted();
+    // The project reports the staged progress of the refresh itself
     ROSProject *rosProject = qobject_cast<ROSProject *>(ProjectTree::currentProject());
-    if (rosProject) {
+    if (rosProject)
         rosProject->refreshCppCodeModel();
-        f.setProgressValue(100);
-        f.reportFinished();
+}
+
+void ROSProjectPlugin::showBuildProfile()
+{
+    ROSProject *rosProject = qobject_cast<ROSProject *>(ProjectTree::currentProject());
+    if (!rosProject || !rosProject->rosBuildConfiguration())
+        return;
+
+    ROSBuildConfiguration *bc = rosProject->rosBuildConfiguration();
+    ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(rosProject->projectDirectory(), bc->buildSystem(), rosProject->distribution());
+    ROSBuildProfiler::ProfileList profiles = ROSBuildProfiler::loadProfiles(workspaceInfo.buildPath);
+    if (profiles.isEmpty())
+    {
+        QMessageBox::information(ICore::mainWindow(), tr("Build Profile"),
+                                 tr("No build profile was found, build the workspace to record one."));
         return;
     }
 
-    f.reportCanceled();
-    f.reportFinished();
-    return;
+    ROSBuildProfileDialog dialog(profiles, rosProject->getPackageGraph(), ICore::mainWindow());
+    dialog.exec();
 }
 
 void ROSProjectPlugin::removeProjectDirectory()
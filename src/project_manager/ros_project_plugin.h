@@ -51,6 +51,11 @@ private slots:
      */
     void reloadProjectBuildInfo();
 
+    /**
+     * @brief This will show the package timeline of the recent builds.
+     */
+    void showBuildProfile();
+
     /**
      * @brief This will remove the selected FolderNode in the project tree.
      */
@@ -22,6 +22,9 @@
 #include "ros_project.h"
 #include "ros_run_steps_page.h"
 #include "ros_run_steps.h"
+#include "ros_build_configuration.h"
+#include "ros_utils.h"
+#include "ros_project_manager.h"
 #include "ui_ros_run_configuration.h"
 
 #include <coreplugin/editormanager/editormanager.h>
@@ -34,6 +37,7 @@
 #include <projectexplorer/projectexplorericons.h>
 #include <projectexplorer/buildstepspage.h>
 #include <projectexplorer/runnables.h>
+#include <projectexplorer/projectexplorerconstants.h>
 #include <debugger/debuggerengine.h>
 
 #include <qtsupport/qtkitinformation.h>
@@ -260,78 +264,168 @@ bool ROSRunConfigurationFactory::canHandle(ProjectExplorer::Target *parent) cons
 ////////////////////////////////////
 /// ROSRunWorker
 ////////////////////////////////////
-ROSRunWorker::ROSRunWorker(RunControl *runControl) : RunWorker(runControl)
+void connectRunSupervisorOutput(ROSRunSupervisor *supervisor, RunWorker *worker)
 {
-    setDisplayName("RosRunWorker");
+    QObject::connect(supervisor, &ROSRunSupervisor::processStarted, worker, [worker](const QString &name, qint64 pid) {
+        worker->appendMessage(ROSRunWorker::tr("Started %1 (process %2)\n").arg(name).arg(pid), Utils::NormalMessageFormat);
+    });
+
+    QObject::connect(supervisor, &ROSRunSupervisor::output, worker, [worker](const QString &name, qint64 pid, const QString &text, bool isError) {
+        worker->appendMessage(text, isError ? Utils::StdErrFormat : Utils::StdOutFormat);
+        ROSManager::instance()->logStore()->addOutput(name, pid, text, isError);
+    });
+
+    QObject::connect(supervisor, &ROSRunSupervisor::processFinished, worker, [worker](const QString &name, qint64 pid, int exitCode, bool crashed) {
+        ROSManager::instance()->logStore()->flush(name, pid);
+        if (crashed)
+            worker->appendMessage(ROSRunWorker::tr("%1 (process %2) crashed\n").arg(name).arg(pid), Utils::ErrorMessageFormat);
+        else
+            worker->appendMessage(ROSRunWorker::tr("%1 (process %2) exited with code %3\n").arg(name).arg(pid).arg(exitCode),
+                                  exitCode == 0 ? Utils::NormalMessageFormat : Utils::ErrorMessageFormat);
+    });
 }
 
-void ROSRunWorker::start()
+static void connectRunStepSchedulerOutput(ROSRunStepScheduler *scheduler, RunWorker *worker)
+{
+    QObject::connect(scheduler, &ROSRunStepScheduler::message, worker, [worker](const QString &text, bool isError) {
+        worker->appendMessage(text + QLatin1Char('\n'), isError ? Utils::ErrorMessageFormat : Utils::NormalMessageFormat);
+    });
+}
+
+static QList<RunStep *> enabledRunSteps(RunStepList *stepList)
 {
-    foreach(RunStep *rs, qobject_cast<ROSRunConfiguration *>(runControl()->runConfiguration())->stepList()->steps())
+    QList<RunStep *> steps;
+    foreach(RunStep *rs, stepList->steps())
     {
         if (rs->enabled() == true && rs->id() != ROSProjectManager::Constants::ROS_ATTACH_TO_NODE_ID)
-        {
-            rs->run();
-        }
+            steps.append(rs);
     }
+    return steps;
+}
+
+ROSRunWorker::ROSRunWorker(RunControl *runControl) : RunWorker(runControl),
+    m_scheduler(&m_supervisor)
+{
+    setDisplayName("RosRunWorker");
+
+    connectRunSupervisorOutput(&m_supervisor, this);
+    connectRunStepSchedulerOutput(&m_scheduler, this);
+    connect(&m_supervisor, &ROSRunSupervisor::finished, this, &ROSRunWorker::reportStoppedIfDone);
+    connect(&m_scheduler, &ROSRunStepScheduler::finished, this, &ROSRunWorker::reportStoppedIfDone);
+}
+
+void ROSRunWorker::start()
+{
+    m_scheduler.start(enabledRunSteps(qobject_cast<ROSRunConfiguration *>(runControl()->runConfiguration())->stepList()));
+
+    reportStarted();
+    reportStoppedIfDone();
+}
+
+void ROSRunWorker::stop()
+{
+    m_scheduler.cancel();
+    if (m_supervisor.isRunning())
+        m_supervisor.stop();
+    else
+        reportStopped();
+}
+
+void ROSRunWorker::reportStoppedIfDone()
+{
+    // Steps run in a terminal are not tracked, the run is done once they are started
+    if (!m_scheduler.isRunning() && !m_supervisor.isRunning())
+        reportStopped();
 }
 
 ////////////////////////////////////
 /// ROSDebugRunWorker
 ////////////////////////////////////
 
-ROSDebugRunWorker::ROSDebugRunWorker(RunControl *runControl) : Debugger::DebuggerRunTool(runControl)
+ROSDebugRunWorker::ROSDebugRunWorker(RunControl *runControl) : Debugger::DebuggerRunTool(runControl),
+    m_scheduler(&m_supervisor)
 {
     setDisplayName("RosDebugRunWorker");
 
-    connect(&m_timer, &QTimer::timeout,
-    this, &ROSDebugRunWorker::findProcess);
+    connect(&m_watcher, &ROSExecWatcher::processStarted,
+            this, &ROSDebugRunWorker::processStarted);
+
+    connect(&m_watcher, &ROSExecWatcher::timedOut, this, [this]() {
+        QStringList missing;
+        for (auto it = m_expectedInstances.constBegin(); it != m_expectedInstances.constEnd(); ++it)
+        {
+            int attached = m_attachedInstances.value(it.key());
+            if (attached < it.value())
+                missing << tr("%1 (%2 of %3 found)").arg(QFileInfo(it.key()).fileName()).arg(attached).arg(it.value());
+        }
+        missing.sort();
+        appendMessage(tr("Timed out waiting for %1 to start.\n").arg(missing.join(QLatin1String(", "))), Utils::ErrorMessageFormat);
+    });
 
     connect(this, &ROSDebugRunWorker::stopped,
-            &m_timer, &QTimer::stop);
+            &m_watcher, &ROSExecWatcher::stop);
+
+    // The nodes are stopped with the debugger
+    connectRunSupervisorOutput(&m_supervisor, this);
+    connectRunStepSchedulerOutput(&m_scheduler, this);
+    connect(this, &ROSDebugRunWorker::stopped, &m_supervisor, [this]() {
+        m_scheduler.cancel();
+        m_supervisor.stop();
+    });
 }
 
 void ROSDebugRunWorker::start()
 {
+    ROSRunConfiguration *rc = qobject_cast<ROSRunConfiguration *>(runControl()->runConfiguration());
+    ROSProject *rp = qobject_cast<ROSProject *>(rc->target()->project());
+
+    m_debugTargets.clear();
+    m_expectedInstances.clear();
+    m_attachedInstances.clear();
+    m_primaryStarted = false;
+
     bool found = false;
-    foreach(RunStep *rs,  qobject_cast<ROSRunConfiguration *>(runControl()->runConfiguration())->stepList()->steps())
+    foreach(RunStep *rs, rc->stepList()->steps())
     {
         if (rs->enabled() == true && rs->id() == Constants::ROS_ATTACH_TO_NODE_ID)
         {
             found = true;
-            m_debugContinueOnAttach = qobject_cast<ROSGenericRunStep *>(rs)->getDebugContinueOnAttach();
-            m_debugTargetPath = qobject_cast<ROSGenericRunStep *>(rs)->getTargetPath();
-            if (QFileInfo(m_debugTargetPath).exists())
+            ROSGenericRunStep *attachStep = qobject_cast<ROSGenericRunStep *>(rs);
+
+            AttachOptions options;
+            options.continueOnAttach = attachStep->getDebugContinueOnAttach();
+            options.stopAtEntry = attachStep->getDebugStopAtEntry();
+
+            QStringList targetPaths;
+            if (attachStep->getDebugAllLaunchNodes())
             {
-                m_timeElapsed = 0;
-                m_timer.start(10);
+                // Every node of the enabled launch steps
+                QStringList env = rp->rosBuildConfiguration()->environment().toStringList();
+                foreach(RunStep *launchStep, rc->stepList()->steps())
+                {
+                    ROSGenericRunStep *genericStep = qobject_cast<ROSGenericRunStep *>(launchStep);
+                    if (launchStep->enabled() == true && launchStep->id() == Constants::ROS_LAUNCH_ID)
+                        targetPaths << ROSUtils::getLaunchFileNodes(genericStep->getTargetPath(), env, genericStep->getArguments()).values();
+                }
             }
             else
             {
-                QMessageBox msg;
-                msg.setWindowTitle("Debugging Catkin Workspace");
-                msg.setTextFormat(Qt::RichText);
-                msg.setWindowFlags(Qt::WindowStaysOnTopHint);
-                msg.setText("The <b><i>ROS Attach to Node</b></i> Run Step is not complete! Please verify information and try again.");
-                msg.exec();
-                return;
+                targetPaths << attachStep->getTargetPath();
             }
 
-        }
-    }
-
-    if (found)
-    {
-        // Now that the watcher is started run all of the other steps
-        foreach(RunStep *rs, qobject_cast<ROSRunConfiguration *>(runControl()->runConfiguration())->stepList()->steps())
-        {
-            if (rs->enabled() == true && rs->id() != ROSProjectManager::Constants::ROS_ATTACH_TO_NODE_ID)
+            // Launch files may start several nodes from the same executable
+            foreach (const QString &targetPath, targetPaths)
             {
-                rs->run();
+                if (QFileInfo(targetPath).exists())
+                {
+                    m_debugTargets.insert(targetPath, options);
+                    ++m_expectedInstances[targetPath];
+                }
             }
         }
     }
-    else
+
+    if (!found)
     {
         QMessageBox msg;
         msg.setWindowTitle("Debugging Catkin Workspace");
@@ -341,42 +435,139 @@ void ROSDebugRunWorker::start()
         msg.exec();
         return;
     }
+
+    if (m_debugTargets.isEmpty())
+    {
+        QMessageBox msg;
+        msg.setWindowTitle("Debugging Catkin Workspace");
+        msg.setTextFormat(Qt::RichText);
+        msg.setWindowFlags(Qt::WindowStaysOnTopHint);
+        msg.setText("The <b><i>ROS Attach to Node</b></i> Run Step is not complete! Please verify information and try again.");
+        msg.exec();
+        return;
+    }
+
+    QStringList stopAtEntryTargets;
+    for (auto it = m_debugTargets.constBegin(); it != m_debugTargets.constEnd(); ++it)
+    {
+        if (!it.value().stopAtEntry)
+            continue;
+
+        // The launch prefix compares its argument as is, list the path as found and as resolved
+        QFileInfo info(it.key());
+        stopAtEntryTargets << it.key() << info.absoluteFilePath() << info.canonicalFilePath();
+    }
+    stopAtEntryTargets.removeAll(QString());
+    stopAtEntryTargets.removeDuplicates();
+
+    m_debugLaunchPrefix.clear();
+    if (!stopAtEntryTargets.isEmpty())
+    {
+        ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(rp->projectDirectory(), rp->rosBuildConfiguration()->buildSystem(), rp->distribution());
+        Utils::FileName wrapperPath;
+        if (ROSUtils::writeStopAtExecWrapper(workspaceInfo.buildPath, wrapperPath))
+            m_debugLaunchPrefix = wrapperPath.toString();
+        else
+            appendMessage(tr("Failed to write the launch prefix, attaching once the nodes are found.\n"), Utils::ErrorMessageFormat);
+    }
+
+    // One watcher for all of the nodes, allow 30sec to start them
+    m_watcher.setTargets(m_debugTargets.keys());
+    m_watcher.setLaunchWrapper(m_debugLaunchPrefix);
+    m_watcher.start(30000);
+
+    // Now that the watcher is started run all of the other steps
+    m_scheduler.setLaunchPrefix(m_debugLaunchPrefix, stopAtEntryTargets);
+    m_scheduler.start(enabledRunSteps(rc->stepList()));
+}
+
+void ROSDebugRunWorker::processStarted(qint64 pid, const QString &executable, qint64 latency)
+{
+    QString method = (m_watcher.method() == ROSExecWatcher::ProcConnector) ? tr("exec event") : tr("process scan");
+    bool launchPrefix = m_watcher.isLaunchWrapper(pid);
+
+    // Keep watching until every instance of every node was found
+    ++m_attachedInstances[executable];
+    bool allFound = true;
+    for (auto it = m_expectedInstances.constBegin(); allFound && it != m_expectedInstances.constEnd(); ++it)
+        allFound = (m_attachedInstances.value(it.key()) >= it.value());
+
+    if (allFound)
+        m_watcher.stop();
+
+    if (latency >= 0)
+        appendMessage(tr("Found %1 (process %2) by %3, %4 ms after it started.\n").arg(QFileInfo(executable).fileName()).arg(pid).arg(method).arg(latency), Utils::NormalMessageFormat);
+
+    // Launch files without the launch prefix start the node directly
+    if (launchPrefix)
+        waitForEntryStop(pid, executable, 1000);
+    else
+        pidFound(pid, executable, false);
+}
+
+void ROSDebugRunWorker::waitForEntryStop(qint64 pid, const QString &executable, int attempts)
+{
+    // The launch prefix stops itself right after it starts, attaching before that would report its SIGSTOP
+    if (ROSExecWatcher::isProcessStopped(pid) || attempts <= 0)
+    {
+        pidFound(pid, executable, true);
+        return;
+    }
+
+    QTimer::singleShot(1, this, [this, pid, executable, attempts]() {
+        waitForEntryStop(pid, executable, attempts - 1);
+    });
 }
 
-void ROSDebugRunWorker::pidFound(ProjectExplorer::DeviceProcessItem process)
+void ROSDebugRunWorker::pidFound(qint64 pid, const QString &executable, bool launchPrefix)
 {
-    m_timer.stop();
     Debugger::Internal::DebuggerRunParameters rp;
-    rp.attachPID = Utils::ProcessHandle(process.pid);
-    rp.displayName = tr("Process %1").arg(process.pid);
-    rp.inferior.executable = process.exe;
+    rp.attachPID = Utils::ProcessHandle(pid);
+    rp.displayName = tr("%1 (Process %2)").arg(QFileInfo(executable).fileName()).arg(pid);
     rp.startMode = Debugger::AttachExternal;
     rp.closeMode = Debugger::DetachAtClose;
-    rp.continueAfterAttach = m_debugContinueOnAttach;
+    rp.continueAfterAttach = m_debugTargets.value(executable).continueOnAttach;
+    if (launchPrefix)
+    {
+        // The process is still the launch prefix, the debugger follows it into the node.
+        // It has to continue to execute the node, stop in the node's main instead.
+        rp.breakOnMain = !rp.continueAfterAttach;
+        rp.continueAfterAttach = true;
+    }
+    else
+    {
+        rp.inferior.executable = executable;
+    }
 
-    setRunParameters(rp);
-    DebuggerRunTool::start();
+    if (!m_primaryStarted)
+    {
+        m_primaryStarted = true;
+        setRunParameters(rp);
+        DebuggerRunTool::start();
+        return;
+    }
+
+    // Each additional node gets its own debugger
+    RunControl *runControl = new RunControl(this->runControl()->runConfiguration(), ProjectExplorer::Constants::DEBUG_RUN_MODE);
+    new ROSAttachRunWorker(runControl, rp);
+    ProjectExplorerPlugin::startRunControl(runControl);
 }
 
-void ROSDebugRunWorker::findProcess()
+////////////////////////////////////
+/// ROSAttachRunWorker
+////////////////////////////////////
+
+ROSAttachRunWorker::ROSAttachRunWorker(RunControl *runControl, const Debugger::Internal::DebuggerRunParameters &rp) :
+    Debugger::DebuggerRunTool(runControl),
+    m_runParameters(rp)
 {
-    m_timeElapsed += 10;
-    const QString &appName = Utils::FileUtils::normalizePathName(m_debugTargetPath);
-    ProjectExplorer::DeviceProcessItem fallback;
-    foreach (const ProjectExplorer::DeviceProcessItem &p, ProjectExplorer::DeviceProcessList::localProcesses()) {
-        if (Utils::FileUtils::normalizePathName(p.exe) == appName) {
-            pidFound(p);
-            return;
-        }
-        if (p.cmdLine.startsWith(appName))
-            fallback = p;
-    }
-    if (fallback.pid != 0)
-        pidFound(fallback);
+    setDisplayName("RosAttachRunWorker");
+}
 
-    // Make sure this does not run indefinitely. Allow 30sec to start the process.
-    if (m_timeElapsed >= 30000)
-        m_timer.stop();
+void ROSAttachRunWorker::start()
+{
+    setRunParameters(m_runParameters);
+    DebuggerRunTool::start();
 }
 
 } // namespace Internal
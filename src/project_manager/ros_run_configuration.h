@@ -22,17 +22,23 @@
 #define ROS_RUN_CONFIGURATION_H
 
 #include "ros_run_step.h"
+#include "ros_exec_watcher.h"
+#include "ros_run_supervisor.h"
+#include "ros_run_step_scheduler.h"
 #include "ros_project_constants.h"
 #include <projectexplorer/runconfiguration.h>
 #include <projectexplorer/buildstep.h>
 #include <projectexplorer/devicesupport/deviceprocesslist.h>
 #include <debugger/debuggerruncontrol.h>
+#include <debugger/debuggerengine.h>
 
 #include <QPointer>
 #include <QMenu>
 #include <QFutureInterface>
 #include <QFutureWatcher>
 #include <QTimer>
+#include <QMap>
+#include <QHash>
 
 QT_FORWARD_DECLARE_CLASS(QStringListModel)
 
@@ -119,8 +125,24 @@ class ROSRunWorker : public ProjectExplorer::RunWorker
 public:
     explicit ROSRunWorker(ProjectExplorer::RunControl *runControl);
     void start() override;
+    void stop() override;
+
+private:
+    void reportStoppedIfDone();
+
+    ROSRunSupervisor m_supervisor;
+    ROSRunStepScheduler m_scheduler;
 };
 
+/** @brief Show the output and exit status of the supervised run step processes in a run worker's output */
+void connectRunSupervisorOutput(ROSRunSupervisor *supervisor, ProjectExplorer::RunWorker *worker);
+
+/**
+ * @brief Attaches a debugger to each node of the ROS Attach to Node steps as it starts
+ *
+ * A single exec watcher watches for all of the nodes. The first node found is debugged by this
+ * worker, every other node gets its own debug run control with a ROSAttachRunWorker.
+ */
 class ROSDebugRunWorker : public Debugger::DebuggerRunTool
 {
     Q_OBJECT
@@ -130,12 +152,36 @@ public:
     void start() override;
 
 private:
-    void findProcess();
-    void pidFound(ProjectExplorer::DeviceProcessItem process);
-    QTimer m_timer;
-    int m_timeElapsed;
-    QString m_debugTargetPath;
-    bool m_debugContinueOnAttach;
+    struct AttachOptions
+    {
+        bool continueOnAttach = false;
+        bool stopAtEntry = false;
+    };
+
+    void processStarted(qint64 pid, const QString &executable, qint64 latency);
+    void waitForEntryStop(qint64 pid, const QString &executable, int attempts);
+    void pidFound(qint64 pid, const QString &executable, bool launchPrefix);
+    ROSExecWatcher m_watcher;
+    ROSRunSupervisor m_supervisor;
+    ROSRunStepScheduler m_scheduler;
+    QMap<QString, AttachOptions> m_debugTargets; /**< @brief Node executable to its attach options */
+    QHash<QString, int> m_expectedInstances;     /**< @brief Node executable to the number of nodes started from it */
+    QHash<QString, int> m_attachedInstances;     /**< @brief Node executable to the number of processes found */
+    QString m_debugLaunchPrefix;
+    bool m_primaryStarted = false;
+};
+
+/** @brief Debugs an additional node found by a ROSDebugRunWorker */
+class ROSAttachRunWorker : public Debugger::DebuggerRunTool
+{
+    Q_OBJECT
+
+public:
+    ROSAttachRunWorker(ProjectExplorer::RunControl *runControl, const Debugger::Internal::DebuggerRunParameters &rp);
+    void start() override;
+
+private:
+    Debugger::Internal::DebuggerRunParameters m_runParameters;
 };
 
 } // namespace Internal
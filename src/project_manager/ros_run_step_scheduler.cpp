@@ -0,0 +1,295 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_run_step_scheduler.h"
+#include "ros_run_step.h"
+#include "ros_run_steps.h"
+#include "ros_run_supervisor.h"
+
+#include <projectexplorer/project.h>
+
+#include <QDir>
+#include <QFileInfo>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+ROSRunStepScheduler::ROSRunStepScheduler(ROSRunSupervisor *supervisor, QObject *parent) :
+    QObject(parent),
+    m_supervisor(supervisor)
+{
+    m_pollTimer.setInterval(100);
+    connect(&m_pollTimer, &QTimer::timeout, this, &ROSRunStepScheduler::poll);
+    connect(m_supervisor, &ROSRunSupervisor::output, this, &ROSRunStepScheduler::processOutput);
+    connect(m_supervisor, &ROSRunSupervisor::processFinished, this, &ROSRunStepScheduler::processFinished);
+}
+
+void ROSRunStepScheduler::setLaunchPrefix(const QString &launchPrefix, const QStringList &targets)
+{
+    m_launchPrefix = launchPrefix;
+    m_launchPrefixTargets = targets;
+}
+
+void ROSRunStepScheduler::setReadyTimeout(int msec)
+{
+    m_readyTimeout = msec;
+}
+
+bool ROSRunStepScheduler::start(const QList<RunStep *> &steps)
+{
+    cancel();
+
+    m_steps.reserve(steps.size());
+    foreach (RunStep *runStep, steps)
+    {
+        Step step;
+        step.runStep = runStep;
+        step.name = runStep->displayName();
+        if (ROSGenericRunStep *genericStep = qobject_cast<ROSGenericRunStep *>(runStep))
+        {
+            step.name = QString("%1 %2 %3").arg(genericStep->getCommand(), genericStep->getPackage(), genericStep->getTarget());
+            step.waitForPrevious = genericStep->getWaitForPrevious();
+            step.condition = genericStep->getReadyCondition();
+            step.value = genericStep->getReadyValue();
+
+            // The steps are run in the workspace, so relative paths are resolved against it
+            if (step.condition == ROSGenericRunStep::ReadyWhenFileExists && !step.value.isEmpty())
+                step.value = QDir(genericStep->project()->projectDirectory().toString()).absoluteFilePath(step.value);
+        }
+        m_steps.append(step);
+    }
+
+    m_active = true;
+    schedule();
+    return m_active;
+}
+
+void ROSRunStepScheduler::cancel()
+{
+    m_pollTimer.stop();
+    m_steps.clear();
+    m_active = false;
+}
+
+bool ROSRunStepScheduler::isRunning() const
+{
+    return m_active;
+}
+
+void ROSRunStepScheduler::schedule()
+{
+    bool previousReady = true;
+    bool previousFailed = false;
+    bool done = true;
+    bool success = true;
+    for (int i = 0; i < m_steps.size(); ++i)
+    {
+        Step &step = m_steps[i];
+        if (step.state == Waiting)
+        {
+            if (step.waitForPrevious && previousFailed)
+                setFailed(step, tr("a previous step failed"));
+            else if (!step.waitForPrevious || previousReady)
+                startStep(step);
+        }
+
+        // startStep may have made the step ready or failed
+        previousReady = previousReady && step.state == Ready;
+        previousFailed = previousFailed || step.state == Failed;
+        done = done && (step.state == Ready || step.state == Failed);
+        success = success && step.state != Failed;
+    }
+
+    bool starting = false;
+    foreach (const Step &step, m_steps)
+        starting = starting || step.state == Starting;
+
+    if (starting && !m_pollTimer.isActive())
+        m_pollTimer.start();
+    else if (!starting)
+        m_pollTimer.stop();
+
+    if (done && m_active)
+    {
+        m_active = false;
+        emit finished(success);
+    }
+}
+
+void ROSRunStepScheduler::startStep(Step &step)
+{
+    step.state = Starting;
+    step.elapsed.start();
+
+    ROSGenericRunStep *genericStep = qobject_cast<ROSGenericRunStep *>(step.runStep);
+    if (!genericStep)
+    {
+        step.runStep->run();
+        setReady(step);
+        return;
+    }
+
+    genericStep->setDebugLaunchPrefix(m_launchPrefix, m_launchPrefixTargets);
+    step.pid = genericStep->runSupervised(m_supervisor);
+    genericStep->setDebugLaunchPrefix(QString(), QStringList());
+
+    if (step.pid < 0)
+    {
+        setFailed(step, tr("it failed to start"));
+        return;
+    }
+
+    if (step.condition == ROSGenericRunStep::ReadyWhenStarted)
+    {
+        setReady(step);
+    }
+    else if (step.pid == 0 && step.condition == ROSGenericRunStep::ReadyOnOutput)
+    {
+        // The output of a step run in a terminal is not available
+        emit message(tr("The output of %1 is not available when run in a terminal, it is considered ready once started.").arg(step.name), true);
+        setReady(step);
+    }
+    else
+    {
+        checkReady();
+    }
+}
+
+void ROSRunStepScheduler::setReady(Step &step)
+{
+    step.state = Ready;
+    step.output.clear();
+    if (step.condition != ROSGenericRunStep::ReadyWhenStarted)
+        emit message(tr("%1 is ready after %2 ms.").arg(step.name).arg(step.elapsed.elapsed()), false);
+
+    emit stepReady(step.name);
+}
+
+void ROSRunStepScheduler::setFailed(Step &step, const QString &reason)
+{
+    step.state = Failed;
+    step.output.clear();
+    emit message(tr("Skipping the steps waiting for %1, %2.").arg(step.name, reason), true);
+}
+
+void ROSRunStepScheduler::poll()
+{
+    if (checkReady())
+        schedule();
+}
+
+bool ROSRunStepScheduler::checkReady()
+{
+    bool changed = false;
+    for (int i = 0; i < m_steps.size(); ++i)
+    {
+        Step &step = m_steps[i];
+        if (step.state != Starting)
+            continue;
+
+        // An empty file or output would never match, so the step could never be ready
+        if ((step.condition == ROSGenericRunStep::ReadyWhenFileExists || step.condition == ROSGenericRunStep::ReadyOnOutput) &&
+            step.value.isEmpty())
+        {
+            setFailed(step, tr("its ready condition has no value"));
+            changed = true;
+        }
+        else if (step.condition == ROSGenericRunStep::ReadyWhenFileExists && QFileInfo::exists(step.value))
+        {
+            setReady(step);
+            changed = true;
+        }
+        else if (step.condition == ROSGenericRunStep::ReadyAfterDelay)
+        {
+            // The delay is chosen by the user, so it is not limited by the ready timeout
+            bool ok = false;
+            const qint64 delay = step.value.trimmed().toLongLong(&ok);
+            if (!ok || delay < 0)
+            {
+                setFailed(step, tr("its ready delay \"%1\" is not a number of milliseconds").arg(step.value));
+                changed = true;
+            }
+            else if (step.elapsed.elapsed() >= delay)
+            {
+                setReady(step);
+                changed = true;
+            }
+        }
+        else if (step.elapsed.elapsed() >= m_readyTimeout)
+        {
+            setFailed(step, tr("it was not ready within %1 ms").arg(m_readyTimeout));
+            changed = true;
+        }
+    }
+
+    return changed;
+}
+
+void ROSRunStepScheduler::processOutput(const QString &name, qint64 pid, const QString &text, bool isError)
+{
+    Q_UNUSED(name);
+    Q_UNUSED(isError);
+
+    Step *step = findStep(pid);
+    if (!step || step->state != Starting || step->condition != ROSGenericRunStep::ReadyOnOutput || step->value.isEmpty())
+        return;
+
+    step->output.append(text);
+    if (step->output.contains(step->value))
+    {
+        setReady(*step);
+        schedule();
+        return;
+    }
+
+    // Only keep what could be the start of a match
+    int keep = step->value.size() - 1;
+    if (step->output.size() > keep)
+        step->output = step->output.right(keep);
+}
+
+void ROSRunStepScheduler::processFinished(const QString &name, qint64 pid, int exitCode, bool crashed)
+{
+    Q_UNUSED(name);
+    Q_UNUSED(crashed);
+
+    Step *step = findStep(pid);
+    if (!step || step->state != Starting)
+        return;
+
+    setFailed(*step, tr("it exited with code %1 before it was ready").arg(exitCode));
+    schedule();
+}
+
+ROSRunStepScheduler::Step *ROSRunStepScheduler::findStep(qint64 pid)
+{
+    if (pid <= 0)
+        return nullptr;
+
+    for (int i = 0; i < m_steps.size(); ++i)
+    {
+        if (m_steps.at(i).pid == pid)
+            return &m_steps[i];
+    }
+    return nullptr;
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
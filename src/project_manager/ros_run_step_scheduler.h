@@ -0,0 +1,116 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_RUN_STEP_SCHEDULER_H
+#define ROS_RUN_STEP_SCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+class RunStep;
+class ROSRunSupervisor;
+
+/**
+ * @brief Starts the run steps concurrently, respecting the steps which wait for the previous steps
+ *
+ * Steps which do not wait for the previous steps are started immediately. A step waiting for the
+ * previous steps is started once all steps before it are ready, where each step's ready condition
+ * decides when that is (started, output matched, file exists or a delay). If a step exits or times
+ * out before it is ready the steps waiting for it are skipped.
+ */
+class ROSRunStepScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ROSRunStepScheduler(ROSRunSupervisor *supervisor, QObject *parent = nullptr);
+
+    /** @brief Launch prefix passed to the generic steps while they are started (see ROSGenericRunStep::setDebugLaunchPrefix) */
+    void setLaunchPrefix(const QString &launchPrefix, const QStringList &targets);
+
+    /** @brief Milliseconds a step has to become ready before it is considered failed, steps ready after a delay are exempt */
+    void setReadyTimeout(int msec);
+
+    /**
+     * @brief Start scheduling the steps
+     * @param steps Enabled run steps in run order
+     * @return True if there are steps left waiting, otherwise false.
+     */
+    bool start(const QList<RunStep *> &steps);
+    void cancel();
+    bool isRunning() const;
+
+signals:
+    void message(const QString &text, bool isError);
+    void stepReady(const QString &name);
+
+    /** @brief All steps were started or skipped */
+    void finished(bool success);
+
+private:
+    enum State {
+        Waiting,
+        Starting,
+        Ready,
+        Failed
+    };
+
+    struct Step
+    {
+        RunStep *runStep = nullptr;
+        QString name;
+        bool waitForPrevious = false;
+        int condition = 0;  /**< @brief ROSGenericRunStep::ReadyCondition */
+        QString value;
+        State state = Waiting;
+        qint64 pid = -1;
+        QString output; /**< @brief Unmatched tail of the output, so a match split across reads is found */
+        QElapsedTimer elapsed;
+    };
+
+    void schedule();
+    void startStep(Step &step);
+    void setReady(Step &step);
+    void setFailed(Step &step, const QString &reason);
+    void poll();
+    bool checkReady();
+    void processOutput(const QString &name, qint64 pid, const QString &text, bool isError);
+    void processFinished(const QString &name, qint64 pid, int exitCode, bool crashed);
+    Step *findStep(qint64 pid);
+
+    ROSRunSupervisor *m_supervisor;
+    QString m_launchPrefix;
+    QStringList m_launchPrefixTargets;
+    int m_readyTimeout = 60000;
+    QVector<Step> m_steps;
+    QTimer m_pollTimer;
+    bool m_active = false;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_RUN_STEP_SCHEDULER_H
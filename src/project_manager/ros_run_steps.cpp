@@ -24,11 +24,17 @@
 #include "ui_ros_generic_configuration.h"
 #include "ros_build_configuration.h"
 #include "ros_utils.h"
+#include "ros_launch_parser.h"
 
 #include <projectexplorer/project.h>
 #include <projectexplorer/buildmanager.h>
 #include <debugger/debuggerruncontrol.h>
 #include <qtermwidget5/qtermwidget.h>
+#include <utils/qtcprocess.h>
+
+#include <QIntValidator>
+
+#include <climits>
 
 namespace ROSProjectManager {
 namespace Internal {
@@ -39,6 +45,12 @@ const char ROS_GENERIC_TARGET_KEY[] = "ROSProjectManager.ROSGenericStep.Target";
 const char ROS_GENERIC_TARGET_PATH_KEY[] = "ROSProjectManager.ROSGenericStep.TargetPath";
 const char ROS_GENERIC_ARGUMENTS_KEY[] = "ROSProjectManager.ROSGenericStep.Arguments";
 const char ROS_GENERIC_DEBUG_CONTINUE_ON_ATTACH_KEY[] = "ROSProjectManager.ROSGenericStep.DebugContinueOnAttach";
+const char ROS_GENERIC_DEBUG_STOP_AT_ENTRY_KEY[] = "ROSProjectManager.ROSGenericStep.DebugStopAtEntry";
+const char ROS_GENERIC_DEBUG_ALL_LAUNCH_NODES_KEY[] = "ROSProjectManager.ROSGenericStep.DebugAllLaunchNodes";
+const char ROS_GENERIC_RUN_IN_TERMINAL_KEY[] = "ROSProjectManager.ROSGenericStep.RunInTerminal";
+const char ROS_GENERIC_WAIT_FOR_PREVIOUS_KEY[] = "ROSProjectManager.ROSGenericStep.WaitForPrevious";
+const char ROS_GENERIC_READY_CONDITION_KEY[] = "ROSProjectManager.ROSGenericStep.ReadyCondition";
+const char ROS_GENERIC_READY_VALUE_KEY[] = "ROSProjectManager.ROSGenericStep.ReadyValue";
 
 ROSRunStep::ROSRunStep(RunStepList *rsl) :
     ROSRunStep(rsl, Core::Id(Constants::ROS_RUN_ID))
@@ -134,9 +146,15 @@ void ROSGenericRunStep::run()
 {
   ROSProject *rp = qobject_cast<ROSProject *>(target()->project());
 
+  // rosrun runs the node with the prefix, launch files use it through $(optenv ROS_QTC_LAUNCH_PREFIX)
+  QString prefix;
+  if (!m_debugLaunchPrefix.isEmpty() && m_command == QLatin1String("rosrun"))
+    prefix = QString("--prefix %1 ").arg(Utils::QtcProcess::quoteArgUnix(m_debugLaunchPrefix));
+
   QString command;
-  command = QString("%1 %2 %3 %4\n")
+  command = QString("%1 %2%3 %4 %5\n")
       .arg(m_command,
+           prefix,
            m_package,
            m_target,
            m_arguments);
@@ -153,10 +171,49 @@ void ROSGenericRunStep::run()
   ROSUtils::WorkspaceInfo workspaceInfo = ROSUtils::getWorkspaceInfo(rp->projectDirectory(), rp->rosBuildConfiguration()->buildSystem(), rp->distribution());
   terminal.sendText(QString("source %1\n").arg(workspaceInfo.develPath.appendPath("setup.bash").toString()));
 
+  if (!m_debugLaunchPrefix.isEmpty())
+  {
+    terminal.sendText(QString("export ROS_QTC_LAUNCH_PREFIX=%1 ROS_QTC_STOP_AT_EXEC_TARGET=%2\n")
+                      .arg(Utils::QtcProcess::quoteArgUnix(m_debugLaunchPrefix),
+                           Utils::QtcProcess::quoteArgUnix(m_debugStopAtExecTargets.join(QLatin1Char(':')))));
+  }
+
   //send roslaunch command
   terminal.sendText(command);
 }
 
+qint64 ROSGenericRunStep::runSupervised(ROSRunSupervisor *supervisor)
+{
+  ROSProject *rp = qobject_cast<ROSProject *>(target()->project());
+  if (!supervisor || m_runInTerminal || !rp->rosBuildConfiguration())
+  {
+    run();
+    return 0;
+  }
+
+  // The build configuration environment already contains the sourced workspace environment
+  Utils::Environment env = rp->rosBuildConfiguration()->environment();
+  if (!m_debugLaunchPrefix.isEmpty())
+  {
+    env.set(QLatin1String("ROS_QTC_LAUNCH_PREFIX"), m_debugLaunchPrefix);
+    env.set(QLatin1String("ROS_QTC_STOP_AT_EXEC_TARGET"), m_debugStopAtExecTargets.join(QLatin1Char(':')));
+  }
+
+  QStringList arguments;
+  if (!m_debugLaunchPrefix.isEmpty() && m_command == QLatin1String("rosrun"))
+    arguments << QLatin1String("--prefix") << m_debugLaunchPrefix;
+
+  arguments << m_package << m_target << Utils::QtcProcess::splitArgs(m_arguments);
+
+  // QProcess searches the PATH of Qt Creator, not the one of the workspace
+  Utils::FileName program = env.searchInPath(m_command);
+  return supervisor->start(QString("%1 %2 %3").arg(m_command, m_package, m_target),
+                           program.isEmpty() ? m_command : program.toString(),
+                           arguments,
+                           env.toProcessEnvironment(),
+                           rp->projectDirectory().toString());
+}
+
 QVariantMap ROSGenericRunStep::toMap() const
 {
     QVariantMap map(RunStep::toMap());
@@ -167,6 +224,12 @@ QVariantMap ROSGenericRunStep::toMap() const
     map.insert(QLatin1String(ROS_GENERIC_TARGET_PATH_KEY), m_targetPath);
     map.insert(QLatin1String(ROS_GENERIC_ARGUMENTS_KEY), m_arguments);
     map.insert(QLatin1String(ROS_GENERIC_DEBUG_CONTINUE_ON_ATTACH_KEY), m_debugContinueOnAttach);
+    map.insert(QLatin1String(ROS_GENERIC_DEBUG_STOP_AT_ENTRY_KEY), m_debugStopAtEntry);
+    map.insert(QLatin1String(ROS_GENERIC_DEBUG_ALL_LAUNCH_NODES_KEY), m_debugAllLaunchNodes);
+    map.insert(QLatin1String(ROS_GENERIC_RUN_IN_TERMINAL_KEY), m_runInTerminal);
+    map.insert(QLatin1String(ROS_GENERIC_WAIT_FOR_PREVIOUS_KEY), m_waitForPrevious);
+    map.insert(QLatin1String(ROS_GENERIC_READY_CONDITION_KEY), static_cast<int>(m_readyCondition));
+    map.insert(QLatin1String(ROS_GENERIC_READY_VALUE_KEY), m_readyValue);
     return map;
 }
 
@@ -178,6 +241,12 @@ bool ROSGenericRunStep::fromMap(const QVariantMap &map)
     m_targetPath = map.value(QLatin1String(ROS_GENERIC_TARGET_PATH_KEY)).toString();
     m_arguments = map.value(QLatin1String(ROS_GENERIC_ARGUMENTS_KEY)).toString();
     m_debugContinueOnAttach = map.value(QLatin1String(ROS_GENERIC_DEBUG_CONTINUE_ON_ATTACH_KEY)).toBool();
+    m_debugStopAtEntry = map.value(QLatin1String(ROS_GENERIC_DEBUG_STOP_AT_ENTRY_KEY), false).toBool();
+    m_debugAllLaunchNodes = map.value(QLatin1String(ROS_GENERIC_DEBUG_ALL_LAUNCH_NODES_KEY), false).toBool();
+    m_runInTerminal = map.value(QLatin1String(ROS_GENERIC_RUN_IN_TERMINAL_KEY), false).toBool();
+    m_waitForPrevious = map.value(QLatin1String(ROS_GENERIC_WAIT_FOR_PREVIOUS_KEY), false).toBool();
+    m_readyCondition = static_cast<ReadyCondition>(map.value(QLatin1String(ROS_GENERIC_READY_CONDITION_KEY), ReadyWhenStarted).toInt());
+    m_readyValue = map.value(QLatin1String(ROS_GENERIC_READY_VALUE_KEY)).toString();
 
     return RunStep::fromMap(map);
 }
@@ -227,6 +296,36 @@ bool ROSGenericRunStep::getDebugContinueOnAttach() const
     return m_debugContinueOnAttach;
 }
 
+bool ROSGenericRunStep::getDebugStopAtEntry() const
+{
+    return m_debugStopAtEntry;
+}
+
+bool ROSGenericRunStep::getDebugAllLaunchNodes() const
+{
+    return m_debugAllLaunchNodes;
+}
+
+bool ROSGenericRunStep::getRunInTerminal() const
+{
+    return m_runInTerminal;
+}
+
+bool ROSGenericRunStep::getWaitForPrevious() const
+{
+    return m_waitForPrevious;
+}
+
+ROSGenericRunStep::ReadyCondition ROSGenericRunStep::getReadyCondition() const
+{
+    return m_readyCondition;
+}
+
+QString ROSGenericRunStep::getReadyValue() const
+{
+    return m_readyValue;
+}
+
 void ROSGenericRunStep::setPackage(const QString &package)
 {
   m_package = package;
@@ -252,6 +351,42 @@ void ROSGenericRunStep::setDebugContinueOnAttach(const bool &contOnAttach)
   m_debugContinueOnAttach = contOnAttach;
 }
 
+void ROSGenericRunStep::setDebugStopAtEntry(const bool &stopAtEntry)
+{
+  m_debugStopAtEntry = stopAtEntry;
+}
+
+void ROSGenericRunStep::setDebugAllLaunchNodes(const bool &allLaunchNodes)
+{
+  m_debugAllLaunchNodes = allLaunchNodes;
+}
+
+void ROSGenericRunStep::setRunInTerminal(const bool &runInTerminal)
+{
+  m_runInTerminal = runInTerminal;
+}
+
+void ROSGenericRunStep::setWaitForPrevious(const bool &waitForPrevious)
+{
+  m_waitForPrevious = waitForPrevious;
+}
+
+void ROSGenericRunStep::setReadyCondition(const ReadyCondition &condition)
+{
+  m_readyCondition = condition;
+}
+
+void ROSGenericRunStep::setReadyValue(const QString &value)
+{
+  m_readyValue = value;
+}
+
+void ROSGenericRunStep::setDebugLaunchPrefix(const QString &wrapper, const QStringList &targets)
+{
+  m_debugLaunchPrefix = wrapper;
+  m_debugStopAtExecTargets = targets;
+}
+
 
 //
 // ROSLaunchStepConfigWidget
@@ -274,11 +409,26 @@ ROSGenericRunStepConfigWidget::ROSGenericRunStepConfigWidget(ROSGenericRunStep *
         m_ui->argumentsLabel->hide();
         m_ui->argumentsLineEdit->hide();
         m_ui->debugCheckBox->setChecked(genericStep->getDebugContinueOnAttach());
+        m_ui->stopAtEntryCheckBox->setChecked(genericStep->getDebugStopAtEntry());
+        m_ui->allLaunchNodesCheckBox->setChecked(genericStep->getDebugAllLaunchNodes());
+        m_ui->runInTerminalCheckBox->hide();
+        m_ui->waitForPreviousCheckBox->hide();
+        m_ui->readyLabel->hide();
+        m_ui->readyConditionComboBox->hide();
+        m_ui->readyValueLineEdit->hide();
     }
     else
     {
          m_ui->debugLabel->hide();
          m_ui->debugCheckBox->hide();
+         m_ui->stopAtEntryCheckBox->hide();
+         m_ui->allLaunchNodesCheckBox->hide();
+         m_ui->runInTerminalCheckBox->setChecked(genericStep->getRunInTerminal());
+         m_ui->waitForPreviousCheckBox->setChecked(genericStep->getWaitForPrevious());
+         m_ui->readyConditionComboBox->setCurrentIndex(genericStep->getReadyCondition());
+         m_ui->readyValueLineEdit->setText(genericStep->getReadyValue());
+         m_ui->readyValueLineEdit->setEnabled(genericStep->getReadyCondition() != ROSGenericRunStep::ReadyWhenStarted);
+         updateReadyValueValidator();
     }
 
     int idx;
@@ -292,9 +442,32 @@ ROSGenericRunStepConfigWidget::ROSGenericRunStepConfigWidget(ROSGenericRunStep *
 
     m_ui->argumentsLineEdit->setText(genericStep->getArguments());
 
+    m_launchFileToolTipTimer.setSingleShot(true);
+    m_launchFileToolTipTimer.setInterval(500);
+    connect(&m_launchFileToolTipTimer, &QTimer::timeout,
+            this, &ROSGenericRunStepConfigWidget::updateLaunchFileToolTip);
+
     connect(m_ui->debugCheckBox, SIGNAL(toggled(bool)),
             this, SLOT(debugCheckBox_toggled(bool)));
 
+    connect(m_ui->stopAtEntryCheckBox, SIGNAL(toggled(bool)),
+            this, SLOT(stopAtEntryCheckBox_toggled(bool)));
+
+    connect(m_ui->allLaunchNodesCheckBox, SIGNAL(toggled(bool)),
+            this, SLOT(allLaunchNodesCheckBox_toggled(bool)));
+
+    connect(m_ui->runInTerminalCheckBox, SIGNAL(toggled(bool)),
+            this, SLOT(runInTerminalCheckBox_toggled(bool)));
+
+    connect(m_ui->waitForPreviousCheckBox, SIGNAL(toggled(bool)),
+            this, SLOT(waitForPreviousCheckBox_toggled(bool)));
+
+    connect(m_ui->readyConditionComboBox, SIGNAL(currentIndexChanged(int)),
+            this, SLOT(readyConditionComboBox_currentIndexChanged(int)));
+
+    connect(m_ui->readyValueLineEdit, SIGNAL(textChanged(QString)),
+            this, SLOT(readyValueLineEdit_textChanged(QString)));
+
     connect(m_ui->packageComboBox, SIGNAL(currentIndexChanged(QString)),
             this, SLOT(packageComboBox_currentIndexChanged(QString)));
 
@@ -306,6 +479,10 @@ ROSGenericRunStepConfigWidget::ROSGenericRunStepConfigWidget(ROSGenericRunStep *
 
     connect(ProjectExplorer::BuildManager::instance(), &ProjectExplorer::BuildManager::buildQueueFinished,
             this, &ROSGenericRunStepConfigWidget::updateAvailablePackages);
+
+    // The build may have added packages, so they are searched again
+    connect(ProjectExplorer::BuildManager::instance(), &ProjectExplorer::BuildManager::buildQueueFinished,
+            this, [this]() { m_launchPackagesEnvironment.clear(); });
 }
 
 ROSGenericRunStepConfigWidget::~ROSGenericRunStepConfigWidget()
@@ -347,6 +524,95 @@ void ROSGenericRunStepConfigWidget::debugCheckBox_toggled(const bool &arg1)
     m_rosGenericStep->setDebugContinueOnAttach(arg1);
 }
 
+void ROSGenericRunStepConfigWidget::stopAtEntryCheckBox_toggled(const bool &arg1)
+{
+    m_rosGenericStep->setDebugStopAtEntry(arg1);
+}
+
+void ROSGenericRunStepConfigWidget::allLaunchNodesCheckBox_toggled(const bool &arg1)
+{
+    m_rosGenericStep->setDebugAllLaunchNodes(arg1);
+}
+
+void ROSGenericRunStepConfigWidget::runInTerminalCheckBox_toggled(const bool &arg1)
+{
+    m_rosGenericStep->setRunInTerminal(arg1);
+}
+
+void ROSGenericRunStepConfigWidget::waitForPreviousCheckBox_toggled(const bool &arg1)
+{
+    m_rosGenericStep->setWaitForPrevious(arg1);
+}
+
+void ROSGenericRunStepConfigWidget::readyConditionComboBox_currentIndexChanged(int index)
+{
+    m_rosGenericStep->setReadyCondition(static_cast<ROSGenericRunStep::ReadyCondition>(index));
+    m_ui->readyValueLineEdit->setEnabled(index != ROSGenericRunStep::ReadyWhenStarted);
+    updateReadyValueValidator();
+}
+
+void ROSGenericRunStepConfigWidget::readyValueLineEdit_textChanged(const QString &arg1)
+{
+    m_rosGenericStep->setReadyValue(arg1);
+    updateReadyValueValidator();
+}
+
+void ROSGenericRunStepConfigWidget::updateReadyValueValidator()
+{
+    // The delay must be a number of milliseconds, the file and the output must not be empty
+    QLineEdit *lineEdit = m_ui->readyValueLineEdit;
+    const ROSGenericRunStep::ReadyCondition condition = m_rosGenericStep->getReadyCondition();
+    if (condition != ROSGenericRunStep::ReadyAfterDelay)
+    {
+        delete lineEdit->validator();
+        lineEdit->setValidator(nullptr);
+
+        QString error;
+        if (condition == ROSGenericRunStep::ReadyWhenFileExists)
+        {
+            lineEdit->setPlaceholderText(tr("File path, relative to the workspace"));
+            error = tr("The file path must not be empty.");
+        }
+        else if (condition == ROSGenericRunStep::ReadyOnOutput)
+        {
+            lineEdit->setPlaceholderText(tr("Output text"));
+            error = tr("The output text must not be empty.");
+        }
+        else
+        {
+            lineEdit->setPlaceholderText(QString());
+        }
+
+        if (error.isEmpty() || !lineEdit->text().isEmpty())
+        {
+            lineEdit->setStyleSheet(QString());
+            lineEdit->setToolTip(QString());
+        }
+        else
+        {
+            // There is no text to color, so the frame is marked
+            lineEdit->setStyleSheet(QLatin1String("QLineEdit { border: 1px solid red; }"));
+            lineEdit->setToolTip(error);
+        }
+        return;
+    }
+
+    if (!lineEdit->validator())
+        lineEdit->setValidator(new QIntValidator(0, INT_MAX, lineEdit));
+
+    lineEdit->setPlaceholderText(tr("Milliseconds"));
+    if (lineEdit->hasAcceptableInput())
+    {
+        lineEdit->setStyleSheet(QString());
+        lineEdit->setToolTip(QString());
+    }
+    else
+    {
+        lineEdit->setStyleSheet(QLatin1String("QLineEdit { color: red; }"));
+        lineEdit->setToolTip(tr("The delay must be a number of milliseconds."));
+    }
+}
+
 void ROSGenericRunStepConfigWidget::packageComboBox_currentIndexChanged(const QString &arg1)
 {
   m_rosGenericStep->setPackage(arg1);
@@ -360,15 +626,61 @@ void ROSGenericRunStepConfigWidget::targetComboBox_currentIndexChanged(const QSt
 {
   m_rosGenericStep->setTarget(arg1);
   m_rosGenericStep->setTargetPath(m_availableTargets[arg1]);
+  updateLaunchFileToolTip();
   emit updateSummary();
 }
 
 void ROSGenericRunStepConfigWidget::argumentsLineEdit_textChanged(const QString &arg1)
 {
   m_rosGenericStep->setArguments(arg1);
+  m_launchFileToolTipTimer.start();
   emit updateSummary();
 }
 
+void ROSGenericRunStepConfigWidget::updateLaunchFileToolTip()
+{
+    if (m_rosGenericStep->id() != Constants::ROS_LAUNCH_ID || m_rosGenericStep->getTargetPath().isEmpty())
+    {
+        m_ui->targetComboBox->setToolTip(QString());
+        return;
+    }
+
+    ROSBuildConfiguration *bc = qobject_cast<ROSBuildConfiguration *>(m_rosGenericStep->target()->activeBuildConfiguration());
+    if (!bc)
+    {
+        m_ui->targetComboBox->setToolTip(QString());
+        return;
+    }
+
+    // Searching the package path reads the file system, so it is only done when the environment changes
+    QStringList env = bc->environment().toStringList();
+    if (env != m_launchPackagesEnvironment)
+    {
+        m_launchPackages = ROSLaunchParser::findPackages(env);
+        m_launchPackagesEnvironment = env;
+    }
+
+    ROSLaunchParser parser(m_launchPackages, env);
+    parser.setArguments(ROSLaunchParser::parseArguments(m_rosGenericStep->getArguments()));
+    const ROSLaunchParser::LaunchFile launch = parser.parse(m_rosGenericStep->getTargetPath());
+
+    QStringList lines;
+    lines << tr("Nodes:");
+    foreach (const ROSLaunchParser::Node &node, launch.nodes)
+    {
+        if (node.uncertain)
+            lines << tr("  %1 (%2/%3, condition not evaluated)").arg(node.fullName(), node.package, node.type);
+        else
+            lines << QString("  %1 (%2/%3)").arg(node.fullName(), node.package, node.type);
+    }
+
+    lines << tr("Parameters: %1").arg(launch.parameters.size());
+    if (!launch.errors.isEmpty())
+        lines << tr("Errors:") << launch.errors;
+
+    m_ui->targetComboBox->setToolTip(lines.join(QLatin1Char('\n')));
+}
+
 void ROSGenericRunStepConfigWidget::updateAvailableTargets()
 {
     if(m_rosGenericStep->id() == Constants::ROS_LAUNCH_ID)
@@ -23,8 +23,10 @@
 
 #include "ros_run_step.h"
 #include "ros_run_configuration.h"
+#include "ros_run_supervisor.h"
 
 #include <QStringListModel>
+#include <QTimer>
 
 namespace ROSProjectManager {
 namespace Internal {
@@ -38,6 +40,14 @@ class ROSGenericRunStep : public RunStep
     friend class ROSRunStepFactory;
 
 public:
+  /** @brief When a step is ready, steps waiting for it are started once it is */
+  enum ReadyCondition {
+    ReadyWhenStarted = 0,
+    ReadyOnOutput = 1,       /**< @brief The output contains the ready value */
+    ReadyWhenFileExists = 2, /**< @brief The file (or socket) named by the ready value exists */
+    ReadyAfterDelay = 3      /**< @brief The ready value in milliseconds after it started */
+  };
+
   ROSGenericRunStep(RunStepList *rsl, Core::Id id);
   ~ROSGenericRunStep();
 
@@ -45,6 +55,13 @@ public:
 
   void run() override;
 
+  /**
+   * @brief Start the step's process with the supervisor, steps set to run in a terminal use run() instead
+   * @param supervisor Supervisor tracking the processes of the run
+   * @return The process id, 0 if run in a terminal and -1 if it failed to start
+   */
+  qint64 runSupervised(ROSRunSupervisor *supervisor);
+
   RunStepConfigWidget *createConfigWidget() override;
 
   QVariantMap toMap() const override;
@@ -58,12 +75,31 @@ public:
   QString getTargetPath() const;
   QString getArguments() const;
   bool getDebugContinueOnAttach() const;
+  bool getDebugStopAtEntry() const;
+  bool getDebugAllLaunchNodes() const;
+  bool getRunInTerminal() const;
+  bool getWaitForPrevious() const;
+  ReadyCondition getReadyCondition() const;
+  QString getReadyValue() const;
 
   void setPackage(const QString &package);
   void setTarget(const QString &target);
   void setTargetPath(const QString &target);
   void setArguments(const QString &arguments);
   void setDebugContinueOnAttach(const bool &contOnAttach);
+  void setDebugStopAtEntry(const bool &stopAtEntry);
+  void setDebugAllLaunchNodes(const bool &allLaunchNodes);
+  void setRunInTerminal(const bool &runInTerminal);
+  void setWaitForPrevious(const bool &waitForPrevious);
+  void setReadyCondition(const ReadyCondition &condition);
+  void setReadyValue(const QString &value);
+
+  /**
+   * @brief Run the nodes started by the next run() with a launch prefix which stops the debug target at entry
+   * @param wrapper Launch prefix script, empty to run the nodes directly
+   * @param targets Canonical paths of the nodes to stop
+   */
+  void setDebugLaunchPrefix(const QString &wrapper, const QStringList &targets);
 
 protected:
   ROSGenericRunStep(RunStepList *rsl, RunStep *rs);
@@ -78,6 +114,14 @@ private:
   QString m_arguments;
 
   bool m_debugContinueOnAttach;
+  bool m_debugStopAtEntry = false;
+  bool m_debugAllLaunchNodes = false;
+  bool m_runInTerminal = false;
+  bool m_waitForPrevious = false;
+  ReadyCondition m_readyCondition = ReadyWhenStarted;
+  QString m_readyValue;
+  QString m_debugLaunchPrefix;
+  QStringList m_debugStopAtExecTargets;
 };
 
 class ROSGenericRunStepConfigWidget : public RunStepConfigWidget
@@ -92,6 +136,18 @@ public:
 private slots:
   void debugCheckBox_toggled(const bool &arg1);
 
+  void stopAtEntryCheckBox_toggled(const bool &arg1);
+
+  void allLaunchNodesCheckBox_toggled(const bool &arg1);
+
+  void runInTerminalCheckBox_toggled(const bool &arg1);
+
+  void waitForPreviousCheckBox_toggled(const bool &arg1);
+
+  void readyConditionComboBox_currentIndexChanged(int index);
+
+  void readyValueLineEdit_textChanged(const QString &arg1);
+
   void packageComboBox_currentIndexChanged(const QString &arg1);
 
   void targetComboBox_currentIndexChanged(const QString &arg1);
@@ -101,8 +157,13 @@ private slots:
 private:
     void updateAvailableTargets();
     void updateAvailablePackages();
+    void updateLaunchFileToolTip();
+    void updateReadyValueValidator();
 
     Ui::ROSGenericStep *m_ui;
+    QTimer m_launchFileToolTipTimer;    /**< @brief Delays parsing the launch file while the arguments are typed */
+    QStringList m_launchPackagesEnvironment;
+    QMap<QString, QString> m_launchPackages; /**< @brief Packages found on the ROS_PACKAGE_PATH of m_launchPackagesEnvironment */
     ROSGenericRunStep *m_rosGenericStep;
     QMap<QString, QString> m_availablePackages;
     QMap<QString, QString> m_availableTargets;
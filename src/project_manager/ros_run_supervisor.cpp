@@ -0,0 +1,195 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "ros_run_supervisor.h"
+
+#include <QDebug>
+
+#include <signal.h>
+#include <unistd.h>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/** @brief Process started in its own process group, so a signal reaches the nodes it started too */
+class SupervisedProcess : public QProcess
+{
+public:
+    explicit SupervisedProcess(QObject *parent = nullptr) : QProcess(parent) {}
+
+    /** @brief Send a signal to the process group, like a terminal does for Ctrl+C */
+    void signalGroup(int signal)
+    {
+        if (state() != QProcess::NotRunning)
+            ::kill(-static_cast<pid_t>(processId()), signal);
+    }
+
+protected:
+    void setupChildProcess() override
+    {
+        ::setpgid(0, 0);
+    }
+};
+
+ROSRunSupervisor::ROSRunSupervisor(QObject *parent) :
+    QObject(parent)
+{
+    m_killTimer.setSingleShot(true);
+    connect(&m_killTimer, &QTimer::timeout, this, &ROSRunSupervisor::killRemaining);
+}
+
+ROSRunSupervisor::~ROSRunSupervisor()
+{
+    // Do not leave nodes running without anything tracking them. The processes outlive the
+    // supervisor until they exit, so shutting them down does not block the GUI thread.
+    QList<QProcess *> processes = m_processes.keys();
+    m_processes.clear();
+    foreach (QProcess *process, processes)
+    {
+        SupervisedProcess *supervised = static_cast<SupervisedProcess *>(process);
+        supervised->disconnect(this);
+        supervised->setParent(nullptr);
+        connect(supervised, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+                supervised, &QObject::deleteLater);
+
+        supervised->signalGroup(SIGINT);
+        QTimer::singleShot(2000, supervised, [supervised]() {
+            supervised->signalGroup(SIGKILL);
+        });
+    }
+}
+
+qint64 ROSRunSupervisor::start(const QString &name, const QString &program, const QStringList &arguments,
+                               const QProcessEnvironment &environment, const QString &workingDirectory)
+{
+    QProcessEnvironment env = environment;
+
+    // Output is read through pipes, flush it per line so it shows up as it is written
+    env.insert(QLatin1String("PYTHONUNBUFFERED"), QLatin1String("1"));
+    env.insert(QLatin1String("ROSCONSOLE_STDOUT_LINE_BUFFERED"), QLatin1String("1"));
+
+    // Include the node in the output so it can be attributed in the log, unless a format is set
+    if (!env.contains(QLatin1String("ROSCONSOLE_FORMAT")))
+        env.insert(QLatin1String("ROSCONSOLE_FORMAT"), QLatin1String("[${severity}] [${time}] [${node}]: ${message}"));
+
+    QProcess *process = new SupervisedProcess(this);
+    process->setProcessEnvironment(env);
+    process->setWorkingDirectory(workingDirectory);
+
+    connect(process, &QProcess::readyReadStandardOutput, this, [this, process]() {
+        readOutput(process, false);
+    });
+    connect(process, &QProcess::readyReadStandardError, this, [this, process]() {
+        readOutput(process, true);
+    });
+    connect(process, static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            this, [this, process](int exitCode, QProcess::ExitStatus status) {
+        processExited(process, exitCode, status);
+    });
+
+    process->start(program, arguments);
+    if (!process->waitForStarted())
+    {
+        qDebug() << "Failed to start " << program << ": " << process->errorString();
+        emit output(name, -1, tr("Failed to start %1: %2\n").arg(program, process->errorString()), true);
+        delete process;
+        return -1;
+    }
+
+    Process info;
+    info.name = name;
+    info.pid = process->processId();
+    m_processes.insert(process, info);
+
+    emit processStarted(name, info.pid);
+    return info.pid;
+}
+
+void ROSRunSupervisor::stop(int timeout)
+{
+    if (m_processes.isEmpty())
+        return;
+
+    // roslaunch and rosrun nodes shut down cleanly on SIGINT, like Ctrl+C in a terminal
+    foreach (QProcess *process, m_processes.keys())
+        static_cast<SupervisedProcess *>(process)->signalGroup(SIGINT);
+
+    m_killTimer.start(timeout);
+}
+
+bool ROSRunSupervisor::isRunning() const
+{
+    return !m_processes.isEmpty();
+}
+
+int ROSRunSupervisor::runningCount() const
+{
+    return m_processes.size();
+}
+
+QList<qint64> ROSRunSupervisor::pids() const
+{
+    QList<qint64> result;
+    foreach (const Process &process, m_processes)
+        result.append(process.pid);
+
+    return result;
+}
+
+void ROSRunSupervisor::readOutput(QProcess *process, bool isError)
+{
+    auto it = m_processes.constFind(process);
+    if (it == m_processes.constEnd())
+        return;
+
+    const QByteArray data = isError ? process->readAllStandardError() : process->readAllStandardOutput();
+    if (!data.isEmpty())
+        emit output(it.value().name, it.value().pid, QString::fromLocal8Bit(data), isError);
+}
+
+void ROSRunSupervisor::processExited(QProcess *process, int exitCode, QProcess::ExitStatus status)
+{
+    if (!m_processes.contains(process))
+        return;
+
+    // Deliver the output written right before exiting
+    readOutput(process, false);
+    readOutput(process, true);
+
+    const Process info = m_processes.take(process);
+    process->deleteLater();
+
+    emit processFinished(info.name, info.pid, exitCode, status == QProcess::CrashExit);
+
+    if (m_processes.isEmpty())
+    {
+        m_killTimer.stop();
+        emit finished();
+    }
+}
+
+void ROSRunSupervisor::killRemaining()
+{
+    foreach (QProcess *process, m_processes.keys())
+        static_cast<SupervisedProcess *>(process)->signalGroup(SIGKILL);
+}
+
+} // namespace Internal
+} // namespace ROSProjectManager
@@ -0,0 +1,98 @@
+/**
+ * @author Levi Armstrong
+ * @date October 19, 2026
+ *
+ * @copyright Copyright (c) 2026, Southwest Research Institute
+ *
+ * @license Software License Agreement (Apache License)\n
+ * \n
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at\n
+ * \n
+ * http://www.apache.org/licenses/LICENSE-2.0\n
+ * \n
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef ROS_RUN_SUPERVISOR_H
+#define ROS_RUN_SUPERVISOR_H
+
+#include <QHash>
+#include <QObject>
+#include <QProcess>
+#include <QProcessEnvironment>
+#include <QStringList>
+#include <QTimer>
+
+namespace ROSProjectManager {
+namespace Internal {
+
+/**
+ * @brief Starts the run step processes directly and tracks them until they exit
+ *
+ * The processes are started with the cached workspace environment, so no shell is started
+ * and no setup.bash is sourced. Each process runs in its own process group, stopping sends
+ * SIGINT to the group, which lets roslaunch shut its nodes down, groups still running after the
+ * stop timeout are killed.
+ */
+class ROSRunSupervisor : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ROSRunSupervisor(QObject *parent = nullptr);
+    ~ROSRunSupervisor();
+
+    /**
+     * @brief Start a process
+     * @param name Name used when reporting the process
+     * @param program Program to run, resolved by the caller against the environment's PATH
+     * @param arguments Program arguments
+     * @param environment Process environment
+     * @param workingDirectory Working directory
+     * @return The process id, -1 if it failed to start
+     */
+    qint64 start(const QString &name, const QString &program, const QStringList &arguments,
+                 const QProcessEnvironment &environment, const QString &workingDirectory);
+
+    /**
+     * @brief Stop all processes
+     * @param timeout Milliseconds after which processes which ignored SIGINT are killed
+     */
+    void stop(int timeout = 10000);
+
+    bool isRunning() const;
+    int runningCount() const;
+    QList<qint64> pids() const;
+
+signals:
+    void processStarted(const QString &name, qint64 pid);
+    void output(const QString &name, qint64 pid, const QString &text, bool isError);
+    void processFinished(const QString &name, qint64 pid, int exitCode, bool crashed);
+
+    /** @brief The last running process exited */
+    void finished();
+
+private:
+    void readOutput(QProcess *process, bool isError);
+    void processExited(QProcess *process, int exitCode, QProcess::ExitStatus status);
+    void killRemaining();
+
+    struct Process
+    {
+        QString name;
+        qint64 pid = 0;
+    };
+
+    QHash<QProcess *, Process> m_processes;
+    QTimer m_killTimer;
+};
+
+} // namespace Internal
+} // namespace ROSProjectManager
+
+#endif // ROS_RUN_SUPERVISOR_H
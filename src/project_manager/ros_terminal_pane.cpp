@@ -54,11 +54,34 @@
 namespace ROSProjectManager {
 namespace Internal {
 
+/** @brief Throttled terminals are rendered at this interval, the output rates are updated every 10 intervals */
+const int ROS_TERMINAL_RENDER_INTERVAL = 100;
+
+/** @brief Number of bytes of the text encoded as UTF-8, without encoding it */
+static int utf8Size(const QString &text)
+{
+    int size = 0;
+    for (const QChar &c : text)
+    {
+        const ushort u = c.unicode();
+        if (u < 0x80)
+            size += 1;
+        else if (u < 0x800)
+            size += 2;
+        else if (QChar::isHighSurrogate(u))
+            size += 4;  // The low surrogate adds nothing
+        else if (!QChar::isLowSurrogate(u))
+            size += 3;
+    }
+    return size;
+}
+
 ROSTerminalPane::ROSTerminalPane() :
   m_stopButton(new QToolButton),
   m_zoomInButton(new QToolButton),
   m_zoomOutButton(new QToolButton),
-  m_newTerminalButton(new QToolButton)
+  m_newTerminalButton(new QToolButton),
+  m_rateLabel(new QLabel)
 {
     m_tabWidget = new QTabWidget();
     m_tabWidget->setTabsClosable(true);
@@ -71,6 +94,17 @@ ROSTerminalPane::ROSTerminalPane() :
     m_zoomOutButton->setIcon(Utils::Icons::MINUS.icon());
     m_newTerminalButton->setToolTip(tr("Add new terminal"));
     m_newTerminalButton->setIcon(Utils::Icons::NEWFILE.icon());
+    m_rateLabel->setToolTip(tr("Output rate of the active terminal"));
+    m_rateLabel->setContentsMargins(6, 0, 6, 0);
+
+    // Rendering is throttled above this rate (bytes/s), zero disables throttling
+    QSettings *s = Core::ICore::settings();
+    s->beginGroup(QLatin1String("ROSTerminal"));
+    m_throttleRate = s->value(QLatin1String("ThrottleRate"), 256 * 1024).toInt();
+    s->endGroup();
+
+    m_rateTimer.setInterval(ROS_TERMINAL_RENDER_INTERVAL);
+    connect(&m_rateTimer, &QTimer::timeout, this, &ROSTerminalPane::updateOutputRates);
 
     updateToolBarButtonsEnabled();
 
@@ -91,6 +125,8 @@ ROSTerminalPane::ROSTerminalPane() :
             this, &ROSTerminalPane::startTerminalButton);
 
     connect(m_tabWidget,SIGNAL(tabCloseRequested(int)), this, SLOT(closeTerminal(int)));
+
+    connect(m_tabWidget, &QTabWidget::currentChanged, this, &ROSTerminalPane::updateRateLabel);
 }
 
 ROSTerminalPane::~ROSTerminalPane()
@@ -100,6 +136,7 @@ ROSTerminalPane::~ROSTerminalPane()
   delete m_zoomInButton;
   delete m_zoomOutButton;
   delete m_newTerminalButton;
+  delete m_rateLabel;
 }
 
 void ROSTerminalPane::updateToolBarButtonsEnabled()
@@ -145,8 +182,12 @@ void ROSTerminalPane::closeTerminal(int index)
   QProcess::startDetached(QString("kill -9 %1").arg(terminal->getShellPID()));
 
   m_terminals.removeAll(terminal);
+  m_outputRates.remove(terminal);
   m_tabWidget->removeTab(index);
 
+  if (m_terminals.isEmpty())
+    m_rateTimer.stop();
+
   updateToolBarButtonsEnabled();
 
   emit navigateStateUpdate();
@@ -206,12 +247,28 @@ QTermWidget &ROSTerminalPane::startTerminal(int startnow, const QString name)
   // Need to create a qtc dark color scheme for the terminal
   // Example: https://github.com/lxde/qtermwidget/blob/10e17968e4457da2b91675984e17009ee6e1e7aa/lib/color-schemes/Linux.colorscheme
   widget->setColorScheme(s->value(QLatin1String("ColorScheme"), QLatin1String("DarkPastels")).toString());
+
+  // Bound the scrollback so verbose nodes do not grow memory without limit. The history can be
+  // kept in a file instead, which is unlimited but only keeps the visible lines in memory.
+  if (s->value(QLatin1String("HistoryOnDisk"), false).toBool())
+    widget->setHistorySize(-1);
+  else
+    widget->setHistorySize(s->value(QLatin1String("HistoryLines"), 10000).toInt());
 //  QFont f(s->value(QLatin1String("FontName"), TERMINALPLUGINDEFAULTFONT).toString());
 //  f.setPointSize(s->value(QLatin1String("FontSize"), 10).toInt());
 //  widget->setTerminalFont(f);
   s->endGroup();
 
   m_terminals.append(widget);
+  m_outputRates.insert(widget, OutputRate());
+  connect(widget, &QTermWidget::receivedData, this, [this, widget](const QString &text) {
+    auto it = m_outputRates.find(widget);
+    if (it != m_outputRates.end())
+      it.value().bytes += utf8Size(text);
+  });
+
+  if (!m_rateTimer.isActive())
+    m_rateTimer.start();
 
   updateToolBarButtonsEnabled();
 
@@ -234,12 +291,84 @@ QTermWidget &ROSTerminalPane::startTerminal(int startnow, const QString name)
   return *widget;
 }
 
+void ROSTerminalPane::updateOutputRates()
+{
+  // Render the throttled terminals at a fixed rate instead of for every update
+  for (auto it = m_outputRates.constBegin(); it != m_outputRates.constEnd(); ++it)
+  {
+    if (it.value().throttled)
+    {
+      it.key()->setUpdatesEnabled(true);
+      it.key()->repaint();
+      it.key()->setUpdatesEnabled(false);
+    }
+  }
+
+  if (++m_rateTicks < 10)
+    return;
+
+  const double elapsed = m_rateTicks * ROS_TERMINAL_RENDER_INTERVAL / 1000.0;
+  m_rateTicks = 0;
+
+  for (auto it = m_outputRates.begin(); it != m_outputRates.end(); ++it)
+  {
+    OutputRate &outputRate = it.value();
+    outputRate.rate = outputRate.bytes / elapsed;
+    outputRate.bytes = 0;
+
+    setThrottled(it.key(), m_throttleRate > 0 && outputRate.rate > m_throttleRate);
+
+    int index = m_tabWidget->indexOf(it.key());
+    if (index != -1)
+      m_tabWidget->setTabToolTip(index, tr("Output: %1").arg(formatRate(outputRate.rate)));
+  }
+
+  updateRateLabel();
+}
+
+void ROSTerminalPane::setThrottled(QTermWidget *terminal, bool throttled)
+{
+  OutputRate &outputRate = m_outputRates[terminal];
+  if (outputRate.throttled == throttled)
+    return;
+
+  outputRate.throttled = throttled;
+  terminal->setUpdatesEnabled(!throttled);
+}
+
+void ROSTerminalPane::updateRateLabel()
+{
+  QTermWidget *terminal = qobject_cast<QTermWidget *>(m_tabWidget->currentWidget());
+  if (!terminal || !m_outputRates.contains(terminal))
+  {
+    m_rateLabel->clear();
+    return;
+  }
+
+  const OutputRate &outputRate = m_outputRates[terminal];
+  if (outputRate.throttled)
+    m_rateLabel->setText(tr("%1 (throttled)").arg(formatRate(outputRate.rate)));
+  else
+    m_rateLabel->setText(formatRate(outputRate.rate));
+}
+
+QString ROSTerminalPane::formatRate(double rate)
+{
+  if (rate >= 1024 * 1024)
+    return tr("%1 MB/s").arg(rate / (1024 * 1024), 0, 'f', 1);
+  if (rate >= 1024)
+    return tr("%1 KB/s").arg(rate / 1024, 0, 'f', 1);
+
+  return tr("%1 B/s").arg(qRound(rate));
+}
+
 QList<QWidget*> ROSTerminalPane::toolBarWidgets() const
 {
   return QList<QWidget *>() << m_newTerminalButton
                             << m_stopButton
                             << m_zoomInButton
-                            << m_zoomOutButton;
+                            << m_zoomOutButton
+                            << m_rateLabel;
 }
 
 bool ROSTerminalPane::hasFocus() const
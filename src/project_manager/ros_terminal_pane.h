@@ -29,6 +29,9 @@
 #include <QTabWidget>
 #include <QToolButton>
 #include <QProcess>
+#include <QHash>
+#include <QLabel>
+#include <QTimer>
 
 #include <qtermwidget5/qtermwidget.h>
 
@@ -75,9 +78,26 @@ private slots:
   void stopProcess();
   void closeTerminal(int index);
   void termKeyPressed(QKeyEvent *event);
+  void updateOutputRates();
 
 private:
+  /** @brief Output received by a terminal, used to throttle its rendering */
+  struct OutputRate
+  {
+    qint64 bytes = 0;    /**< @brief Bytes received since the last rate update */
+    double rate = 0;     /**< @brief Bytes per second */
+    bool throttled = false;
+  };
+
+  void setThrottled(QTermWidget *terminal, bool throttled);
+  void updateRateLabel();
+  static QString formatRate(double rate);
+
   QList<QTermWidget *> m_terminals;
+  QHash<QTermWidget *, OutputRate> m_outputRates;
+  QTimer m_rateTimer;
+  int m_rateTicks = 0;
+  int m_throttleRate = 0;
   QTabWidget * m_tabWidget;
   QStringList m_tabNames;
 
@@ -85,6 +105,7 @@ private:
   QToolButton *m_zoomInButton;
   QToolButton *m_zoomOutButton;
   QToolButton *m_newTerminalButton;
+  QLabel *m_rateLabel;
 };
 
 } // namespace Internal
@@ -21,20 +21,34 @@
 #include "ros_utils.h"
 #include "ros_project_constants.h"
 #include "ros_packagexml_parser.h"
+#include "ros_launch_parser.h"
 
 #include <utils/fileutils.h>
 #include <utils/environment.h>
+#include <utils/qtcprocess.h>
 #include <yaml-cpp/yaml.h>
 #include <fstream>
+#include <algorithm>
 #include <QDir>
 #include <QDebug>
 #include <QFile>
+#include <QFileInfo>
 #include <QTextStream>
+#include <QSet>
 #include <QDirIterator>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QMutexLocker>
 
 namespace ROSProjectManager {
 namespace Internal {
 
+/** @brief CMAKE_PREFIX_PATH and package name to the package's executables */
+typedef QHash<QString, QMap<QString, QString> > ROSExecutableIndex;
+Q_GLOBAL_STATIC(ROSExecutableIndex, rosExecutableIndex)
+Q_GLOBAL_STATIC(QMutex, rosExecutableIndexMutex)
+
 ROSUtils::ROSUtils()
 {
 
@@ -56,6 +70,35 @@ QString ROSUtils::buildTypeName(const ROSUtils::BuildType &buildType)
     }
 }
 
+QString ROSUtils::buildGeneratorName(const ROSUtils::BuildGenerator &buildGenerator)
+{
+    switch (buildGenerator) {
+    case ROSUtils::CodeBlocksNinja:
+        return QLatin1String("CodeBlocks - Ninja");
+    case ROSUtils::Ninja:
+        return QLatin1String("Ninja");
+    default:
+        return QLatin1String("CodeBlocks - Unix Makefiles");
+    }
+}
+
+bool ROSUtils::isNinjaGenerator(const ROSUtils::BuildGenerator &buildGenerator)
+{
+    return (buildGenerator == ROSUtils::CodeBlocksNinja || buildGenerator == ROSUtils::Ninja);
+}
+
+QString ROSUtils::compilerLauncherName(const ROSUtils::CompilerLauncher &compilerLauncher)
+{
+    switch (compilerLauncher) {
+    case ROSUtils::CCache:
+        return QLatin1String("ccache");
+    case ROSUtils::SCCache:
+        return QLatin1String("sccache");
+    default:
+        return QString();
+    }
+}
+
 bool ROSUtils::sourceROS(QProcess *process, const QString &rosDistribution)
 {
   bool results = sourceWorkspaceHelper(process, Utils::FileName::fromString(QLatin1String(ROSProjectManager::Constants::ROS_INSTALL_DIRECTORY)).appendPath(rosDistribution).appendPath(QLatin1String("setup.bash")).toString());
@@ -413,22 +456,112 @@ ROSUtils::PackageInfoMap ROSUtils::getWorkspacePackageInfo(const WorkspaceInfo &
     return wsPackageInfo;
 }
 
-ROSUtils::PackageBuildInfoMap ROSUtils::getWorkspacePackageBuildInfo(const WorkspaceInfo &workspaceInfo, const PackageInfoMap &packageInfo, const PackageBuildInfoMap *cachedPackageBuildInfo)
+QStringList ROSUtils::getPackagesContainingPaths(const PackageInfoMap &packageInfo, const QStringList &paths)
+{
+    QSet<QString> packages;
+    foreach (const QString &path, paths)
+    {
+        QString owner;
+        int ownerLength = 0;
+        foreach (const PackageInfo &package, packageInfo)
+        {
+            QString packagePath = package.path.toString();
+            if ((path == packagePath || path.startsWith(packagePath + QLatin1Char('/'))) && packagePath.size() > ownerLength)
+            {
+                owner = package.name;
+                ownerLength = packagePath.size();
+            }
+        }
+
+        if (!owner.isEmpty())
+            packages.insert(owner);
+    }
+
+    QStringList result = packages.toList();
+    result.sort();
+    return result;
+}
+
+ROSUtils::PackageBuildInfoMap ROSUtils::getWorkspacePackageBuildInfo(const WorkspaceInfo &workspaceInfo, const PackageInfoMap &packageInfo, const QStringList &environment, const PackageBuildInfoMap *cachedPackageBuildInfo)
 {
     PackageBuildInfoMap wsBuildInfo;
-    QStringList env = ROSUtils::getWorkspaceEnvironment(workspaceInfo).toStringList();
+    QHash<QString, QJsonArray> compileDatabases;
+    QHash<QString, QJsonObject> codemodels;
     foreach(PackageInfo package, packageInfo)
     {
-        PackageBuildInfo buildInfo(package, env);
+        PackageBuildInfo buildInfo(package, environment);
         if (findPackageBuildDirectory(workspaceInfo, package, buildInfo.path))
         {
+            const PackageBuildInfo *cachedBuildInfo = nullptr;
+            if (cachedPackageBuildInfo)
+            {
+                auto packIt = cachedPackageBuildInfo->find(package.name);
+                if (packIt != cachedPackageBuildInfo->end())
+                    cachedBuildInfo = &packIt.value();
+            }
+
+            // Get package's CMake file-api reply. Catkin tools configures each package separately,
+            // where catkin_make configures the whole workspace so all packages share the same reply.
+            Utils::FileName cmakeBuildPath = (workspaceInfo.buildSystem == CatkinTools) ? buildInfo.path : workspaceInfo.buildPath;
+            writeCMakeFileApiQuery(cmakeBuildPath);
+            if (findCMakeFileApiReplyIndex(cmakeBuildPath, buildInfo.fileApiReplyIndex))
+            {
+                QString indexPath = buildInfo.fileApiReplyIndex.toString();
+                if (!codemodels.contains(indexPath))
+                {
+                    QJsonObject codemodel;
+                    readCMakeFileApiCodemodel(buildInfo.fileApiReplyIndex, codemodel);
+                    codemodels.insert(indexPath, codemodel);
+                }
+
+                QJsonObject codemodel = codemodels.value(indexPath);
+                if (!codemodel.isEmpty() && ROSUtils::parseCMakeFileApiReply(workspaceInfo, buildInfo, codemodel, cachedBuildInfo))
+                {
+                    wsBuildInfo.insert(package.name, buildInfo);
+                    continue;
+                }
+
+                buildInfo.targets.clear();
+                buildInfo.fileApiReplyVersion.clear();
+            }
+
             // Get package's code block file
             buildInfo.cbpFile = buildInfo.path;
             buildInfo.cbpFile.appendPath(QString("%1.cbp").arg(package.name));
 
+            // Get package's compilation database, which is only generated for Ninja based generators.
+            // When using catkin_make all packages share the same file so it is only loaded once.
+            QJsonArray database;
+            if (findPackageCompileCommandsFile(workspaceInfo, buildInfo, buildInfo.compileCommandsFile))
+            {
+                QString databasePath = buildInfo.compileCommandsFile.toString();
+                if (!compileDatabases.contains(databasePath))
+                {
+                    QJsonDocument doc;
+                    if (readJsonFile(databasePath, doc) && doc.isArray())
+                        compileDatabases.insert(databasePath, doc.array());
+                    else
+                        qDebug() << QString("Error parsing compilation database: %1").arg(databasePath);
+                }
+                database = compileDatabases.value(databasePath);
+            }
+
             if (buildInfo.cbpFile.exists())
             {
-                if (ROSUtils::parseCodeBlocksFile(workspaceInfo, buildInfo))
+                if (ROSUtils::parseCodeBlocksFile(workspaceInfo, buildInfo) &&
+                    (database.isEmpty() || ROSUtils::parseCompileCommands(workspaceInfo, buildInfo, database)))
+                {
+                    wsBuildInfo.insert(package.name, buildInfo);
+                    continue;
+                }
+                else
+                {
+                    qDebug() << QString("Unable to parse build information for package: %1").arg(package.name);
+                }
+            }
+            else if (!database.isEmpty())
+            {
+                if (ROSUtils::parseCompileCommands(workspaceInfo, buildInfo, database))
                 {
                     wsBuildInfo.insert(package.name, buildInfo);
                     continue;
@@ -461,6 +594,27 @@ ROSUtils::PackageBuildInfoMap ROSUtils::getWorkspacePackageBuildInfo(const Works
 
     }
 
+    // Most targets share identical includes, flags and defines so intern them,
+    // which lets all targets share the same list data.
+    QSet<QStringList> stringListTable;
+    auto intern = [&stringListTable](QStringList &list) {
+        auto it = stringListTable.constFind(list);
+        if (it != stringListTable.constEnd())
+            list = *it;
+        else
+            stringListTable.insert(list);
+    };
+
+    for (auto it = wsBuildInfo.begin(); it != wsBuildInfo.end(); ++it)
+    {
+        for (auto targetIt = it->targets.begin(); targetIt != it->targets.end(); ++targetIt)
+        {
+            intern(targetIt->includes);
+            intern(targetIt->flags);
+            intern(targetIt->defines);
+        }
+    }
+
     return wsBuildInfo;
 }
 
@@ -622,6 +776,379 @@ bool ROSUtils::parseCodeBlocksFile(const WorkspaceInfo &workspaceInfo, ROSUtils:
   return true;
 }
 
+bool ROSUtils::parseCompileCommands(const WorkspaceInfo &workspaceInfo, ROSUtils::PackageBuildInfo &buildInfo, const QJsonArray &database)
+{
+    // The object files are located in CMakeFiles/<target>.dir/ which is used to group the commands by target
+    QRegExp targetDirectory(QLatin1String("CMakeFiles/([^/]+)\\.dir/"));
+    QString packagePath = buildInfo.parent.path.toString() + QLatin1Char('/');
+
+    // devel include directory
+    Utils::FileName develInclude(workspaceInfo.develPath);
+    develInclude = develInclude.appendPath(QLatin1String("include"));
+
+    QMap<QString, PackageTargetInfo> targets;
+    foreach (const QJsonValue &value, database)
+    {
+        QJsonObject entry = value.toObject();
+        QDir directory(entry.value(QLatin1String("directory")).toString());
+        QString file = entry.value(QLatin1String("file")).toString();
+        if (QFileInfo(file).isRelative())
+            file = directory.absoluteFilePath(file);
+
+        if (!file.startsWith(packagePath))
+            continue;
+
+        QStringList arguments;
+        if (entry.contains(QLatin1String("arguments")))
+        {
+            foreach (const QJsonValue &arg, entry.value(QLatin1String("arguments")).toArray())
+                arguments.append(arg.toString());
+        }
+        else
+        {
+            arguments = Utils::QtcProcess::splitArgs(entry.value(QLatin1String("command")).toString());
+        }
+
+        QString output = entry.value(QLatin1String("output")).toString();
+        if (output.isEmpty())
+        {
+            int idx = arguments.indexOf(QLatin1String("-o"));
+            if (idx != -1 && idx + 1 < arguments.size())
+                output = arguments.at(idx + 1);
+        }
+
+        if (targetDirectory.indexIn(output) == -1)
+            continue;
+
+        QString targetName = targetDirectory.cap(1);
+        if (targetName.endsWith(QLatin1String("_automoc")) || targetName.startsWith(QLatin1String("gtest")))
+            continue;
+
+        // Each target's sources share the same flags so only the first command needs to be parsed
+        if (targets.contains(targetName))
+            continue;
+
+        QStringList targetLocalIncludes;
+        QStringList targetSystemIncludes;
+        PackageTargetInfo targetInfo;
+        targetInfo.name = targetName;
+        targetInfo.type = ExecutableType; // Only targets that are compiled show up in the database
+
+        // The first argument is the compiler
+        for (int i = 1; i < arguments.size(); ++i)
+        {
+            QString arg = arguments.at(i);
+            if (arg == QLatin1String("-o") || arg == QLatin1String("-MF") || arg == QLatin1String("-MT") || arg == QLatin1String("-MQ"))
+            {
+                ++i;
+            }
+            else if (arg.startsWith(QLatin1String("-I")) || arg.startsWith(QLatin1String("-isystem")))
+            {
+                int prefix = arg.startsWith(QLatin1String("-I")) ? 2 : 8;
+                QString include = arg.mid(prefix);
+                if (include.isEmpty() && i + 1 < arguments.size())
+                    include = arguments.at(++i);
+
+                include = QDir::cleanPath(directory.absoluteFilePath(include));
+                if (include.startsWith(workspaceInfo.path.toString()))
+                {
+                    if (!targetLocalIncludes.contains(include))
+                        targetLocalIncludes.append(include);
+                }
+                else if (!targetSystemIncludes.contains(include))
+                {
+                    targetSystemIncludes.append(include);
+                }
+            }
+            else if (arg.startsWith(QLatin1String("-D")))
+            {
+                QString define = arg.mid(2);
+                if (define.isEmpty() && i + 1 < arguments.size())
+                    define = arguments.at(++i);
+
+                targetInfo.defines.append(define);
+            }
+            else if (arg == QLatin1String("-c") || arg == QLatin1String("-MD") || arg == QLatin1String("-MMD") || !arg.startsWith(QLatin1Char('-')))
+            {
+                continue;
+            }
+            else
+            {
+                targetInfo.flags.append(arg);
+            }
+        }
+
+        targetLocalIncludes.append(develInclude.toString());
+
+        // The order matters so it will order local first then system
+        targetInfo.includes = targetLocalIncludes;
+        targetInfo.includes.append(targetSystemIncludes);
+        targets.insert(targetName, targetInfo);
+    }
+
+    // Targets were already provided by the CodeBlocks file, so only update the ones without a flags.make
+    if (!buildInfo.targets.isEmpty())
+    {
+        for(auto it = buildInfo.targets.begin(); it != buildInfo.targets.end(); ++it)
+        {
+            if (it->flagsFile.exists() || !targets.contains(it->name))
+                continue;
+
+            it->flags = targets.value(it->name).flags;
+            it->defines = targets.value(it->name).defines;
+        }
+
+        return true;
+    }
+
+    buildInfo.targets = targets.values();
+    return true;
+}
+
+bool ROSUtils::writeCMakeFileApiQuery(const Utils::FileName &buildPath)
+{
+    if (!QDir(buildPath.toString()).exists())
+        return false;
+
+    Utils::FileName queryPath(buildPath);
+    queryPath.appendPath(QLatin1String(".cmake/api/v1/query"));
+
+    Utils::FileName queryFile(queryPath);
+    queryFile.appendPath(QLatin1String("codemodel-v2"));
+    if (queryFile.exists())
+        return true;
+
+    if (!QDir().mkpath(queryPath.toString()))
+    {
+        qDebug() << QString("Error creating CMake file-api query directory: %1").arg(queryPath.toString());
+        return false;
+    }
+
+    // The query is an empty file whose name is the requested object kind
+    QFile file(queryFile.toString());
+    if (!file.open(QFile::WriteOnly))
+    {
+        qDebug() << QString("Error creating CMake file-api query: %1").arg(queryFile.toString());
+        return false;
+    }
+    file.close();
+
+    return true;
+}
+
+bool ROSUtils::findCMakeFileApiReplyIndex(const Utils::FileName &buildPath, Utils::FileName &indexFile)
+{
+    Utils::FileName replyPath(buildPath);
+    replyPath.appendPath(QLatin1String(".cmake/api/v1/reply"));
+
+    // CMake documents that the lexicographically largest index file is the most recent reply
+    QStringList indexFiles = QDir(replyPath.toString()).entryList(QStringList() << QLatin1String("index-*.json"), QDir::Files, QDir::Name);
+    if (indexFiles.isEmpty())
+    {
+        indexFile = Utils::FileName();
+        return false;
+    }
+
+    indexFile = replyPath;
+    indexFile.appendPath(indexFiles.last());
+    return true;
+}
+
+bool ROSUtils::readCMakeFileApiCodemodel(const Utils::FileName &indexFile, QJsonObject &codemodel)
+{
+    QJsonDocument indexDoc;
+    if (!readJsonFile(indexFile.toString(), indexDoc) || !indexDoc.isObject())
+    {
+        qDebug() << QString("Error parsing CMake file-api reply index: %1").arg(indexFile.toString());
+        return false;
+    }
+
+    QJsonObject reply = indexDoc.object().value(QLatin1String("reply")).toObject().value(QLatin1String("codemodel-v2")).toObject();
+    if (reply.contains(QLatin1String("error")))
+    {
+        qDebug() << QString("CMake file-api codemodel error: %1").arg(reply.value(QLatin1String("error")).toString());
+        return false;
+    }
+
+    QString jsonFile = reply.value(QLatin1String("jsonFile")).toString();
+    if (jsonFile.isEmpty())
+        return false;
+
+    QDir replyDir = QFileInfo(indexFile.toString()).absoluteDir();
+    QJsonDocument codemodelDoc;
+    if (!readJsonFile(replyDir.absoluteFilePath(jsonFile), codemodelDoc) || !codemodelDoc.isObject())
+    {
+        qDebug() << QString("Error parsing CMake file-api codemodel: %1").arg(jsonFile);
+        return false;
+    }
+
+    codemodel = codemodelDoc.object();
+
+    // Store the reply directory so the target files can be located
+    codemodel.insert(QLatin1String("replyDirectory"), replyDir.absolutePath());
+    return true;
+}
+
+bool ROSUtils::parseCMakeFileApiReply(const WorkspaceInfo &workspaceInfo, ROSUtils::PackageBuildInfo &buildInfo, const QJsonObject &codemodel, const PackageBuildInfo *cachedBuildInfo)
+{
+    QDir replyDir(codemodel.value(QLatin1String("replyDirectory")).toString());
+    QDir sourceDir(codemodel.value(QLatin1String("paths")).toObject().value(QLatin1String("source")).toString());
+    QString packagePath = QDir::cleanPath(buildInfo.parent.path.toString());
+
+    // ROS packages are built with a single configuration
+    QJsonArray configurations = codemodel.value(QLatin1String("configurations")).toArray();
+    if (configurations.isEmpty())
+        return false;
+
+    QJsonObject configuration = configurations.first().toObject();
+    QJsonArray directories = configuration.value(QLatin1String("directories")).toArray();
+
+    // Collect the package's targets, the reply file names contain a hash of the target's content
+    QStringList targetFiles;
+    foreach (const QJsonValue &value, configuration.value(QLatin1String("targets")).toArray())
+    {
+        QJsonObject target = value.toObject();
+        QString targetName = target.value(QLatin1String("name")).toString();
+        if (targetName.endsWith(QLatin1String("_automoc")) || targetName.startsWith(QLatin1String("gtest")))
+            continue;
+
+        int directoryIndex = target.value(QLatin1String("directoryIndex")).toInt(-1);
+        if (directoryIndex < 0 || directoryIndex >= directories.size())
+            continue;
+
+        QString directory = QDir::cleanPath(sourceDir.absoluteFilePath(directories.at(directoryIndex).toObject().value(QLatin1String("source")).toString()));
+        if (directory != packagePath && !directory.startsWith(packagePath + QLatin1Char('/')))
+            continue;
+
+        targetFiles.append(target.value(QLatin1String("jsonFile")).toString());
+    }
+    targetFiles.sort();
+
+    QString replyVersion = targetFiles.join(QLatin1Char(';'));
+    if (cachedBuildInfo && !cachedBuildInfo->fileApiReplyVersion.isEmpty() && cachedBuildInfo->fileApiReplyVersion == replyVersion)
+    {
+        buildInfo.targets = cachedBuildInfo->targets;
+        buildInfo.fileApiReplyVersion = replyVersion;
+        return true;
+    }
+
+    // make sure targets are cleared
+    buildInfo.targets.clear();
+
+    // devel include directory
+    Utils::FileName develInclude(workspaceInfo.develPath);
+    develInclude = develInclude.appendPath(QLatin1String("include"));
+
+    foreach (const QString &targetFile, targetFiles)
+    {
+        QJsonDocument targetDoc;
+        if (!readJsonFile(replyDir.absoluteFilePath(targetFile), targetDoc) || !targetDoc.isObject())
+        {
+            qDebug() << QString("Error parsing CMake file-api target: %1").arg(targetFile);
+            return false;
+        }
+
+        QJsonObject target = targetDoc.object();
+        QString type = target.value(QLatin1String("type")).toString();
+
+        PackageTargetInfo targetInfo;
+        targetInfo.name = target.value(QLatin1String("name")).toString();
+        if (type == QLatin1String("EXECUTABLE"))
+            targetInfo.type = ExecutableType;
+        else if (type == QLatin1String("STATIC_LIBRARY") || type == QLatin1String("OBJECT_LIBRARY"))
+            targetInfo.type = StaticLibraryType;
+        else if (type == QLatin1String("SHARED_LIBRARY") || type == QLatin1String("MODULE_LIBRARY"))
+            targetInfo.type = DynamicLibraryType;
+        else
+            continue; // Only need to add compiled targets to the code model
+
+        // Use the C++ compile group if available, otherwise the first one
+        QJsonArray compileGroups = target.value(QLatin1String("compileGroups")).toArray();
+        if (compileGroups.isEmpty())
+            continue;
+
+        QJsonObject compileGroup = compileGroups.first().toObject();
+        foreach (const QJsonValue &group, compileGroups)
+        {
+            if (group.toObject().value(QLatin1String("language")).toString() == QLatin1String("CXX"))
+            {
+                compileGroup = group.toObject();
+                break;
+            }
+        }
+
+        foreach (const QJsonValue &fragment, compileGroup.value(QLatin1String("compileCommandFragments")).toArray())
+            targetInfo.flags.append(Utils::QtcProcess::splitArgs(fragment.toObject().value(QLatin1String("fragment")).toString()));
+
+        foreach (const QJsonValue &define, compileGroup.value(QLatin1String("defines")).toArray())
+            targetInfo.defines.append(define.toObject().value(QLatin1String("define")).toString());
+
+        QStringList targetLocalIncludes;
+        QStringList targetSystemIncludes;
+        foreach (const QJsonValue &value, compileGroup.value(QLatin1String("includes")).toArray())
+        {
+            QJsonObject include = value.toObject();
+            QString includePath = QDir::cleanPath(include.value(QLatin1String("path")).toString());
+            if (!include.value(QLatin1String("isSystem")).toBool() && includePath.startsWith(workspaceInfo.path.toString()))
+            {
+                if (!targetLocalIncludes.contains(includePath))
+                    targetLocalIncludes.append(includePath);
+            }
+            else if (!targetSystemIncludes.contains(includePath))
+            {
+                targetSystemIncludes.append(includePath);
+            }
+        }
+        targetLocalIncludes.append(develInclude.toString());
+
+        // The order matters so it will order local first then system
+        targetInfo.includes = targetLocalIncludes;
+        targetInfo.includes.append(targetSystemIncludes);
+
+        foreach (const QJsonValue &value, target.value(QLatin1String("sources")).toArray())
+        {
+            QJsonObject source = value.toObject();
+            if (!source.contains(QLatin1String("compileGroupIndex")) || source.value(QLatin1String("isGenerated")).toBool())
+                continue;
+
+            targetInfo.sources.append(QDir::cleanPath(sourceDir.absoluteFilePath(source.value(QLatin1String("path")).toString())));
+        }
+
+        buildInfo.targets.append(targetInfo);
+    }
+
+    buildInfo.fileApiReplyVersion = replyVersion;
+    return !buildInfo.targets.isEmpty();
+}
+
+bool ROSUtils::readJsonFile(const QString &filePath, QJsonDocument &doc)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly | QFile::Text))
+        return false;
+
+    QJsonParseError error;
+    doc = QJsonDocument::fromJson(file.readAll(), &error);
+    return (error.error == QJsonParseError::NoError);
+}
+
+bool ROSUtils::findPackageCompileCommandsFile(const WorkspaceInfo &workspaceInfo, const PackageBuildInfo &buildInfo, Utils::FileName &compileCommandsFile)
+{
+    // Catkin tools builds each package separately, where catkin_make has a single top level database
+    compileCommandsFile = buildInfo.path;
+    compileCommandsFile.appendPath(QLatin1String("compile_commands.json"));
+    if (compileCommandsFile.exists())
+        return true;
+
+    compileCommandsFile = workspaceInfo.buildPath;
+    compileCommandsFile.appendPath(QLatin1String("compile_commands.json"));
+    if (compileCommandsFile.exists())
+        return true;
+
+    compileCommandsFile = Utils::FileName();
+    return false;
+}
+
 QMap<QString, QString> ROSUtils::getROSPackages(const QStringList &env)
 {
   QProcess process;
@@ -694,50 +1221,73 @@ QMap<QString, QString> ROSUtils::getROSPackageLaunchFiles(const QString &package
   return launchFiles;
 }
 
-QMap<QString, QString> ROSUtils::getROSPackageExecutables(const QString &packageName, const QStringList &env)
+QMap<QString, QString> ROSUtils::getLaunchFileNodes(const QString &launchFile, const QStringList &env, const QString &arguments)
 {
+    ROSLaunchParser parser(ROSLaunchParser::findPackages(env), env);
+    parser.setArguments(ROSLaunchParser::parseArguments(arguments));
 
-  QProcess process;
-  QMap<QString, QString> package_executables;
-  QString package_executables_location;
+    const ROSLaunchParser::LaunchFile launch = parser.parse(launchFile);
+    foreach (const QString &error, launch.errors)
+        qDebug() << "Launch file error: " << error;
 
-  process.setEnvironment(env);
-  process.start(QLatin1String("bash"));
-  process.waitForStarted();
-  QString cmd = QLatin1String("catkin_find --without-underlays --libexec ") + packageName + QLatin1String(" > /tmp/rosqtexecutables.txt");
-  process.write(cmd.toLatin1());
-  process.closeWriteChannel();
-  process.waitForFinished();
-
-  if (process.exitStatus() != QProcess::CrashExit)
-  {
-    QFile executable_file(QLatin1String("/tmp/rosqtexecutables.txt"));
-    if (executable_file.open(QIODevice::ReadOnly))
+    QMap<QString, QString> nodes;
+    QHash<QString, QMap<QString, QString> > packageExecutables;
+    foreach (const ROSLaunchParser::Node &node, launch.nodes)
     {
-      QTextStream executable_stream(&executable_file);
-      if (!executable_stream.atEnd())
-      {
-        package_executables_location = executable_stream.readLine();
-      }
-      executable_file.close();
+        // The node may never be started, the debugger would wait for it
+        if (node.uncertain)
+            continue;
 
-      if(!package_executables_location.isEmpty())
-      {
-        const QDir srcDir(package_executables_location);
-        QDirIterator it(srcDir.absolutePath(), QDir::Files | QDir::Executable | QDir::NoDotAndDotDot, QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+        if (!packageExecutables.contains(node.package))
+            packageExecutables.insert(node.package, getROSPackageExecutables(node.package, env));
 
-        while (it.hasNext())
-        {
-          QFileInfo executableFile(it.next());
-          package_executables.insert(executableFile.fileName(), executableFile.absoluteFilePath());
-        }
+        const QString executable = packageExecutables.value(node.package).value(node.type);
+        if (!executable.isEmpty())
+            nodes.insert(node.fullName(), executable);
+    }
 
-        return package_executables;
-      }
+    return nodes;
+}
+
+QMap<QString, QString> ROSUtils::getROSPackageExecutables(const QString &packageName, const QStringList &env)
+{
+  if (packageName.isEmpty())
+    return QMap<QString, QString>();
+
+  // catkin installs a package's executables in lib/<package> of its devel or install space
+  const QString prefixPath = Utils::Environment(env).value(QLatin1String("CMAKE_PREFIX_PATH"));
+  const QString key = prefixPath + QLatin1Char('\n') + packageName;
+
+  QMutexLocker lock(rosExecutableIndexMutex());
+  ROSExecutableIndex::const_iterator it = rosExecutableIndex()->constFind(key);
+  if (it != rosExecutableIndex()->constEnd())
+    return it.value();
+
+  // The first prefix containing the package wins, the same as the package path
+  QMap<QString, QString> package_executables;
+  foreach (const QString &prefix, prefixPath.split(QLatin1Char(':'), QString::SkipEmptyParts))
+  {
+    const QDir libDir(QDir(prefix).absoluteFilePath(QLatin1String("lib/") + packageName));
+    if (!libDir.exists())
+      continue;
+
+    QDirIterator dirIt(libDir.absolutePath(), QDir::Files | QDir::Executable | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (dirIt.hasNext())
+    {
+      QFileInfo executableFile(dirIt.next());
+      package_executables.insert(executableFile.fileName(), executableFile.absoluteFilePath());
     }
+    break;
   }
 
-  return QMap<QString, QString>();
+  rosExecutableIndex()->insert(key, package_executables);
+  return package_executables;
+}
+
+void ROSUtils::clearExecutableIndex()
+{
+  QMutexLocker lock(rosExecutableIndexMutex());
+  rosExecutableIndex()->clear();
 }
 
 Utils::FileName ROSUtils::getCatkinToolsProfilesPath(const Utils::FileName &workspaceDir)
@@ -922,6 +1472,39 @@ Utils::FileName ROSUtils::getCatkinToolsProfile(const Utils::FileName &workspace
     return profile;
 }
 
+QStringList ROSUtils::getCatkinToolsUnityBuildExclude(const Utils::FileName &workspaceDir, const QString &profileName)
+{
+    QStringList packages;
+    Utils::FileName file = getCatkinToolsProfilePath(workspaceDir, profileName).appendPath(QLatin1String("unity_build_exclude.yaml"));
+    if (!file.exists())
+        return packages;
+
+    YAML::Node config = YAML::LoadFile(file.toString().toStdString());
+    if (config["exclude"] && config["exclude"].IsSequence())
+        for (const YAML::Node &package : config["exclude"])
+            packages.append(QString::fromStdString(package.as<std::string>()));
+
+    return packages;
+}
+
+bool ROSUtils::setCatkinToolsUnityBuildExclude(const Utils::FileName &workspaceDir, const QString &profileName, const QStringList &packages)
+{
+    Utils::FileName profile = getCatkinToolsProfilePath(workspaceDir, profileName);
+    QDir().mkpath(profile.toString());
+
+    YAML::Node config;
+    config["exclude"] = YAML::Node(YAML::NodeType::Sequence);
+    foreach (const QString &package, packages)
+        config["exclude"].push_back(package.toStdString());
+
+    std::ofstream fout(profile.appendPath(QLatin1String("unity_build_exclude.yaml")).toString().toStdString());
+    if (!fout.is_open())
+        return false;
+
+    fout << config;
+    return true;
+}
+
 QString ROSUtils::getCMakeBuildTypeArgument(ROSUtils::BuildType &buildType)
 {
     switch (buildType) {
@@ -938,6 +1521,227 @@ QString ROSUtils::getCMakeBuildTypeArgument(ROSUtils::BuildType &buildType)
     }
 }
 
+QString ROSUtils::getCMakeGeneratorArguments(const ROSUtils::BuildGenerator &buildGenerator, bool includeGenerator)
+{
+    QStringList args;
+    if (includeGenerator)
+        args << QString("-G \"%1\"").arg(buildGeneratorName(buildGenerator));
+
+    if (isNinjaGenerator(buildGenerator))
+        args << QLatin1String("-DCMAKE_EXPORT_COMPILE_COMMANDS=ON");
+
+    return args.join(QLatin1Char(' '));
+}
+
+QString ROSUtils::getCMakeCompilerLauncherArguments(const ROSUtils::CompilerLauncher &compilerLauncher)
+{
+    QString launcher = compilerLauncherName(compilerLauncher);
+    if (launcher.isEmpty())
+        return QString();
+
+    return QString("-DCMAKE_C_COMPILER_LAUNCHER=%1 -DCMAKE_CXX_COMPILER_LAUNCHER=%1").arg(launcher);
+}
+
+QString ROSUtils::getCMakeUnityBuildArguments(const Utils::FileName &buildPath, int batchSize, const QStringList &excludedPackages)
+{
+    QString args = QString("-DCMAKE_UNITY_BUILD=ON -DCMAKE_UNITY_BUILD_BATCH_SIZE=%1").arg(qMax(0, batchSize));
+
+    // The include variables stay in the cache, remove them first so packages which are no longer
+    // excluded are unity built again. catkin packages call project() with the package name.
+    args.append(QLatin1String(" -UCMAKE_PROJECT_*_INCLUDE"));
+    Utils::FileName excludeFile = Utils::FileName(buildPath).appendPath(QLatin1String("ros_qtc_unity_build_exclude.cmake"));
+    foreach (const QString &package, excludedPackages)
+        args.append(QString(" -DCMAKE_PROJECT_%1_INCLUDE=%2").arg(package, excludeFile.toString()));
+
+    return args;
+}
+
+bool ROSUtils::writeUnityBuildExcludeFile(const Utils::FileName &buildPath)
+{
+    Utils::FileName excludeFile = Utils::FileName(buildPath).appendPath(QLatin1String("ros_qtc_unity_build_exclude.cmake"));
+    if (excludeFile.exists())
+        return true;
+
+    QDir().mkpath(buildPath.toString());
+    QFile file(excludeFile.toString());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qDebug() << "Failed to write unity build exclude file: " << excludeFile.toString();
+        return false;
+    }
+
+    // Shadows the CMAKE_UNITY_BUILD cache variable for the targets of the including package
+    file.write("# Generated by the ROS Qt Creator plugin, disables unity builds for the including package\n"
+               "set(CMAKE_UNITY_BUILD OFF)\n");
+    return true;
+}
+
+QMap<QString, QStringList> ROSUtils::getPrecompiledHeaderCandidates(const PackageBuildInfoMap &buildInfo, int maxHeaders)
+{
+    QMap<QString, QStringList> targetHeaders;
+    QRegExp include(QLatin1String("^\\s*#\\s*include\\s*(<[^>]+>)")); // Example: #include <ros/ros.h>
+    QRegExp source(QLatin1String("\\.(cpp|cc|cxx|C)$"));
+
+    foreach (const PackageBuildInfo &package, buildInfo)
+    {
+        // Headers of the package itself change too often to be worth precompiling
+        const QString ownPrefix = QString("<%1/").arg(package.parent.name);
+
+        foreach (const PackageTargetInfo &target, package.targets)
+        {
+            QHash<QString, int> counts;
+            int sourceCount = 0;
+            foreach (const QString &sourceFile, target.sources)
+            {
+                if (source.indexIn(sourceFile) == -1)
+                    continue;
+
+                QFile file(sourceFile);
+                if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+                    continue;
+
+                ++sourceCount;
+                QSet<QString> seen;
+                QTextStream in(&file);
+                while (!in.atEnd())
+                {
+                    QString line = in.readLine();
+                    if (!line.contains(QLatin1Char('#')) || include.indexIn(line) == -1)
+                        continue;
+
+                    QString header = include.cap(1);
+                    if (!header.startsWith(ownPrefix) && !seen.contains(header))
+                    {
+                        seen.insert(header);
+                        ++counts[header];
+                    }
+                }
+            }
+
+            // A single source gains nothing from a precompiled header
+            if (sourceCount < 2)
+                continue;
+
+            QList<QPair<int, QString> > ranked;
+            for (auto it = counts.constBegin(); it != counts.constEnd(); ++it)
+                if (it.value() * 2 >= sourceCount)
+                    ranked.append(qMakePair(it.value(), it.key()));
+
+            std::sort(ranked.begin(), ranked.end(), [](const QPair<int, QString> &a, const QPair<int, QString> &b) {
+                return (a.first != b.first) ? a.first > b.first : a.second < b.second;
+            });
+
+            QStringList headers;
+            for (int i = 0; i < ranked.size() && i < maxHeaders; ++i)
+                headers.append(ranked.at(i).second);
+
+            if (!headers.isEmpty())
+                targetHeaders.insert(target.name, headers);
+        }
+    }
+
+    return targetHeaders;
+}
+
+bool ROSUtils::writePrecompiledHeaderFile(const Utils::FileName &buildPath, const QMap<QString, QStringList> &targetHeaders)
+{
+    QString content;
+    QTextStream out(&content);
+    out << "# Generated by the ROS Qt Creator plugin, adds precompiled headers to the targets of each package\n"
+        << "if(NOT ROS_QTC_PRECOMPILED_HEADERS OR CMAKE_VERSION VERSION_LESS 3.19)\n"
+        << "  return()\n"
+        << "endif()\n\n";
+
+    for (auto it = targetHeaders.constBegin(); it != targetHeaders.constEnd(); ++it)
+        out << "set(_ros_qtc_pch_" << it.key() << " \"" << it.value().join(QLatin1Char(';')) << "\")\n";
+
+    out << "\n"
+        << "if(NOT COMMAND _ros_qtc_precompile_headers)\n"
+        << "  function(_ros_qtc_precompile_headers)\n"
+        << "    get_property(_targets DIRECTORY PROPERTY BUILDSYSTEM_TARGETS)\n"
+        << "    foreach(_target IN LISTS _targets)\n"
+        << "      if(DEFINED _ros_qtc_pch_${_target})\n"
+        << "        foreach(_header IN LISTS _ros_qtc_pch_${_target})\n"
+        << "          # The closing bracket of <header> would end the generator expression\n"
+        << "          string(REPLACE \">\" \"$<ANGLE-R>\" _header \"${_header}\")\n"
+        << "          target_precompile_headers(${_target} PRIVATE \"$<$<COMPILE_LANGUAGE:CXX>:${_header}>\")\n"
+        << "        endforeach()\n"
+        << "      endif()\n"
+        << "    endforeach()\n"
+        << "  endfunction()\n"
+        << "endif()\n\n"
+        << "# The targets are defined after project(), so the headers are added once the directory is processed\n"
+        << "cmake_language(DEFER CALL _ros_qtc_precompile_headers)\n";
+    out.flush();
+
+    QFile file(Utils::FileName(buildPath).appendPath(QLatin1String("ros_qtc_precompiled_headers.cmake")).toString());
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        bool unchanged = (QString::fromUtf8(file.readAll()) == content);
+        file.close();
+        if (unchanged)
+            return true;
+    }
+
+    QDir().mkpath(buildPath.toString());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qDebug() << "Failed to write precompiled header file: " << file.fileName();
+        return false;
+    }
+
+    file.write(content.toUtf8());
+    return true;
+}
+
+QString ROSUtils::getCMakePrecompiledHeaderArguments(const Utils::FileName &buildPath, bool enabled)
+{
+    // CMAKE_PROJECT_INCLUDE stays in the cache, so disabling only switches the included file off
+    if (!enabled)
+        return QString("-DROS_QTC_PRECOMPILED_HEADERS=OFF");
+
+    Utils::FileName file = Utils::FileName(buildPath).appendPath(QLatin1String("ros_qtc_precompiled_headers.cmake"));
+    return QString("-DROS_QTC_PRECOMPILED_HEADERS=ON -DCMAKE_PROJECT_INCLUDE=%1").arg(file.toString());
+}
+
+void ROSUtils::parseCompilerCacheStatistics(const QString &output, CompilerCacheStatistics &stats)
+{
+    stats = CompilerCacheStatistics();
+    QRegExp counter(QLatin1String("^(.*\\S)\\s+(\\d+)$"));
+    foreach (const QString &line, output.split(QLatin1Char('\n')))
+    {
+        if (counter.indexIn(line.trimmed()) == -1)
+            continue;
+
+        const QString name = counter.cap(1);
+        const qint64 value = counter.cap(2).toLongLong();
+        if (name == QLatin1String("direct_cache_hit") || name == QLatin1String("preprocessed_cache_hit") ||
+            name == QLatin1String("cache hit (direct)") || name == QLatin1String("cache hit (preprocessed)") ||
+            name == QLatin1String("Cache hits"))
+            stats.hits += value;
+        else if (name == QLatin1String("cache_miss") || name == QLatin1String("cache miss") ||
+                 name == QLatin1String("Cache misses"))
+            stats.misses += value;
+    }
+}
+
+QString ROSUtils::compilerCacheSummary(const ROSUtils::CompilerLauncher &compilerLauncher,
+                                       const CompilerCacheStatistics &before,
+                                       const CompilerCacheStatistics &after)
+{
+    // The statistics are global to the cache, so other builds sharing it are included
+    qint64 hits = qMax(Q_INT64_C(0), after.hits - before.hits);
+    qint64 misses = qMax(Q_INT64_C(0), after.misses - before.misses);
+    qint64 total = hits + misses;
+    double rate = (total > 0) ? (100.0 * hits) / total : 0.0;
+
+    return QString("Compiler cache (%1): %2 hits, %3 misses, %4% hit rate")
+            .arg(compilerLauncherName(compilerLauncher))
+            .arg(hits)
+            .arg(misses)
+            .arg(rate, 0, 'f', 1);
+}
+
 ROSUtils::WorkspaceInfo ROSUtils::getWorkspaceInfo(const Utils::FileName &workspaceDir,
                                                    const BuildSystem &buildSystem,
                                                    const QString &rosDistribution)
@@ -1022,6 +1826,42 @@ bool ROSUtils::findPackageBuildDirectory(const WorkspaceInfo &workspaceInfo, con
     return true;
 }
 
+bool ROSUtils::writeStopAtExecWrapper(const Utils::FileName &buildPath, Utils::FileName &wrapperPath)
+{
+    const QString content = QLatin1String(
+        "#!/bin/sh\n"
+        "# Generated by the ROS Qt Creator plugin, launch prefix used when debugging a node.\n"
+        "# A debug target stops itself here so the debugger attaches before it runs, it is\n"
+        "# executed once the debugger resumes the process. Only shell builtins are used before\n"
+        "# the exec, a forked helper would look like this script to the process watcher.\n"
+        "case \":$ROS_QTC_STOP_AT_EXEC_TARGET:\" in\n"
+        "  *\":$1:\"*) kill -STOP $$ ;;\n"
+        "esac\n"
+        "exec \"$@\"\n");
+
+    wrapperPath = Utils::FileName(buildPath).appendPath(QLatin1String("ros_qtc_stop_at_exec.sh"));
+
+    QFile file(wrapperPath.toString());
+    if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        bool unchanged = (QString::fromUtf8(file.readAll()) == content);
+        file.close();
+        if (unchanged && file.permissions().testFlag(QFileDevice::ExeOwner))
+            return true;
+    }
+
+    QDir().mkpath(buildPath.toString());
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qDebug() << "Failed to write stop at exec wrapper: " << file.fileName();
+        return false;
+    }
+
+    file.write(content.toUtf8());
+    file.close();
+    return file.setPermissions(file.permissions() | QFileDevice::ExeOwner | QFileDevice::ExeGroup | QFileDevice::ExeOther);
+}
+
 bool ROSUtils::PackageInfo::exists() const
 {
     return QDir(path.toString()).exists();
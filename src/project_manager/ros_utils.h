@@ -23,6 +23,9 @@
 
 #include <QProcess>
 #include <QProcessEnvironment>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
 #include <QXmlStreamWriter>
 #include <utils/fileutils.h>
 #include "ros_project_constants.h"
@@ -44,6 +47,18 @@ public:
         BuildTypeUserDefined = 4
     };
 
+    enum BuildGenerator {
+        CodeBlocksMakefiles = 0,
+        CodeBlocksNinja = 1,
+        Ninja = 2
+    };
+
+    enum CompilerLauncher {
+        NoCompilerLauncher = 0,
+        CCache = 1,
+        SCCache = 2
+    };
+
     enum TargetType {
         ExecutableType = 0,
         StaticLibraryType = 1,
@@ -57,6 +72,12 @@ public:
         QStringList directories; /**< @brief Directory Subdirectories */
     };
 
+    /** @brief Compiler cache hit and miss counters */
+    struct CompilerCacheStatistics {
+        qint64 hits = 0;   /**< @brief Number of cache hits */
+        qint64 misses = 0; /**< @brief Number of cache misses */
+    };
+
     /** @brief Contains relavent workspace information */
     struct WorkspaceInfo {
         Utils::FileName path;
@@ -77,6 +98,7 @@ public:
         QStringList includes;      /**< @brief Target's include directories */
         QStringList flags;         /**< @brief Target's cxx build flags */
         QStringList defines;       /**< @brief Target's defines build flags */
+        QStringList sources;       /**< @brief Target's source files (Only provided by the CMake file-api) */
     };
     typedef QList<PackageTargetInfo> PackageTargetInfoList;
 
@@ -119,6 +141,9 @@ public:
 
         Utils::FileName path;          /**< @brief Path to the Package's build directory */
         Utils::FileName cbpFile;       /**< @brief Path to the Package's CodeBlocks file */
+        Utils::FileName compileCommandsFile; /**< @brief Path to the Package's compilation database */
+        Utils::FileName fileApiReplyIndex;   /**< @brief Path to the CMake file-api reply index used */
+        QString fileApiReplyVersion;   /**< @brief Package's CMake file-api target reply files, used to detect changes */
         QStringList environment;       /**< @brief Build Environment */
         PackageTargetInfoList targets; /**< @brief List of packages target's */
         PackageInfo parent;            /**< @brief Package information */
@@ -147,6 +172,27 @@ public:
      */
     static QString buildTypeName(const ROSUtils::BuildType &buildType);
 
+    /**
+     * @brief Convert ENUM BuildGenerator to QString
+     * @param buildGenerator ENUM BuildGenerator
+     * @return QString for ENUM BuildGenerator (CMake generator name)
+     */
+    static QString buildGeneratorName(const ROSUtils::BuildGenerator &buildGenerator);
+
+    /**
+     * @brief Check if the generator uses Ninja as the build tool
+     * @param buildGenerator ENUM BuildGenerator
+     * @return True if Ninja based generator, otherwise false
+     */
+    static bool isNinjaGenerator(const ROSUtils::BuildGenerator &buildGenerator);
+
+    /**
+     * @brief Convert ENUM CompilerLauncher to QString
+     * @param compilerLauncher ENUM CompilerLauncher
+     * @return Compiler launcher executable name, empty if none
+     */
+    static QString compilerLauncherName(const ROSUtils::CompilerLauncher &compilerLauncher);
+
     /**
      * @brief Source ROS
      * @param process QProcess to execute the ROS bash command
@@ -247,15 +293,29 @@ public:
     static PackageInfoMap getWorkspacePackageInfo(const WorkspaceInfo &workspaceInfo,
                                                   const PackageInfoMap *cachedPackageInfo = NULL);
 
+    /**
+     * @brief Get the packages containing a set of files or directories
+     *
+     * Packages may be nested, so each path is mapped to the package with the longest matching path.
+     *
+     * @param packageInfo Workspace package information
+     * @param paths Files and directories
+     * @return Sorted list of package names
+     */
+    static QStringList getPackagesContainingPaths(const PackageInfoMap &packageInfo,
+                                                  const QStringList &paths);
+
     /**
      * @brief Get a packages build information
      * @param workspaceInfo Workspace information
      * @param packageInfo Package Information
+     * @param environment Workspace environment (See getWorkspaceEnvironment)
      * @param cachedPackageBuildInfo Cached Package build information if it fails
      * @return PackageBuildInfo
      */
     static PackageBuildInfoMap getWorkspacePackageBuildInfo(const WorkspaceInfo &workspaceInfo,
                                                             const PackageInfoMap &packageInfo,
+                                                            const QStringList &environment,
                                                             const PackageBuildInfoMap *cachedPackageBuildInfo = NULL);
 
     /**
@@ -282,12 +342,29 @@ public:
 
     /**
      * @brief Gets all of the executables associated to a package
+     *
+     * The executables are found in lib/<package> of the first CMAKE_PREFIX_PATH entry containing
+     * the package (devel, install or underlay space). The result is cached until clearExecutableIndex is called.
      * @param packageName ROS Package Name
      * @param env ROS Workspace Environment
-     * @return QStringList of executables
+     * @return QMap<Executable Name, Executable Path>
      */
     static QMap<QString, QString> getROSPackageExecutables(const QString &packageName, const QStringList &env);
 
+    /** @brief Clear the cached package executables, called when a build finished */
+    static void clearExecutableIndex();
+
+    /**
+     * @brief Get the nodes started by a launch file, including the launch files it includes
+     * @param launchFile Path to the launch file
+     * @param env ROS Workspace Environment
+     * @param arguments roslaunch arguments (name:=value)
+     * @return QMap<Node name, Executable path> of the nodes found in the workspace, nodes of the same type share an executable.
+     * Nodes under a condition which can not be evaluated ($(eval)) are left out.
+     */
+    static QMap<QString, QString> getLaunchFileNodes(const QString &launchFile, const QStringList &env,
+                                                     const QString &arguments = QString());
+
     /**
      * @brief Remove catkin tools profile
      * @param workspaceDir Workspace directory path
@@ -367,6 +444,29 @@ public:
     static Utils::FileName getCatkinToolsProfile(const Utils::FileName &workspaceDir,
                                                  const QString &profileName);
 
+    /**
+     * @brief Get the packages excluded from unity builds for a catkin tools profile
+     * @param workspaceDir Workspace directory path
+     * @param profileName Profile name
+     * @return Package names
+     */
+    static QStringList getCatkinToolsUnityBuildExclude(const Utils::FileName &workspaceDir,
+                                                       const QString &profileName);
+
+    /**
+     * @brief Set the packages excluded from unity builds for a catkin tools profile
+     *
+     * The list is stored next to the profile's config.yaml.
+     *
+     * @param workspaceDir Workspace directory path
+     * @param profileName Profile name
+     * @param packages Package names
+     * @return True if successful, otherwise false
+     */
+    static bool setCatkinToolsUnityBuildExclude(const Utils::FileName &workspaceDir,
+                                                const QString &profileName,
+                                                const QStringList &packages);
+
     /**
      * @brief Get cmake build type argument
      * @param buildType Build type (Debug, Release, RelWithDebInfo, MinSizeRel)
@@ -374,6 +474,108 @@ public:
      */
     static QString getCMakeBuildTypeArgument(ROSUtils::BuildType &buildType);
 
+    /**
+     * @brief Get cmake generator arguments
+     *
+     * Ninja based generators do not create flags.make files so the compilation
+     * database is also requested, which is used to extract the build information.
+     *
+     * @param buildGenerator Build generator (CodeBlocks - Unix Makefiles, CodeBlocks - Ninja, Ninja)
+     * @param includeGenerator False if the build tool selects the generator itself (ex. catkin_make --use-ninja)
+     * @return CMake generator arguments
+     */
+    static QString getCMakeGeneratorArguments(const ROSUtils::BuildGenerator &buildGenerator, bool includeGenerator = true);
+
+    /**
+     * @brief Get cmake compiler launcher arguments
+     * @param compilerLauncher Compiler launcher (ccache, sccache)
+     * @return CMake C and CXX compiler launcher arguments, empty if no launcher is used
+     */
+    static QString getCMakeCompilerLauncherArguments(const ROSUtils::CompilerLauncher &compilerLauncher);
+
+    /**
+     * @brief Get cmake unity build arguments
+     *
+     * Excluded packages include a generated file at the end of their project() call which
+     * turns unity builds off for all targets of the package. The per package include variables
+     * are removed from the cache first, so a package no longer excluded is unity built again.
+     *
+     * @param buildPath Workspace build directory, where the exclude file is written
+     * @param batchSize Number of sources combined into one unity source, 0 combines all sources
+     * @param excludedPackages Packages which are not unity built
+     * @return CMake unity build arguments
+     */
+    static QString getCMakeUnityBuildArguments(const Utils::FileName &buildPath,
+                                               int batchSize,
+                                               const QStringList &excludedPackages);
+
+    /**
+     * @brief Write the cmake file which disables unity builds for the package including it
+     * @param buildPath Workspace build directory
+     * @return True if successful, otherwise false
+     */
+    static bool writeUnityBuildExcludeFile(const Utils::FileName &buildPath);
+
+    /**
+     * @brief Choose the headers to precompile for each target from the include statistics of its sources
+     *
+     * Only angle bracket includes from outside the package (ex. <ros/ros.h>, <Eigen/Core>) which are
+     * included by at least half of the target's sources are chosen, most frequent first.
+     *
+     * @param buildInfo Workspace package build information, target sources are provided by the CMake file-api
+     * @param maxHeaders Maximum number of headers per target
+     * @return Target name to headers (ex. <ros/ros.h>)
+     */
+    static QMap<QString, QStringList> getPrecompiledHeaderCandidates(const PackageBuildInfoMap &buildInfo,
+                                                                     int maxHeaders = 8);
+
+    /**
+     * @brief Write the cmake file which adds the precompiled headers to the targets of each package
+     *
+     * The file is included after every project() call and defers target_precompile_headers until
+     * the package's targets are defined (requires CMake 3.19). It is only rewritten if the headers
+     * changed so an unchanged selection does not trigger a reconfigure.
+     *
+     * @param buildPath Workspace build directory
+     * @param targetHeaders Target name to headers
+     * @return True if successful, otherwise false
+     */
+    static bool writePrecompiledHeaderFile(const Utils::FileName &buildPath,
+                                           const QMap<QString, QStringList> &targetHeaders);
+
+    /**
+     * @brief Get cmake precompiled header arguments
+     * @param buildPath Workspace build directory, where the precompiled header file is written
+     * @param enabled If false the previously configured precompiled headers are disabled
+     * @return CMake precompiled header arguments
+     */
+    static QString getCMakePrecompiledHeaderArguments(const Utils::FileName &buildPath, bool enabled);
+
+    /**
+     * @brief Parse the compiler cache statistics printed by the compiler launcher
+     * @param output Output of ccache --print-stats, ccache -s or sccache --show-stats
+     * @param stats Compiler cache statistics
+     */
+    static void parseCompilerCacheStatistics(const QString &output, CompilerCacheStatistics &stats);
+
+    /**
+     * @brief Get a summary of the compiler cache usage of a build
+     * @param compilerLauncher Compiler launcher (ccache, sccache)
+     * @param before Statistics before the build
+     * @param after Statistics after the build
+     * @return Summary of the hits and misses during the build
+     */
+    static QString compilerCacheSummary(const ROSUtils::CompilerLauncher &compilerLauncher,
+                                        const CompilerCacheStatistics &before,
+                                        const CompilerCacheStatistics &after);
+
+    /**
+     * @brief Write the CMake file-api codemodel query so the next cmake configure generates a reply
+     * @param buildPath Directory where cmake is configured
+     * @return True if successful, otherwise false.
+     */
+    static bool writeCMakeFileApiQuery(const Utils::FileName &buildPath);
+
     /**
      * @brief Get workspace environment
      * @param workspaceInfo Workspace information
@@ -382,6 +584,30 @@ public:
      */
     static QProcessEnvironment getWorkspaceEnvironment(const WorkspaceInfo &workspaceInfo);
 
+    /**
+     * @brief Find a given packages build directory
+     * @param workspaceInfo Workspace information
+     * @param packageInfo Package Information
+     * @return Packages build directory
+     */
+    static bool findPackageBuildDirectory(const WorkspaceInfo &workspaceInfo,
+                                          const PackageInfo &packageInfo,
+                                          Utils::FileName &packageBuildPath);
+
+    /**
+     * @brief Write the launch prefix script which stops a node before it runs so a debugger can attach
+     *
+     * The script stops itself if its first argument is one of the paths in ROS_QTC_STOP_AT_EXEC_TARGET
+     * (colon separated, the caller lists every spelling of a target since the script resolves nothing),
+     * then it executes its arguments. Nodes in launch files use it through
+     * launch-prefix="$(optenv ROS_QTC_LAUNCH_PREFIX)".
+     *
+     * @param buildPath Workspace build directory
+     * @param wrapperPath Path to the written script
+     * @return True if successful, otherwise false.
+     */
+    static bool writeStopAtExecWrapper(const Utils::FileName &buildPath, Utils::FileName &wrapperPath);
+
 private:
     /**
      * @brief sourceWorkspaceHelper - Source workspace helper function
@@ -401,6 +627,74 @@ private:
     static bool parseCodeBlocksFile(const WorkspaceInfo &workspaceInfo,
                                     PackageBuildInfo &package);
 
+    /**
+     * @brief This will parse the compilation database (compile_commands.json) and get the build info.
+     *
+     * If the package targets were already populated from the CodeBlocks file only the
+     * targets missing a flags.make file (Ninja generators) are updated, otherwise the
+     * targets are created from the compile commands.
+     *
+     * @param workspaceInfo Workspace information
+     * @param package Package Info Objects
+     * @param database Parsed compile_commands.json content
+     * @return True if successful, otherwise false.
+     */
+    static bool parseCompileCommands(const WorkspaceInfo &workspaceInfo,
+                                     PackageBuildInfo &package,
+                                     const QJsonArray &database);
+
+    /**
+     * @brief Find the latest CMake file-api reply index for a build directory
+     * @param buildPath Directory where cmake is configured
+     * @param indexFile Path to the reply index file
+     * @return True if found, otherwise false.
+     */
+    static bool findCMakeFileApiReplyIndex(const Utils::FileName &buildPath, Utils::FileName &indexFile);
+
+    /**
+     * @brief Read the codemodel-v2 object referenced by a CMake file-api reply index
+     * @param indexFile Path to the reply index file
+     * @param codemodel Parsed codemodel object
+     * @return True if successful, otherwise false.
+     */
+    static bool readCMakeFileApiCodemodel(const Utils::FileName &indexFile, QJsonObject &codemodel);
+
+    /**
+     * @brief This will parse the CMake file-api codemodel reply and get the build info (targets, sources, includes, etc.)
+     *
+     * The reply file names of the package's targets contain a hash of their content, so if they
+     * match the cached build information the targets are reused without being reparsed.
+     *
+     * @param workspaceInfo Workspace information
+     * @param buildInfo Package build information
+     * @param codemodel Parsed codemodel object
+     * @param cachedBuildInfo Previous package build information (Optional)
+     * @return True if successful, otherwise false.
+     */
+    static bool parseCMakeFileApiReply(const WorkspaceInfo &workspaceInfo,
+                                       PackageBuildInfo &buildInfo,
+                                       const QJsonObject &codemodel,
+                                       const PackageBuildInfo *cachedBuildInfo = nullptr);
+
+    /**
+     * @brief Read a json file
+     * @param filePath Path to the json file
+     * @param doc Parsed json document
+     * @return True if successful, otherwise false.
+     */
+    static bool readJsonFile(const QString &filePath, QJsonDocument &doc);
+
+    /**
+     * @brief Find the compilation database for a given package
+     * @param workspaceInfo Workspace information
+     * @param buildInfo Package build information
+     * @param compileCommandsFile Path to the compile_commands.json file
+     * @return True if found, otherwise false.
+     */
+    static bool findPackageCompileCommandsFile(const WorkspaceInfo &workspaceInfo,
+                                               const PackageBuildInfo &buildInfo,
+                                               Utils::FileName &compileCommandsFile);
+
     /**
      * @brief Get path to the profiles directory
      * @param workspaceDir Workspace directory path
@@ -444,16 +738,6 @@ private:
      */
     static Utils::FileName getCatkinToolsProfileConfigFile(const Utils::FileName &workspaceDir,
                                                            const QString &profileName);
-
-    /**
-     * @brief Find a given packages build directory
-     * @param workspaceInfo Workspace information
-     * @param packageInfo Package Information
-     * @return Packages build directory
-     */
-    static bool findPackageBuildDirectory(const WorkspaceInfo &workspaceInfo,
-                                          const PackageInfo &packageInfo,
-                                          Utils::FileName &packageBuildPath);
 };
 } // namespace Internal
 } // namespace ROSProjectManager
@@ -23,10 +23,12 @@
 #include "ros_project.h"
 
 #include <projectexplorer/projecttree.h>
+#include <coreplugin/documentmanager.h>
 #include <coreplugin/vcsmanager.h>
 #include <coreplugin/iversioncontrol.h>
 
 #include <QDebug>
+#include <QFileInfo>
 
 namespace ROSProjectManager {
 namespace Internal {
@@ -36,6 +38,10 @@ ROSWorkspaceWatcher::ROSWorkspaceWatcher(ROSProject *parent)
 {
   connect(&m_watcher, SIGNAL(directoryChanged(QString)),
           this, SLOT(onFolderChanged(QString)));
+
+  // Saving a file only triggers a directory change if it is saved atomically
+  connect(Core::DocumentManager::instance(), &Core::DocumentManager::filesChangedInternally,
+          this, &ROSWorkspaceWatcher::onFilesChangedInternally);
 }
 
 void ROSWorkspaceWatcher::watchFolder(const QString &parentPath, const QString &dirName)
@@ -141,6 +147,9 @@ void ROSWorkspaceWatcher::onFolderChanged(const QString &path)
     }
   }
 
+  // Record the change so the affected packages can be determined
+  m_changedPaths.insert(path);
+
   // Compare the latest contents to saved contents for the dir updated to find out the difference(change)
   const QDir dir(path);
   QStringList curFiles = m_workspaceContent[path].files;
@@ -231,11 +240,31 @@ void ROSWorkspaceWatcher::onFolderChanged(const QString &path)
   }
 }
 
+void ROSWorkspaceWatcher::onFilesChangedInternally(const QStringList &files)
+{
+  foreach (const QString &file, files)
+  {
+    if (m_workspaceContent.contains(QFileInfo(file).absolutePath()))
+      m_changedPaths.insert(file);
+  }
+}
+
 QStringList ROSWorkspaceWatcher::getWorkspaceFiles()
 {
   return m_workspaceFiles;
 }
 
+QStringList ROSWorkspaceWatcher::getChangedPaths() const
+{
+  return m_changedPaths.toList();
+}
+
+void ROSWorkspaceWatcher::removeChangedPaths(const QStringList &paths)
+{
+  foreach (const QString &path, paths)
+    m_changedPaths.remove(path);
+}
+
 void ROSWorkspaceWatcher::print()
 {
   QHashIterator<QString, ROSUtils::FolderContent> item(m_workspaceContent);
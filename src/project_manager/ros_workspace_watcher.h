@@ -43,8 +43,12 @@ public:
   QStringList getWorkspaceFiles();
   void print();
 
+  QStringList getChangedPaths() const;
+  void removeChangedPaths(const QStringList &paths);
+
 public slots:
   void onFolderChanged(const QString &path);
+  void onFilesChangedInternally(const QStringList &files);
 
 signals:
   void fileListChanged();
@@ -56,6 +60,7 @@ private:
   QFileSystemWatcher m_watcher;
   QHash<QString, ROSUtils::FolderContent> m_workspaceContent;
   QStringList m_workspaceFiles;
+  QSet<QString> m_changedPaths; /**< @brief Files and directories changed since the last successful build */
 };
 
 }